@@ -1,17 +1,116 @@
 #include "active_item_cache.h"
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
+#include "calendar.h"
 #include "item.h"
 #include "safe_reference.h"
 
+static int current_turn()
+{
+    return to_turn<int>( calendar::turn );
+}
+
+active_item_cache::active_item_cache( const active_item_cache &other )
+{
+    *this = other;
+}
+
+active_item_cache &active_item_cache::operator=( const active_item_cache &other )
+{
+    if( this == &other ) {
+        return *this;
+    }
+    wheel = other.wheel;
+    last_processed = other.last_processed;
+    next_offset = other.next_offset;
+    special_items = other.special_items;
+    // The index has to point into the copied lists.
+    index.clear();
+    for( slot &entries : wheel ) {
+        for( auto entry = entries.begin(); entry != entries.end(); ++entry ) {
+            index[entry->target] = entry;
+        }
+    }
+    return *this;
+}
+
+// The turn can be negative, the clock can be set back with the debug menu.
+static int floor_div( const int value, const int divisor )
+{
+    return ( value - ( value % divisor + divisor ) % divisor ) / divisor;
+}
+
+static int positive_modulo( const int value, const int divisor )
+{
+    return ( value % divisor + divisor ) % divisor;
+}
+
+void active_item_cache::schedule( slot &from, const slot::iterator entry )
+{
+    const int next_turn = last_processed + 1;
+    entry->due = std::max( entry->due, next_turn );
+    const int span = floor_div( entry->due, wheel_size );
+    const int next_span = floor_div( next_turn, wheel_size );
+    int target = far_slot;
+    if( span == next_span ) {
+        target = positive_modulo( entry->due, wheel_size );
+    } else if( span - next_span < wheel_size ) {
+        target = span_slots + positive_modulo( span, wheel_size );
+    }
+    if( target != entry->slot_index ) {
+        entry->slot_index = target;
+        wheel[target].splice( wheel[target].end(), from, entry );
+    }
+}
+
+void active_item_cache::start_span()
+{
+    const int span = floor_div( last_processed + 1, wheel_size );
+    slot &entries = wheel[span_slots + positive_modulo( span, wheel_size )];
+    while( !entries.empty() ) {
+        schedule( entries, entries.begin() );
+    }
+    slot &far_entries = wheel[far_slot];
+    for( auto entry = far_entries.begin(); entry != far_entries.end(); ) {
+        const auto next = std::next( entry );
+        schedule( far_entries, entry );
+        entry = next;
+    }
+}
+
+void active_item_cache::reschedule_all( const int next_turn )
+{
+    last_processed = next_turn - 1;
+    slot all_entries;
+    for( slot &entries : wheel ) {
+        for( scheduled_item &entry : entries ) {
+            entry.slot_index = -1;
+        }
+        all_entries.splice( all_entries.end(), entries );
+    }
+    while( !all_entries.empty() ) {
+        schedule( all_entries, all_entries.begin() );
+    }
+}
+
+void active_item_cache::erase( const slot::iterator entry )
+{
+    const auto iter = index.find( entry->target );
+    if( iter != index.end() && iter->second == entry ) {
+        index.erase( iter );
+    }
+    wheel[entry->slot_index].erase( entry );
+}
+
 void active_item_cache::remove( const item *it )
 {
-    active_items[it->processing_speed()].remove_if( [it]( const item_reference & active_item ) {
-        item *const target = active_item.item_ref.get();
-        return !target || target == it;
-    } );
+    const auto iter = index.find( it );
+    if( iter != index.end() ) {
+        erase( iter->second );
+    }
     if( it->can_revive() ) {
         special_items[ special_item_type::corpse ].remove_if( [it]( const item_reference & active_item ) {
             item *const target = active_item.item_ref.get();
@@ -29,13 +128,14 @@ void active_item_cache::remove( const item *it )
 
 void active_item_cache::add( item &it, point location )
 {
-    // If the item is alread in the cache for some reason, don't add a second reference
-    std::list<item_reference> &target_list = active_items[it.processing_speed()];
-    if( std::find_if( target_list.begin(),
-    target_list.end(), [&it]( const item_reference & active_item_ref ) {
-    return &it == active_item_ref.item_ref.get();
-    } ) != target_list.end() ) {
-        return;
+    const auto existing = index.find( &it );
+    if( existing != index.end() ) {
+        // If the item is alread in the cache for some reason, don't add a second reference
+        if( existing->second->ref.item_ref.get() == &it ) {
+            return;
+        }
+        // A destroyed item that had the same address.
+        erase( existing->second );
     }
     if( it.can_revive() ) {
         special_items[ special_item_type::corpse ].push_back( item_reference{ location, it.get_safe_reference() } );
@@ -43,30 +143,39 @@ void active_item_cache::add( item &it, point location )
     if( it.get_use( "explosion" ) ) {
         special_items[ special_item_type::explosive ].push_back( item_reference{ location, it.get_safe_reference() } );
     }
-    target_list.push_back( item_reference{ location, it.get_safe_reference() } );
+
+    const int now = current_turn();
+    if( wheel.empty() ) {
+        wheel.resize( far_slot + 1 );
+        last_processed = now - 1;
+    }
+    const int speed = std::max( it.processing_speed(), 1 );
+    // Slow items are spread over their interval, instead of all being processed in the
+    // same turn. Nothing is due before the next turn that is going to be processed.
+    slot added;
+    added.push_back( scheduled_item{ item_reference{ location, it.get_safe_reference() }, &it, speed, now + next_offset++ % speed, -1 } );
+    const slot::iterator entry = added.begin();
+    schedule( added, entry );
+    index[&it] = entry;
 }
 
 bool active_item_cache::empty() const
 {
-    for( std::pair<int, std::list<item_reference>> active_queue : active_items ) {
-        if( !active_queue.second.empty() ) {
-            return false;
-        }
-    }
-    return true;
+    return index.empty();
 }
 
 std::vector<item_reference> active_item_cache::get()
 {
     std::vector<item_reference> all_cached_items;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        for( std::list<item_reference>::iterator it = kv.second.begin(); it != kv.second.end(); ) {
-            if( it->item_ref ) {
-                all_cached_items.emplace_back( *it );
-                ++it;
+    for( slot &entries : wheel ) {
+        for( auto entry = entries.begin(); entry != entries.end(); ) {
+            const auto next = std::next( entry );
+            if( entry->ref.item_ref ) {
+                all_cached_items.emplace_back( entry->ref );
             } else {
-                it = kv.second.erase( it );
+                erase( entry );
             }
+            entry = next;
         }
     }
     return all_cached_items;
@@ -75,23 +184,41 @@ std::vector<item_reference> active_item_cache::get()
 std::vector<item_reference> active_item_cache::get_for_processing()
 {
     std::vector<item_reference> items_to_process;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = kv.second.size() / kv.first;
-        std::list<item_reference>::iterator it = kv.second.begin();
-        for( ; it != kv.second.end() && num_to_process >= 0; ) {
-            if( it->item_ref ) {
-                items_to_process.push_back( *it );
-                --num_to_process;
-                ++it;
-            } else {
+    if( wheel.empty() ) {
+        return items_to_process;
+    }
+    const int now = current_turn();
+    if( now < last_processed ) {
+        // The clock has been set back, everything is due now.
+        for( slot &entries : wheel ) {
+            for( scheduled_item &entry : entries ) {
+                entry.due = now;
+            }
+        }
+        reschedule_all( now );
+    } else if( now - last_processed > wheel_size ) {
+        // Catching up turn by turn would visit the slots more than once.
+        reschedule_all( now );
+    }
+    // Turns that were skipped are caught up on, each item is returned at most once.
+    for( int turn = last_processed + 1; turn <= now; turn++ ) {
+        slot &entries = wheel[positive_modulo( turn, wheel_size )];
+        for( auto entry = entries.begin(); entry != entries.end(); ) {
+            const auto next = std::next( entry );
+            if( !entry->ref.item_ref ) {
                 // The item has been destroyed, so remove the reference from the cache
-                it = kv.second.erase( it );
+                erase( entry );
+            } else {
+                items_to_process.push_back( entry->ref );
+                entry->due = now + entry->speed;
+                schedule( entries, entry );
             }
+            entry = next;
+        }
+        last_processed = turn;
+        if( positive_modulo( turn + 1, wheel_size ) == 0 ) {
+            start_span();
         }
-        // Rotate the returned items to the end of their list so that the items that weren't
-        // returned this time will be first in line on the next call
-        kv.second.splice( kv.second.end(), kv.second, kv.second.begin(), it );
     }
     return items_to_process;
 }
@@ -107,18 +234,18 @@ std::vector<item_reference> active_item_cache::get_special( special_item_type ty
 
 void active_item_cache::subtract_locations( const point &delta )
 {
-    for( auto &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
-            ir.location -= delta;
+    for( slot &entries : wheel ) {
+        for( scheduled_item &entry : entries ) {
+            entry.ref.location -= delta;
         }
     }
 }
 
 void active_item_cache::rotate_locations( int turns, const point &dim )
 {
-    for( auto &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
-            ir.location = ir.location.rotate( turns, dim );
+    for( slot &entries : wheel ) {
+        for( scheduled_item &entry : entries ) {
+            entry.ref.location = entry.ref.location.rotate( turns, dim );
         }
     }
 }
@@ -34,17 +34,65 @@ struct hash<special_item_type> {
 };
 } // namespace std
 
+/**
+ * The active items are kept in a hierarchical timing wheel. The first level has one slot per
+ * turn of the current span of wheel_size turns, the second level one slot per span for the
+ * following spans. Processing a turn only looks at the first level slot of that turn, and
+ * whenever a new span starts, its second level slot is spread over the first level. So an
+ * item that is processed every N turns is only touched twice per period: when it's processed
+ * and when its span starts. Items due even later wait in a separate list, which is only
+ * checked when a span starts.
+ */
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::list<item_reference>> active_items;
+        static constexpr int wheel_size = 64;
+        // The second level of the wheel starts at this index, the list of far items follows it.
+        static constexpr int span_slots = wheel_size;
+        static constexpr int far_slot = 2 * wheel_size;
+
+        struct scheduled_item {
+            item_reference ref;
+            // The item when it was added, identifies the entry in the index even after the
+            // item is gone.
+            const item *target;
+            int speed;
+            int due;
+            // The slot the entry is in.
+            int slot_index;
+        };
+        using slot = std::list<scheduled_item>;
+
+        // Empty until the first item is added, most caches never get any.
+        std::vector<slot> wheel;
+        // Where each item is, entries move between slots by splicing, so these stay valid.
+        std::unordered_map<const item *, slot::iterator> index;
+        // The turns up to this one have been processed (or had nothing to process). The
+        // wheel is arranged for the turn after it.
+        int last_processed = 0;
+        // Spreads the first processing of slow items over their interval.
+        int next_offset = 0;
+
+        /** Moves the entry from the given slot into the slot of its due turn. */
+        void schedule( slot &from, slot::iterator entry );
+        /** Moves the items of the span that starts with the next turn into the first level. */
+        void start_span();
+        /** Arranges all items for the given next turn, overdue ones are due at that turn. */
+        void reschedule_all( int next_turn );
+        void erase( slot::iterator entry );
+
         std::unordered_map<special_item_type, std::list<item_reference>> special_items;
 
     public:
+        active_item_cache() = default;
+        active_item_cache( const active_item_cache &other );
+        active_item_cache( active_item_cache && ) = default;
+        active_item_cache &operator=( const active_item_cache &other );
+        active_item_cache &operator=( active_item_cache && ) = default;
+
         /**
          * Removes the item if it is in the cache. Does nothing if the item is not in the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
-         * Also removes any items that have been destroyed in the list containing it
+         * Also removes any items that have been destroyed from the special item lists it's in.
          */
         void remove( const item *it );
 
@@ -66,12 +114,10 @@ class active_item_cache
         std::vector<item_reference> get();
 
         /**
-         * Returns the first size() / processing_speed() elements of each list, rounded up.
-         * Items returned are rotated to the back of their respective lists, otherwise only the
-         * first n items will ever be processed.
+         * Returns the items that are due at the current turn (or at skipped turns since the
+         * last call) and schedules them again item::processing_speed() turns later.
          * Broken references encountered when collecting the items to be processed are removed from
          * the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
          */
         std::vector<item_reference> get_for_processing();
 
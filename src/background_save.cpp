@@ -0,0 +1,192 @@
+#include "background_save.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#if defined(_WIN32)
+#   include <io.h>
+#   if !defined(_MSC_VER)
+#       include "mingw.thread.h"
+#   endif
+#else
+#   include <unistd.h>
+#endif
+
+#include "filesystem.h"
+
+/** Writes the file the same way @ref ofstream_wrapper does, but syncs it before renaming. */
+static std::string write_file_synced( const std::string &path, const std::string &contents )
+{
+    const std::string temp_path = path + ".background.temp";
+    std::FILE *const file = std::fopen( temp_path.c_str(), "wb" );
+    if( file == nullptr ) {
+        return "opening file \"" + temp_path + "\" failed";
+    }
+    bool ok = std::fwrite( contents.data(), 1, contents.size(), file ) == contents.size();
+    ok = std::fflush( file ) == 0 && ok;
+#if defined(_WIN32)
+    ok = _commit( _fileno( file ) ) == 0 && ok;
+#else
+    ok = fsync( fileno( file ) ) == 0 && ok;
+#endif
+    ok = std::fclose( file ) == 0 && ok;
+    if( !ok ) {
+        // Remove the incomplete file, the previous version at path is still intact.
+        remove_file( temp_path );
+        return "writing to file \"" + temp_path + "\" failed";
+    }
+    if( !rename_file( temp_path, path ) ) {
+        // Leave the temp path, so the user can move it if possible.
+        return "moving temporary file \"" + temp_path + "\" failed";
+    }
+    return std::string();
+}
+
+class background_writer
+{
+    public:
+        ~background_writer() {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            job_added.notify_all();
+            // The worker finishes the queue before it exits.
+            if( worker.joinable() ) {
+                worker.join();
+            }
+        }
+
+        void enqueue( const std::string &path, std::string &&contents ) {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                jobs.emplace_back( path, std::move( contents ) );
+                pending[path]++;
+                if( !worker.joinable() ) {
+                    worker = std::thread( &background_writer::run, this );
+                }
+            }
+            job_added.notify_all();
+        }
+
+        void wait_for( const std::string &path ) {
+            std::unique_lock<std::mutex> lock( mutex );
+            job_done.wait( lock, [&]() {
+                return pending.count( path ) == 0;
+            } );
+        }
+
+        void wait_for_all() {
+            std::unique_lock<std::mutex> lock( mutex );
+            job_done.wait( lock, [&]() {
+                return pending.empty();
+            } );
+        }
+
+        bool busy() {
+            std::lock_guard<std::mutex> lock( mutex );
+            return !pending.empty();
+        }
+
+        std::vector<std::string> take_errors() {
+            std::lock_guard<std::mutex> lock( mutex );
+            std::vector<std::string> result;
+            result.swap( errors );
+            return result;
+        }
+
+    private:
+        void run() {
+            std::unique_lock<std::mutex> lock( mutex );
+            while( true ) {
+                job_added.wait( lock, [&]() {
+                    return stopping || !jobs.empty();
+                } );
+                if( jobs.empty() ) {
+                    return;
+                }
+                const std::pair<std::string, std::string> job = std::move( jobs.front() );
+                jobs.pop_front();
+
+                lock.unlock();
+                const std::string error = write_file_synced( job.first, job.second );
+                lock.lock();
+
+                if( !error.empty() ) {
+                    errors.push_back( error );
+                }
+                if( --pending[job.first] == 0 ) {
+                    pending.erase( job.first );
+                }
+                job_done.notify_all();
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable job_added;
+        std::condition_variable job_done;
+        std::deque<std::pair<std::string, std::string>> jobs;
+        // Number of queued or in progress writes for each path.
+        std::map<std::string, int> pending;
+        std::vector<std::string> errors;
+        bool stopping = false;
+        std::thread worker;
+};
+
+static background_writer &get_writer()
+{
+    static background_writer writer;
+    return writer;
+}
+
+static bool deferring = false;
+
+namespace background_save
+{
+
+deferred_writes::deferred_writes()
+{
+    deferring = true;
+}
+
+deferred_writes::~deferred_writes()
+{
+    deferring = false;
+}
+
+bool is_deferring()
+{
+    return deferring;
+}
+
+void enqueue( const std::string &path, std::string &&contents )
+{
+    get_writer().enqueue( path, std::move( contents ) );
+}
+
+void wait_for( const std::string &path )
+{
+    get_writer().wait_for( path );
+}
+
+void wait_for_all()
+{
+    get_writer().wait_for_all();
+}
+
+bool busy()
+{
+    return get_writer().busy();
+}
+
+std::vector<std::string> take_errors()
+{
+    return get_writer().take_errors();
+}
+
+} // namespace background_save
@@ -0,0 +1,47 @@
+#pragma once
+#ifndef CATA_SRC_BACKGROUND_SAVE_H
+#define CATA_SRC_BACKGROUND_SAVE_H
+
+#include <string>
+#include <vector>
+
+/**
+ * Support for saving without blocking the game on disk I/O.
+ *
+ * While a @ref deferred_writes object exists, @ref write_to_file does not touch the disk:
+ * the data is serialized into memory (a snapshot of the game state at that moment) and
+ * handed to a worker thread, which writes it to a temporary file, syncs it to disk and
+ * atomically renames it to the final path.
+ *
+ * Reading or synchronously writing a file that still has a pending background write
+ * waits for the worker first, so callers always see the latest data.
+ */
+namespace background_save
+{
+
+/** Scope guard that enables deferred writes on the main thread. Not reentrant. */
+class deferred_writes
+{
+    public:
+        deferred_writes();
+        ~deferred_writes();
+
+        deferred_writes( const deferred_writes & ) = delete;
+        deferred_writes &operator=( const deferred_writes & ) = delete;
+};
+
+bool is_deferring();
+/** Queues @p contents to be written to @p path by the worker thread. */
+void enqueue( const std::string &path, std::string &&contents );
+/** Blocks until no write to @p path is pending. */
+void wait_for( const std::string &path );
+/** Blocks until all queued writes are done. */
+void wait_for_all();
+/** Whether the worker still has writes queued or in progress. */
+bool busy();
+/** Returns (and forgets) the errors of failed background writes. */
+std::vector<std::string> take_errors();
+
+} // namespace background_save
+
+#endif // CATA_SRC_BACKGROUND_SAVE_H
@@ -0,0 +1,162 @@
+#include "binary_io.h"
+
+#include <cstring>
+#include <vector>
+
+void binary_out::write_uint( uint64_t value )
+{
+    while( value >= 0x80 ) {
+        buffer.push_back( static_cast<char>( ( value & 0x7f ) | 0x80 ) );
+        value >>= 7;
+    }
+    buffer.push_back( static_cast<char>( value ) );
+}
+
+void binary_out::write_int( const int64_t value )
+{
+    // Zigzag encoding: 0, -1, 1, -2, 2 ... map to 0, 1, 2, 3, 4 ...
+    write_uint( ( static_cast<uint64_t>( value ) << 1 ) ^ static_cast<uint64_t>( value >> 63 ) );
+}
+
+void binary_out::write_string( const std::string &value )
+{
+    write_uint( value.size() );
+    buffer.append( value );
+}
+
+void binary_out::write_bytes( const char *const data, const size_t size )
+{
+    buffer.append( data, size );
+}
+
+uint64_t binary_in::read_uint()
+{
+    uint64_t result = 0;
+    for( int shift = 0; shift < 64; shift += 7 ) {
+        if( pos >= data.size() ) {
+            throw binary_error( "unexpected end of binary data" );
+        }
+        const unsigned char byte = static_cast<unsigned char>( data[pos++] );
+        result |= static_cast<uint64_t>( byte & 0x7f ) << shift;
+        if( !( byte & 0x80 ) ) {
+            return result;
+        }
+    }
+    throw binary_error( "malformed integer in binary data" );
+}
+
+int64_t binary_in::read_int()
+{
+    const uint64_t value = read_uint();
+    return static_cast<int64_t>( value >> 1 ) ^ -static_cast<int64_t>( value & 1 );
+}
+
+size_t binary_in::read_index( const size_t limit )
+{
+    const uint64_t value = read_uint();
+    if( value >= limit ) {
+        throw binary_error( "index out of range in binary data" );
+    }
+    return static_cast<size_t>( value );
+}
+
+std::string binary_in::read_string()
+{
+    const uint64_t size = read_uint();
+    if( size > data.size() - pos ) {
+        throw binary_error( "unexpected end of binary data" );
+    }
+    std::string result = data.substr( pos, size );
+    pos += size;
+    return result;
+}
+
+void binary_in::read_bytes( std::string &dest, const size_t size )
+{
+    if( size > data.size() - pos ) {
+        throw binary_error( "unexpected end of binary data" );
+    }
+    dest.append( data, pos, size );
+    pos += size;
+}
+
+static constexpr size_t lz_min_match = 4;
+static constexpr size_t lz_max_offset = 65535;
+static constexpr int lz_hash_bits = 14;
+
+static uint32_t lz_hash( const char *const p )
+{
+    uint32_t v;
+    std::memcpy( &v, p, sizeof( v ) );
+    return ( v * 2654435761U ) >> ( 32 - lz_hash_bits );
+}
+
+std::string lz_compress( const std::string &input )
+{
+    binary_out out;
+    const size_t size = input.size();
+    const char *const data = input.data();
+    // Most recent position of each 4 byte sequence (by hash), only the latest one is tried.
+    std::vector<size_t> last_pos( 1 << lz_hash_bits, SIZE_MAX );
+
+    size_t literal_start = 0;
+    size_t pos = 0;
+    while( pos + lz_min_match <= size ) {
+        const uint32_t hash = lz_hash( data + pos );
+        const size_t candidate = last_pos[hash];
+        last_pos[hash] = pos;
+        if( candidate == SIZE_MAX || pos - candidate > lz_max_offset ||
+            std::memcmp( data + candidate, data + pos, lz_min_match ) != 0 ) {
+            pos++;
+            continue;
+        }
+        size_t length = lz_min_match;
+        while( pos + length < size && data[candidate + length] == data[pos + length] ) {
+            length++;
+        }
+        out.write_uint( pos - literal_start );
+        out.write_bytes( data + literal_start, pos - literal_start );
+        out.write_uint( length - lz_min_match );
+        out.write_uint( pos - candidate );
+        const size_t match_end = pos + length;
+        for( pos++; pos < match_end && pos + lz_min_match <= size; pos++ ) {
+            last_pos[lz_hash( data + pos )] = pos;
+        }
+        pos = match_end;
+        literal_start = pos;
+    }
+    out.write_uint( size - literal_start );
+    out.write_bytes( data + literal_start, size - literal_start );
+    return out.data();
+}
+
+std::string lz_decompress( const std::string &input, const size_t uncompressed_size )
+{
+    std::string result;
+    result.reserve( uncompressed_size );
+    binary_in in( input );
+    while( result.size() < uncompressed_size ) {
+        const uint64_t literals = in.read_uint();
+        if( literals > uncompressed_size - result.size() ) {
+            throw binary_error( "compressed data expands beyond the expected size" );
+        }
+        in.read_bytes( result, literals );
+        if( result.size() == uncompressed_size ) {
+            break;
+        }
+        const uint64_t length = in.read_uint() + lz_min_match;
+        const uint64_t offset = in.read_uint();
+        if( offset == 0 || offset > result.size() ) {
+            throw binary_error( "invalid back reference in compressed data" );
+        }
+        if( length > uncompressed_size - result.size() ) {
+            throw binary_error( "compressed data expands beyond the expected size" );
+        }
+        // Copy byte wise, the source may overlap the bytes being written.
+        size_t from = result.size() - offset;
+        for( uint64_t i = 0; i < length; i++ ) {
+            result.push_back( result[from++] );
+        }
+    }
+    return result;
+}
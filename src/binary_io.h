@@ -0,0 +1,86 @@
+#pragma once
+#ifndef CATA_SRC_BINARY_IO_H
+#define CATA_SRC_BINARY_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Helpers for compact binary save data, used where JSON is too slow or too large
+ * (e.g. the map quads written by @ref mapbuffer).
+ *
+ * Unsigned integers are written as little endian base 128 varints, signed integers are
+ * zigzag encoded first so small negative numbers stay small. Strings are prefixed with
+ * their length. There is no type information in the stream, the reader has to know
+ * what to expect.
+ */
+class binary_error : public std::runtime_error
+{
+    public:
+        explicit binary_error( const std::string &msg ) : std::runtime_error( msg ) { }
+};
+
+class binary_out
+{
+    public:
+        void write_uint( uint64_t value );
+        void write_int( int64_t value );
+        void write_string( const std::string &value );
+        /** Appends raw bytes without a length prefix. */
+        void write_bytes( const char *data, size_t size );
+
+        const std::string &data() const {
+            return buffer;
+        }
+
+    private:
+        std::string buffer;
+};
+
+/**
+ * Reads what @ref binary_out wrote. The data is not copied, it must outlive the reader.
+ * All functions throw @ref binary_error when the data ends prematurely or is malformed.
+ */
+class binary_in
+{
+    public:
+        explicit binary_in( const std::string &data ) : data( data ) { }
+
+        uint64_t read_uint();
+        int64_t read_int();
+        /** Reads an unsigned value that must be smaller than @p limit, e.g. an index. */
+        size_t read_index( size_t limit );
+        std::string read_string();
+        /** Appends @p size raw bytes (as written by @ref binary_out::write_bytes) to @p dest. */
+        void read_bytes( std::string &dest, size_t size );
+
+        bool eof() const {
+            return pos >= data.size();
+        }
+        /** Number of bytes consumed so far. */
+        size_t offset() const {
+            return pos;
+        }
+
+    private:
+        const std::string &data;
+        size_t pos = 0;
+};
+
+/**
+ * A simple LZ77 style compressor: repeated byte sequences (at least 4 bytes long, at most
+ * 64 KiB back) are replaced by (length, offset) references. It's not competitive with
+ * zlib, but it's fast and save data (especially the palette indices of map quads) is
+ * very repetitive.
+ */
+std::string lz_compress( const std::string &input );
+/**
+ * Reverses @ref lz_compress. @p uncompressed_size must be the size of the original input,
+ * it has to be stored separately.
+ * @throws binary_error if the input is corrupted.
+ */
+std::string lz_decompress( const std::string &input, size_t uncompressed_size );
+
+#endif // CATA_SRC_BINARY_IO_H
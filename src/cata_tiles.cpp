@@ -44,6 +44,7 @@
 #include "mtype.h"
 #include "npc.h"
 #include "optional.h"
+#include "options.h"
 #include "output.h"
 #include "overlay_ordering.h"
 #include "path_info.h"
@@ -75,6 +76,8 @@ static const efftype_id effect_ridden( "ridden" );
 static const std::string ITEM_HIGHLIGHT( "highlight_item" );
 static const std::string ZOMBIE_REVIVAL_INDICATOR( "zombie_revival_indicator" );
 
+static const option_ref<std::string> option_use_celsius( "USE_CELSIUS" );
+
 static const std::array<std::string, 8> multitile_keys = {{
         "center",
         "corner",
@@ -253,6 +256,7 @@ void cata_tiles::load_tileset( const std::string &tileset_id, const bool prechec
     tileset_loader loader( *new_tileset_ptr, renderer );
     loader.load( tileset_id, precheck );
     tileset_ptr = std::move( new_tileset_ptr );
+    tile_lookups.clear();
 
     set_draw_scale( 16 );
 
@@ -263,6 +267,7 @@ void cata_tiles::reinit()
 {
     set_draw_scale( 16 );
     RenderClear( renderer );
+    tile_lookups.clear();
 }
 
 static void get_tile_information( const std::string &config_path, std::string &json_path,
@@ -1190,9 +1195,10 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                 } else {
                     color = catacurses::blue + bold;
                 }
-                if( get_option<std::string>( "USE_CELSIUS" ) == "celsius" ) {
+                const std::string temp_units = option_use_celsius.get();
+                if( temp_units == "celsius" ) {
                     temp_value = temp_to_celsius( temp_value );
-                } else if( get_option<std::string>( "USE_CELSIUS" ) == "kelvin" ) {
+                } else if( temp_units == "kelvin" ) {
                     temp_value = temp_to_kelvin( temp_value );
 
                 }
@@ -1449,15 +1455,15 @@ void cata_tiles::get_window_tile_counts( const int width, const int height, int
     }
 }
 
-bool cata_tiles::draw_from_id_string( std::string id, const tripoint &pos, int subtile, int rota,
-                                      lit_level ll, bool apply_night_vision_goggles )
+bool cata_tiles::draw_from_id_string( const std::string &id, const tripoint &pos, int subtile,
+                                      int rota, lit_level ll, bool apply_night_vision_goggles )
 {
     int nullint = 0;
-    return cata_tiles::draw_from_id_string( std::move( id ), C_NONE, empty_string, pos, subtile, rota,
+    return cata_tiles::draw_from_id_string( id, C_NONE, empty_string, pos, subtile, rota,
                                             ll, apply_night_vision_goggles, nullint );
 }
 
-bool cata_tiles::draw_from_id_string( std::string id, TILE_CATEGORY category,
+bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY category,
                                       const std::string &subcategory, const tripoint &pos,
                                       int subtile, int rota, lit_level ll,
                                       bool apply_night_vision_goggles )
@@ -1467,10 +1473,10 @@ bool cata_tiles::draw_from_id_string( std::string id, TILE_CATEGORY category,
                                             ll, apply_night_vision_goggles, nullint );
 }
 
-bool cata_tiles::draw_from_id_string( std::string id, const tripoint &pos, int subtile, int rota,
-                                      lit_level ll, bool apply_night_vision_goggles, int &height_3d )
+bool cata_tiles::draw_from_id_string( const std::string &id, const tripoint &pos, int subtile,
+                                      int rota, lit_level ll, bool apply_night_vision_goggles, int &height_3d )
 {
-    return cata_tiles::draw_from_id_string( std::move( id ), C_NONE, empty_string, pos, subtile, rota,
+    return cata_tiles::draw_from_id_string( id, C_NONE, empty_string, pos, subtile, rota,
                                             ll, apply_night_vision_goggles, height_3d );
 }
 
@@ -1554,6 +1560,68 @@ const tile_type *cata_tiles::find_tile_looks_like( std::string &id, TILE_CATEGOR
     return nullptr;
 }
 
+cata_tiles::tile_lookup cata_tiles::create_tile_lookup( const std::string &id,
+        const TILE_CATEGORY category )
+{
+    tile_lookup found;
+    found.id = id;
+    found.tile = find_tile_looks_like( found.id, category );
+    if( found.tile && found.tile->multitile ) {
+        for( size_t i = 0; i < multitile_keys.size(); i++ ) {
+            const std::vector<std::string> &available = found.tile->available_subtiles;
+            if( std::find( available.begin(), available.end(), multitile_keys[i] ) != available.end() ) {
+                std::string subtile_id = found.id + "_" + multitile_keys[i];
+                found.has_subtile[i] = true;
+                found.subtiles[i] = find_tile_with_season( subtile_id );
+            }
+        }
+    }
+    if( category == C_FURNITURE ) {
+        const furn_str_id fid( found.id );
+        found.fixed_furniture = fid.is_valid() && !fid.obj().is_movable();
+    }
+    return found;
+}
+
+const cata_tiles::tile_lookup &cata_tiles::find_tile_lookup( const std::string &id,
+        const TILE_CATEGORY category )
+{
+    tile_lookups.set_season( season_of_year( calendar::turn ) );
+    return tile_lookups.find( id, category, [this, category]( const std::string & name ) {
+        return create_tile_lookup( name, category );
+    } );
+}
+
+template<typename T>
+const cata_tiles::tile_lookup &cata_tiles::find_tile_lookup( const int_id<T> &id,
+        const TILE_CATEGORY category )
+{
+    tile_lookups.set_season( season_of_year( calendar::turn ) );
+    return tile_lookups.find( id, category, [this, category]( const std::string & name ) {
+        return create_tile_lookup( name, category );
+    } );
+}
+
+const cata_tiles::tile_lookup &cata_tiles::find_tile_lookup( const ter_id &id )
+{
+    return find_tile_lookup( id, C_TERRAIN );
+}
+
+const cata_tiles::tile_lookup &cata_tiles::find_tile_lookup( const furn_id &id )
+{
+    return find_tile_lookup( id, C_FURNITURE );
+}
+
+const cata_tiles::tile_lookup &cata_tiles::find_tile_lookup( const trap_id &id )
+{
+    return find_tile_lookup( id, C_TRAP );
+}
+
+const cata_tiles::tile_lookup &cata_tiles::find_tile_lookup( const field_type_id &id )
+{
+    return find_tile_lookup( id, C_FIELD );
+}
+
 bool cata_tiles::find_overlay_looks_like( const bool male, const std::string &overlay,
         std::string &draw_id )
 {
@@ -1596,10 +1664,19 @@ bool cata_tiles::find_overlay_looks_like( const bool male, const std::string &ov
     return exists;
 }
 
-bool cata_tiles::draw_from_id_string( std::string id, TILE_CATEGORY category,
+bool cata_tiles::draw_from_id_string( const std::string &id, TILE_CATEGORY category,
                                       const std::string &subcategory, const tripoint &pos,
                                       int subtile, int rota, lit_level ll,
                                       bool apply_night_vision_goggles, int &height_3d )
+{
+    return draw_from_id_string( find_tile_lookup( id, category ), id, category, subcategory, pos,
+                                subtile, rota, ll, apply_night_vision_goggles, height_3d );
+}
+
+bool cata_tiles::draw_from_id_string( const tile_lookup &found, const std::string &id,
+                                      TILE_CATEGORY category, const std::string &subcategory,
+                                      const tripoint &pos, int subtile, int rota, lit_level ll,
+                                      bool apply_night_vision_goggles, int &height_3d )
 {
     // If the ID string does not produce a drawable tile
     // it will revert to the "unknown" tile.
@@ -1614,7 +1691,8 @@ bool cata_tiles::draw_from_id_string( std::string id, TILE_CATEGORY category,
         return false;
     }
 
-    const tile_type *tt = find_tile_looks_like( id, category );
+    const tile_type *tt = found.tile;
+    bool fixed_furniture = found.fixed_furniture;
 
     if( !tt ) {
         uint32_t sym = UNKNOWN_UNICODE;
@@ -1774,18 +1852,22 @@ bool cata_tiles::draw_from_id_string( std::string id, TILE_CATEGORY category,
         return false;
     }
 
-    const tile_type &display_tile = *tt;
     // check to see if the display_tile is multitile, and if so if it has the key related to subtile
-    if( subtile != -1 && display_tile.multitile ) {
-        const auto &display_subtiles = display_tile.available_subtiles;
-        const auto end = std::end( display_subtiles );
-        if( std::find( begin( display_subtiles ), end, multitile_keys[subtile] ) != end ) {
+    if( subtile != -1 && tt->multitile ) {
+        if( tt == found.tile && found.subtiles[subtile] ) {
+            // the subtile of the looked up tile, its id is never furniture
+            tt = found.subtiles[subtile];
+            subtile = -1;
+            fixed_furniture = false;
+        } else if( tt == found.tile ? found.has_subtile[subtile] :
+                   std::find( tt->available_subtiles.begin(), tt->available_subtiles.end(),
+                              multitile_keys[subtile] ) != tt->available_subtiles.end() ) {
             // append subtile name to tile and re-find display_tile
-            return draw_from_id_string(
-                       std::move( id.append( "_", 1 ).append( multitile_keys[subtile] ) ),
-                       category, subcategory, pos, -1, rota, ll, apply_night_vision_goggles, height_3d );
+            return draw_from_id_string( found.id + "_" + multitile_keys[subtile],
+                                        category, subcategory, pos, -1, rota, ll, apply_night_vision_goggles, height_3d );
         }
     }
+    const tile_type &display_tile = *tt;
 
     // translate from player-relative to screen relative tile position
     const point screen_pos = player_to_screen( pos.xy() );
@@ -1827,20 +1909,15 @@ bool cata_tiles::draw_from_id_string( std::string id, TILE_CATEGORY category,
 
         }
         break;
-        case C_FURNITURE: {
+        case C_FURNITURE:
             // If the furniture is not movable, we'll allow seeding by the position
             // since we won't get the behavior that occurs where the tile constantly
             // changes when the player grabs the furniture and drags it, causing the
             // seed to change.
-            const furn_str_id fid( id );
-            if( fid.is_valid() ) {
-                const furn_t &f = fid.obj();
-                if( !f.is_movable() ) {
-                    seed = g->m.getabs( pos ).x + g->m.getabs( pos ).y * 65536;
-                }
+            if( fixed_furniture ) {
+                seed = g->m.getabs( pos ).x + g->m.getabs( pos ).y * 65536;
             }
-        }
-        break;
+            break;
         case C_ITEM:
         case C_TRAP:
         case C_NONE:
@@ -1857,12 +1934,12 @@ bool cata_tiles::draw_from_id_string( std::string id, TILE_CATEGORY category,
             break;
         default:
             // player
-            if( id.substr( 7 ) == "player_" ) {
+            if( found.id.substr( 7 ) == "player_" ) {
                 seed = g->u.name[0];
                 break;
             }
             // NPC
-            if( id.substr( 4 ) == "npc_" ) {
+            if( found.id.substr( 4 ) == "npc_" ) {
                 if( npc *const guy = g->critter_at<npc>( pos ) ) {
                     seed = guy->getID().get_value();
                     break;
@@ -2200,8 +2277,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
         }
         // draw the actual terrain if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d );
+            return draw_from_id_string( find_tile_lookup( t ), tname, C_TERRAIN, empty_string, p,
+                                        subtile, rotation, ll, nv_goggles_activated, height_3d );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -2223,8 +2300,8 @@ bool cata_tiles::draw_terrain( const tripoint &p, const lit_level ll, int &heigh
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? LL_LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( tname, C_TERRAIN, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d );
+            return draw_from_id_string( find_tile_lookup( t2 ), tname, C_TERRAIN, empty_string, p,
+                                        subtile, rotation, lit, nv, height_3d );
         }
     } else if( invisible[0] && has_terrain_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
@@ -2364,8 +2441,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
         }
         // draw the actual furniture if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d );
+            return draw_from_id_string( find_tile_lookup( f ), fname, C_FURNITURE, empty_string, p,
+                                        subtile, rotation, ll, nv_goggles_activated, height_3d );
         }
     }
     if( invisible[0] ? overridden : neighborhood_overridden ) {
@@ -2393,8 +2470,8 @@ bool cata_tiles::draw_furniture( const tripoint &p, const lit_level ll, int &hei
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? LL_LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( fname, C_FURNITURE, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d );
+            return draw_from_id_string( find_tile_lookup( f2 ), fname, C_FURNITURE, empty_string, p,
+                                        subtile, rotation, lit, nv, height_3d );
         }
     } else if( invisible[0] && has_furniture_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
@@ -2432,14 +2509,14 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
         int subtile = 0;
         int rotation = 0;
         get_tile_values( tr.to_i(), neighborhood, subtile, rotation );
-        const std::string trname = tr.id().str();
+        const std::string &trname = tr.id().str();
         if( g->m.check_seen_cache( p ) ) {
             g->u.memorize_tile( g->m.getabs( p ), trname, subtile, rotation );
         }
         // draw the actual trap if there's no override
         if( !neighborhood_overridden ) {
-            return draw_from_id_string( trname, C_TRAP, empty_string, p, subtile, rotation, ll,
-                                        nv_goggles_activated, height_3d );
+            return draw_from_id_string( find_tile_lookup( tr ), trname, C_TRAP, empty_string, p,
+                                        subtile, rotation, ll, nv_goggles_activated, height_3d );
         }
     }
     if( overridden || ( !invisible[0] && neighborhood_overridden && tr.obj().can_see( p, g->u ) ) ) {
@@ -2467,8 +2544,8 @@ bool cata_tiles::draw_trap( const tripoint &p, const lit_level ll, int &height_3
             // tile overrides are always shown with full visibility
             const lit_level lit = overridden ? LL_LIT : ll;
             const bool nv = overridden ? false : nv_goggles_activated;
-            return draw_from_id_string( trname, C_TRAP, empty_string, p, subtile, rotation, lit, nv,
-                                        height_3d );
+            return draw_from_id_string( find_tile_lookup( tr2 ), trname, C_TRAP, empty_string, p,
+                                        subtile, rotation, lit, nv, height_3d );
         }
     } else if( invisible[0] && has_trap_memory_at( p ) ) {
         // try drawing memory if invisible and not overridden
@@ -2521,8 +2598,9 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
         int rotation = 0;
         get_tile_values( fld.to_i(), neighborhood, subtile, rotation );
 
-        ret_draw_field = draw_from_id_string( fld.id().str(), C_FIELD, empty_string, p, subtile,
-                                              rotation, lit, nv );
+        int nullint = 0;
+        ret_draw_field = draw_from_id_string( find_tile_lookup( fld ), fld.id().str(), C_FIELD,
+                                              empty_string, p, subtile, rotation, lit, nv, nullint );
     }
     if( fld.obj().display_items ) {
         const auto it_override = item_override.find( p );
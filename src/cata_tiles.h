@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_CATA_TILES_H
 #define CATA_SRC_CATA_TILES_H
 
+#include <array>
 #include <cstddef>
 #include <map>
 #include <memory>
@@ -21,6 +22,7 @@
 #include "pimpl.h"
 #include "point.h"
 #include "sdl_wrappers.h"
+#include "tile_lookup_cache.h"
 #include "type_id.h"
 #include "weather.h"
 #include "weighted_list.h"
@@ -293,16 +295,46 @@ class cata_tiles
         const tile_type *find_tile_looks_like( std::string &id, TILE_CATEGORY category );
         bool find_overlay_looks_like( bool male, const std::string &overlay, std::string &draw_id );
 
-        bool draw_from_id_string( std::string id, const tripoint &pos, int subtile, int rota, lit_level ll,
-                                  bool apply_night_vision_goggles );
-        bool draw_from_id_string( std::string id, TILE_CATEGORY category,
+        /** The result of @ref find_tile_looks_like and of the multitile lookups for an id. */
+        struct tile_lookup {
+            // nullptr if there is no tile for the id, the fallbacks are up to the caller.
+            const tile_type *tile = nullptr;
+            // The id of the tile, differs from the looked up id for looks_like and seasonal tiles.
+            std::string id;
+            // Whether the tile lists a subtile, and the tile of it (nullptr if it doesn't exist).
+            std::array<bool, num_multitile_types> has_subtile = {};
+            std::array<const tile_type *, num_multitile_types> subtiles = {};
+            // Non-movable furniture picks its random sprite by position.
+            bool fixed_furniture = false;
+        };
+        /**
+         * Looks up the tile for an id once and remembers it until the tileset or the season
+         * changes. The overloads for int ids don't hash the id either.
+         */
+        const tile_lookup &find_tile_lookup( const std::string &id, TILE_CATEGORY category );
+        const tile_lookup &find_tile_lookup( const ter_id &id );
+        const tile_lookup &find_tile_lookup( const furn_id &id );
+        const tile_lookup &find_tile_lookup( const trap_id &id );
+        const tile_lookup &find_tile_lookup( const field_type_id &id );
+        template<typename T>
+        const tile_lookup &find_tile_lookup( const int_id<T> &id, TILE_CATEGORY category );
+        tile_lookup create_tile_lookup( const std::string &id, TILE_CATEGORY category );
+
+        bool draw_from_id_string( const std::string &id, const tripoint &pos, int subtile, int rota,
+                                  lit_level ll, bool apply_night_vision_goggles );
+        bool draw_from_id_string( const std::string &id, TILE_CATEGORY category,
                                   const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                   lit_level ll, bool apply_night_vision_goggles );
-        bool draw_from_id_string( std::string id, const tripoint &pos, int subtile, int rota, lit_level ll,
-                                  bool apply_night_vision_goggles, int &height_3d );
-        bool draw_from_id_string( std::string id, TILE_CATEGORY category,
+        bool draw_from_id_string( const std::string &id, const tripoint &pos, int subtile, int rota,
+                                  lit_level ll, bool apply_night_vision_goggles, int &height_3d );
+        bool draw_from_id_string( const std::string &id, TILE_CATEGORY category,
                                   const std::string &subcategory, const tripoint &pos, int subtile, int rota,
                                   lit_level ll, bool apply_night_vision_goggles, int &height_3d );
+        /** Draws the looked up tile of @p id, @p id is only needed if there is no tile for it. */
+        bool draw_from_id_string( const tile_lookup &found, const std::string &id,
+                                  TILE_CATEGORY category, const std::string &subcategory, const tripoint &pos,
+                                  int subtile, int rota, lit_level ll, bool apply_night_vision_goggles,
+                                  int &height_3d );
         bool draw_sprite_at(
             const tile_type &tile, const weighted_int_list<std::vector<int>> &svlist,
             const point &, unsigned int loc_rand, bool rota_fg, int rota, lit_level ll,
@@ -501,6 +533,9 @@ class cata_tiles
         const SDL_Renderer_Ptr &renderer;
         std::unique_ptr<tileset> tileset_ptr;
 
+        // Looked up tiles, by category and id.
+        tile_lookup_cache<tile_lookup, TILE_CATEGORY> tile_lookups;
+
         int tile_height = 0;
         int tile_width = 0;
         // The width and height of the area we can draw in,
@@ -12,6 +12,7 @@
 #include <stdexcept>
 #include <string>
 
+#include "background_save.h"
 #include "catacharset.h"
 #include "debug.h"
 #include "filesystem.h"
@@ -353,6 +354,14 @@ float multi_lerp( const std::vector<std::pair<float, float>> &points, float x )
 
 void write_to_file( const std::string &path, const std::function<void( std::ostream & )> &writer )
 {
+    if( background_save::is_deferring() ) {
+        std::ostringstream buffer;
+        writer( buffer );
+        background_save::enqueue( path, buffer.str() );
+        return;
+    }
+    // An older snapshot must not overwrite what we're about to write.
+    background_save::wait_for( path );
     // Any of the below may throw. ofstream_wrapper will clean up the temporary path on its own.
     ofstream_wrapper fout( path, std::ios::binary );
     writer( fout.stream() );
@@ -419,6 +428,7 @@ std::istream &safe_getline( std::istream &ins, std::string &str )
 
 bool read_from_file( const std::string &path, const std::function<void( std::istream & )> &reader )
 {
+    background_save::wait_for( path );
     try {
         std::ifstream fin( path, std::ios::binary );
         if( !fin ) {
@@ -457,6 +467,8 @@ bool read_from_file_optional( const std::string &path,
     // Note: slight race condition here, but we'll ignore it. Worst case: the file
     // exists and got removed before reading it -> reading fails with a message
     // Or file does not exists, than everything works fine because it's optional anyway.
+    // A file that is about to be written in the background doesn't exist yet.
+    background_save::wait_for( path );
     return file_exist( path ) && read_from_file( path, reader );
 }
 
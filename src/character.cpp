@@ -3878,11 +3878,11 @@ int Character::get_int_bonus() const
 
 static int get_speedydex_bonus( const int dex )
 {
-    static const std::string speedydex_min_dex( "SPEEDYDEX_MIN_DEX" );
-    static const std::string speedydex_dex_speed( "SPEEDYDEX_DEX_SPEED" );
+    static const option_ref<int> speedydex_min_dex( "SPEEDYDEX_MIN_DEX" );
+    static const option_ref<int> speedydex_dex_speed( "SPEEDYDEX_DEX_SPEED" );
     // this is the number to be multiplied by the increment
-    const int modified_dex = std::max( dex - get_option<int>( speedydex_min_dex ), 0 );
-    return modified_dex * get_option<int>( speedydex_dex_speed );
+    const int modified_dex = std::max( dex - speedydex_min_dex.get(), 0 );
+    return modified_dex * speedydex_dex_speed.get();
 }
 
 int Character::get_speed() const
@@ -4788,8 +4788,8 @@ needs_rates Character::calc_needs_rates() const
 
     add_msg_if_player( m_debug, "Metabolic rate: %.2f", rates.hunger );
 
-    static const std::string player_thirst_rate( "PLAYER_THIRST_RATE" );
-    rates.thirst = get_option< float >( player_thirst_rate );
+    static const option_ref<float> player_thirst_rate( "PLAYER_THIRST_RATE" );
+    rates.thirst = player_thirst_rate.get();
     static const std::string thirst_modifier( "thirst_modifier" );
     rates.thirst *= 1.0f + mutation_value( thirst_modifier );
     static const std::string slows_thirst( "SLOWS_THIRST" );
@@ -4797,8 +4797,8 @@ needs_rates Character::calc_needs_rates() const
         rates.thirst *= 0.7f;
     }
 
-    static const std::string player_fatigue_rate( "PLAYER_FATIGUE_RATE" );
-    rates.fatigue = get_option< float >( player_fatigue_rate );
+    static const option_ref<float> player_fatigue_rate( "PLAYER_FATIGUE_RATE" );
+    rates.fatigue = player_fatigue_rate.get();
     static const std::string fatigue_modifier( "fatigue_modifier" );
     rates.fatigue *= 1.0f + mutation_value( fatigue_modifier );
 
@@ -6746,13 +6746,9 @@ float Character::mutation_value( const std::string &val ) const
 
 float Character::healing_rate( float at_rest_quality ) const
 {
-    // TODO: Cache
-    float heal_rate;
-    if( !is_npc() ) {
-        heal_rate = get_option< float >( "PLAYER_HEALING_RATE" );
-    } else {
-        heal_rate = get_option< float >( "NPC_HEALING_RATE" );
-    }
+    static const option_ref<float> player_healing_rate( "PLAYER_HEALING_RATE" );
+    static const option_ref<float> npc_healing_rate( "NPC_HEALING_RATE" );
+    const float heal_rate = is_npc() ? npc_healing_rate.get() : player_healing_rate.get();
     float awake_rate = heal_rate * mutation_value( "healing_awake" );
     float final_rate = 0.0f;
     if( awake_rate > 0.0f ) {
@@ -7208,9 +7204,9 @@ int Character::get_stamina() const
 
 int Character::get_stamina_max() const
 {
-    static const std::string player_max_stamina( "PLAYER_MAX_STAMINA" );
+    static const option_ref<int> player_max_stamina( "PLAYER_MAX_STAMINA" );
     static const std::string max_stamina_modifier( "max_stamina_modifier" );
-    int maxStamina = get_option< int >( player_max_stamina );
+    int maxStamina = player_max_stamina.get();
     maxStamina *= Character::mutation_value( max_stamina_modifier );
     return maxStamina;
 }
@@ -7243,7 +7239,8 @@ void Character::burn_move_stamina( int moves )
         overburden_percentage = ( current_weight - max_weight ) * 100 / max_weight;
     }
 
-    int burn_ratio = get_option<int>( "PLAYER_BASE_STAMINA_BURN_RATE" );
+    static const option_ref<int> player_base_stamina_burn_rate( "PLAYER_BASE_STAMINA_BURN_RATE" );
+    int burn_ratio = player_base_stamina_burn_rate.get();
     for( const bionic_id &bid : get_bionic_fueled_with( item( "muscle" ) ) ) {
         if( has_active_bionic( bid ) ) {
             burn_ratio = burn_ratio * 2 - 3;
@@ -7284,9 +7281,9 @@ float Character::stamina_move_cost_modifier() const
 
 void Character::update_stamina( int turns )
 {
-    static const std::string player_base_stamina_regen_rate( "PLAYER_BASE_STAMINA_REGEN_RATE" );
+    static const option_ref<float> player_base_stamina_regen_rate( "PLAYER_BASE_STAMINA_REGEN_RATE" );
     static const std::string stamina_regen_modifier( "stamina_regen_modifier" );
-    const float base_regen_rate = get_option<float>( player_base_stamina_regen_rate );
+    const float base_regen_rate = player_base_stamina_regen_rate.get();
     const int current_stim = get_stim();
     float stamina_recovery = 0.0f;
     // Recover some stamina every turn.
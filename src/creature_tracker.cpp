@@ -6,7 +6,10 @@
 #include <string>
 #include <utility>
 
+#include "coordinate_conversions.h"
 #include "debug.h"
+#include "game_constants.h"
+#include "line.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -31,6 +34,72 @@ shared_ptr_fast<monster> Creature_tracker::find( const tripoint &pos ) const
     return nullptr;
 }
 
+using submap_buckets = std::unordered_map<tripoint, std::vector<shared_ptr_fast<monster>>>;
+
+// Living monsters in @p buckets (indexed by submap) within @p radius of @p pos.
+static std::vector<shared_ptr_fast<monster>> living_monsters_within(
+            const submap_buckets &buckets, const tripoint &pos, const int radius )
+{
+    std::vector<shared_ptr_fast<monster>> result;
+    if( radius < 0 ) {
+        return result;
+    }
+    const tripoint sm_min = ms_to_sm_copy( pos - tripoint( radius, radius, 0 ) );
+    const tripoint sm_max = ms_to_sm_copy( pos + tripoint( radius, radius, 0 ) );
+    const int z_min = std::max( pos.z - radius, -OVERMAP_DEPTH );
+    const int z_max = std::min( pos.z + radius, OVERMAP_HEIGHT );
+
+    const auto collect = [&]( const std::vector<shared_ptr_fast<monster>> &bucket ) {
+        for( const shared_ptr_fast<monster> &mon_ptr : bucket ) {
+            if( !mon_ptr->is_dead() && rl_dist( pos, mon_ptr->pos() ) <= radius ) {
+                result.push_back( mon_ptr );
+            }
+        }
+    };
+
+    const long long submaps_in_range = static_cast<long long>( sm_max.x - sm_min.x + 1 ) *
+                                       ( sm_max.y - sm_min.y + 1 ) * ( z_max - z_min + 1 );
+    if( submaps_in_range > static_cast<long long>( buckets.size() ) ) {
+        // Huge radius (e.g. a loud explosion), checking the occupied submaps is cheaper.
+        for( const auto &entry : buckets ) {
+            const tripoint &sm = entry.first;
+            if( sm.x >= sm_min.x && sm.x <= sm_max.x && sm.y >= sm_min.y && sm.y <= sm_max.y &&
+                sm.z >= z_min && sm.z <= z_max ) {
+                collect( entry.second );
+            }
+        }
+        return result;
+    }
+
+    for( int z = z_min; z <= z_max; z++ ) {
+        for( int x = sm_min.x; x <= sm_max.x; x++ ) {
+            for( int y = sm_min.y; y <= sm_max.y; y++ ) {
+                const auto iter = buckets.find( tripoint( x, y, z ) );
+                if( iter != buckets.end() ) {
+                    collect( iter->second );
+                }
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<shared_ptr_fast<monster>> Creature_tracker::monsters_within( const tripoint &pos,
+                                   const int radius ) const
+{
+    return living_monsters_within( monsters_by_submap, pos, radius );
+}
+
+std::vector<shared_ptr_fast<monster>> Creature_tracker::monsters_of_faction_within(
+                                       const mfaction_id &faction, const tripoint &pos, const int radius ) const
+{
+    const auto iter = monsters_by_faction_submap.find( faction );
+    if( iter == monsters_by_faction_submap.end() ) {
+        return {};
+    }
+    return living_monsters_within( iter->second, pos, radius );
+}
+
 int Creature_tracker::temporary_id( const monster &critter ) const
 {
     const auto iter = std::find_if( monsters_list.begin(), monsters_list.end(),
@@ -85,7 +154,7 @@ bool Creature_tracker::add( shared_ptr_fast<monster> critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.pos()] = critter_ptr;
+    add_to_location_map( critter.pos(), critter_ptr );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -96,11 +165,50 @@ void Creature_tracker::add_to_faction_map( shared_ptr_fast<monster> critter_ptr
     monster &critter = *critter_ptr;
 
     // Only 1 faction per mon at the moment.
-    if( critter.friendly == 0 ) {
-        monster_faction_map_[ critter.faction ].insert( critter_ptr );
-    } else {
-        static const mfaction_str_id playerfaction( "player" );
-        monster_faction_map_[ playerfaction ].insert( critter_ptr );
+    static const mfaction_str_id playerfaction( "player" );
+    const mfaction_id faction = critter.friendly == 0 ? critter.faction : playerfaction.id();
+    monster_faction_map_[ faction ].insert( critter_ptr );
+    filed_factions[ &critter ] = faction;
+
+    const auto pos_iter = monsters_by_location.find( critter.pos() );
+    if( pos_iter != monsters_by_location.end() && pos_iter->second == critter_ptr ) {
+        add_to_faction_buckets( critter.pos(), critter_ptr );
+    }
+}
+
+void Creature_tracker::add_to_faction_buckets( const tripoint &pos,
+        const shared_ptr_fast<monster> &critter )
+{
+    const auto iter = filed_factions.find( critter.get() );
+    if( iter != filed_factions.end() ) {
+        monsters_by_faction_submap[iter->second][ms_to_sm_copy( pos )].push_back( critter );
+    }
+}
+
+void Creature_tracker::erase_from_faction_buckets( const tripoint &pos,
+        const shared_ptr_fast<monster> &critter )
+{
+    const auto iter = filed_factions.find( critter.get() );
+    if( iter == filed_factions.end() ) {
+        return;
+    }
+    const auto buckets_iter = monsters_by_faction_submap.find( iter->second );
+    if( buckets_iter == monsters_by_faction_submap.end() ) {
+        return;
+    }
+    submap_buckets &buckets = buckets_iter->second;
+    const auto bucket_iter = buckets.find( ms_to_sm_copy( pos ) );
+    if( bucket_iter == buckets.end() ) {
+        return;
+    }
+    std::vector<shared_ptr_fast<monster>> &bucket = bucket_iter->second;
+    const auto mon_iter = std::find( bucket.begin(), bucket.end(), critter );
+    if( mon_iter != bucket.end() ) {
+        *mon_iter = std::move( bucket.back() );
+        bucket.pop_back();
+    }
+    if( bucket.empty() ) {
+        buckets.erase( bucket_iter );
     }
 }
 
@@ -135,8 +243,11 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( critter.pos() );
-        monsters_by_location[new_pos] = *iter;
+        const auto old_iter = monsters_by_location.find( critter.pos() );
+        if( old_iter != monsters_by_location.end() ) {
+            erase_from_location_map( old_iter );
+        }
+        add_to_location_map( new_pos, *iter );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -151,11 +262,51 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
     }
 }
 
+void Creature_tracker::add_to_location_map( const tripoint &pos,
+        const shared_ptr_fast<monster> &critter )
+{
+    shared_ptr_fast<monster> &slot = monsters_by_location[pos];
+    if( slot ) {
+        std::vector<shared_ptr_fast<monster>> &bucket = monsters_by_submap[ms_to_sm_copy( pos )];
+        const auto iter = std::find( bucket.begin(), bucket.end(), slot );
+        if( iter != bucket.end() ) {
+            *iter = critter;
+        } else {
+            bucket.push_back( critter );
+        }
+        erase_from_faction_buckets( pos, slot );
+    } else {
+        monsters_by_submap[ms_to_sm_copy( pos )].push_back( critter );
+    }
+    add_to_faction_buckets( pos, critter );
+    slot = critter;
+}
+
+void Creature_tracker::erase_from_location_map(
+    std::unordered_map<tripoint, shared_ptr_fast<monster>>::iterator iter )
+{
+    const auto bucket_iter = monsters_by_submap.find( ms_to_sm_copy( iter->first ) );
+    if( bucket_iter != monsters_by_submap.end() ) {
+        std::vector<shared_ptr_fast<monster>> &bucket = bucket_iter->second;
+        const auto mon_iter = std::find( bucket.begin(), bucket.end(), iter->second );
+        if( mon_iter != bucket.end() ) {
+            // Order within a bucket doesn't matter.
+            *mon_iter = std::move( bucket.back() );
+            bucket.pop_back();
+        }
+        if( bucket.empty() ) {
+            monsters_by_submap.erase( bucket_iter );
+        }
+    }
+    erase_from_faction_buckets( iter->first, iter->second );
+    monsters_by_location.erase( iter );
+}
+
 void Creature_tracker::remove_from_location_map( const monster &critter )
 {
     const auto pos_iter = monsters_by_location.find( critter.pos() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
-        monsters_by_location.erase( pos_iter );
+        erase_from_location_map( pos_iter );
         return;
     }
 
@@ -166,7 +317,7 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
         return v.second.get() == &critter;
     } );
     if( iter != monsters_by_location.end() ) {
-        monsters_by_location.erase( iter );
+        erase_from_location_map( iter );
     }
 }
 
@@ -191,6 +342,7 @@ void Creature_tracker::remove( const monster &critter )
         }
     }
     remove_from_location_map( critter );
+    filed_factions.erase( &critter );
     removed_.push_back( *iter );
     monsters_list.erase( iter );
 }
@@ -199,16 +351,22 @@ void Creature_tracker::clear()
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_submap.clear();
     monster_faction_map_.clear();
+    filed_factions.clear();
+    monsters_by_faction_submap.clear();
     removed_.clear();
 }
 
 void Creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    monsters_by_submap.clear();
     monster_faction_map_.clear();
+    filed_factions.clear();
+    monsters_by_faction_submap.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->pos()] = mon_ptr;
+        add_to_location_map( mon_ptr->pos(), mon_ptr );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -227,13 +385,13 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     shared_ptr_fast<monster> first_ptr;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
+        erase_from_location_map( first_iter );
     }
 
     shared_ptr_fast<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
+        erase_from_location_map( second_iter );
     }
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
@@ -243,10 +401,10 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.pos()] = first_ptr;
+        add_to_location_map( first.pos(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.pos()] = second_ptr;
+        add_to_location_map( second.pos(), second_ptr );
     }
 }
 
@@ -281,6 +439,7 @@ void Creature_tracker::remove_dead()
         const monster &critter = **iter;
         if( critter.is_dead() ) {
             remove_from_location_map( critter );
+            filed_factions.erase( &critter );
             iter = monsters_list.erase( iter );
         } else {
             ++iter;
@@ -49,6 +49,19 @@ class Creature_tracker
          * Dead monsters are ignored and not returned.
          */
         shared_ptr_fast<monster> find( const tripoint &pos ) const;
+        /**
+         * Returns all living monsters within @p radius (as measured by @ref rl_dist) of @p pos,
+         * including those on other z-levels. Only the submaps overlapping the radius are
+         * visited, so this is much cheaper than scanning all monsters for small radii.
+         * The order of the returned monsters is unspecified.
+         */
+        std::vector<shared_ptr_fast<monster>> monsters_within( const tripoint &pos, int radius ) const;
+        /**
+         * Same as @ref monsters_within, but only returns the monsters filed under @p faction
+         * in @ref factions.
+         */
+        std::vector<shared_ptr_fast<monster>> monsters_of_faction_within( const mfaction_id &faction,
+                                           const tripoint &pos, int radius ) const;
         /**
          * Returns a temporary id of the given monster (which must exist in the tracker).
          * The id is valid until monsters are added or removed from the tracker.
@@ -94,8 +107,33 @@ class Creature_tracker
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
         std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
+        /**
+         * The same monsters as in @ref monsters_by_location, bucketed by the submap
+         * (in map square coordinates divided by SEEX/SEEY) they are on.
+         */
+        std::unordered_map<tripoint, std::vector<shared_ptr_fast<monster>>> monsters_by_submap;
+        /** The faction each monster is filed under in @ref monster_faction_map_. */
+        std::unordered_map<const monster *, mfaction_id> filed_factions;
+        /**
+         * The monsters of @ref monsters_by_submap again, split by the faction they are
+         * filed under, so searching for the monsters of one faction skips all others.
+         */
+        std::unordered_map<mfaction_id, std::unordered_map<tripoint, std::vector<shared_ptr_fast<monster>>>>
+        monsters_by_faction_submap;
+        /** Adds the monster to the bucket of its filed faction, if it has one. */
+        void add_to_faction_buckets( const tripoint &pos, const shared_ptr_fast<monster> &critter );
+        /** Removes the monster from the bucket of its filed faction, if it has one. */
+        void erase_from_faction_buckets( const tripoint &pos, const shared_ptr_fast<monster> &critter );
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+        /**
+         * Puts the monster into @ref monsters_by_location (replacing any previous entry
+         * at that location) and into @ref monsters_by_submap.
+         */
+        void add_to_location_map( const tripoint &pos, const shared_ptr_fast<monster> &critter );
+        /** Erases the entry in @ref monsters_by_location and @ref monsters_by_submap */
+        void erase_from_location_map( std::unordered_map<tripoint, shared_ptr_fast<monster>>::iterator
+                                      iter );
 };
 
 #endif // CATA_SRC_CREATURE_TRACKER_H
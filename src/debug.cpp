@@ -91,6 +91,9 @@ extern bool test_mode;
 /** Set to true when any error is logged. */
 static bool error_observed = false;
 
+/** Where the output of the current thread goes instead, see capture_debug_output. */
+static thread_local captured_debug_output *captured_output = nullptr;
+
 bool debug_has_error_been_observed()
 {
     return error_observed;
@@ -112,6 +115,11 @@ void realDebugmsg( const char *filename, const char *line, const char *funcname,
     assert( line != nullptr );
     assert( funcname != nullptr );
 
+    if( captured_output != nullptr ) {
+        captured_output->messages.push_back( { filename, line, funcname, text } );
+        return;
+    }
+
     DebugLog( D_ERROR, D_MAIN ) << filename << ":" << line << " [" << funcname << "] "
                                 << text << std::flush;
 
@@ -910,6 +918,16 @@ void debug_write_backtrace( std::ostream &out )
 
 std::ostream &DebugLog( DebugLevel lev, DebugClass cl )
 {
+    if( captured_output != nullptr ) {
+        if( ( lev & debugLevel && cl & debugClass ) || lev & D_ERROR || cl & D_MAIN ) {
+            captured_output->log.push_back( { lev, cl, std::ostringstream() } );
+            return captured_output->log.back().text;
+        }
+        // The shared null stream isn't safe to use from several threads.
+        static thread_local std::ostream thread_null_stream( &nullBuf );
+        return thread_null_stream;
+    }
+
     if( lev & D_ERROR ) {
         error_observed = true;
     }
@@ -952,6 +970,29 @@ std::ostream &DebugLog( DebugLevel lev, DebugClass cl )
     return nullStream;
 }
 
+capture_debug_output::capture_debug_output( captured_debug_output &output )
+    : previous( captured_output )
+{
+    captured_output = &output;
+}
+
+capture_debug_output::~capture_debug_output()
+{
+    captured_output = previous;
+}
+
+void replay_debug_output( captured_debug_output &output )
+{
+    for( const captured_debug_output::log_entry &entry : output.log ) {
+        DebugLog( entry.level, entry.cl ) << entry.text.str();
+    }
+    output.log.clear();
+    for( const captured_debug_output::message &msg : output.messages ) {
+        realDebugmsg( msg.filename, msg.line, msg.funcname, msg.text );
+    }
+    output.messages.clear();
+}
+
 std::string game_info::operating_system()
 {
 #if defined(__ANDROID__)
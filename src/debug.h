@@ -47,6 +47,8 @@
 // Includes                                                         {{{1
 // ---------------------------------------------------------------------
 #include <iostream>
+#include <list>
+#include <sstream>
 #include <vector>
 #include <string>
 #include <utility>
@@ -188,6 +190,47 @@ bool debug_has_error_been_observed();
 // See documentation at the top.
 std::ostream &DebugLog( DebugLevel, DebugClass );
 
+/**
+ * Output of debugmsg and DebugLog collected on a background thread by
+ * @ref capture_debug_output, see @ref replay_debug_output.
+ */
+struct captured_debug_output {
+    struct log_entry {
+        DebugLevel level;
+        DebugClass cl;
+        std::ostringstream text;
+    };
+    struct message {
+        const char *filename;
+        const char *line;
+        const char *funcname;
+        std::string text;
+    };
+    std::list<log_entry> log;
+    std::vector<message> messages;
+};
+
+/**
+ * While it exists, debugmsg and DebugLog on the current thread neither show nor write
+ * anything, the output goes to the given object instead. Neither the UI nor the log
+ * file may be used from threads other than the main thread.
+ */
+class capture_debug_output
+{
+    public:
+        explicit capture_debug_output( captured_debug_output &output );
+        ~capture_debug_output();
+
+        capture_debug_output( const capture_debug_output & ) = delete;
+        capture_debug_output &operator=( const capture_debug_output & ) = delete;
+
+    private:
+        captured_debug_output *previous;
+};
+
+/** Writes the captured log entries and shows the captured messages, call it on the main thread. */
+void replay_debug_output( captured_debug_output &output );
+
 /**
  * Extended debugging mode, can be toggled during game.
  * If enabled some debug message in the normal player message log are shown,
@@ -51,6 +51,7 @@
 #include "magic.h"
 #include "map.h"
 #include "map_extras.h"
+#include "mapbuffer.h"
 #include "mapgen.h"
 #include "mapgendata.h"
 #include "martialarts.h"
@@ -167,7 +168,8 @@ enum debug_menu_index {
     DEBUG_LEARN_SPELLS,
     DEBUG_LEVEL_SPELLS,
     DEBUG_TEST_MAP_EXTRA_DISTRIBUTION,
-    DEBUG_NESTED_MAPGEN
+    DEBUG_NESTED_MAPGEN,
+    DEBUG_CONVERT_MAP_FILES
 };
 
 class mission_debug
@@ -284,6 +286,7 @@ static int map_uilist()
         { uilist_entry( DEBUG_OM_EDITOR, true, 'O', _( "Overmap editor" ) ) },
         { uilist_entry( DEBUG_MAP_EXTRA, true, 'm', _( "Spawn map extra" ) ) },
         { uilist_entry( DEBUG_NESTED_MAPGEN, true, 'n', _( "Spawn nested mapgen" ) ) },
+        { uilist_entry( DEBUG_CONVERT_MAP_FILES, true, 'c', _( "Convert saved map files to the selected storage format" ) ) },
     };
 
     return uilist( _( "Map…" ), uilist_initializer );
@@ -1767,6 +1770,17 @@ void debug()
         case DEBUG_TEST_MAP_EXTRA_DISTRIBUTION:
             MapExtras::debug_spawn_test();
             break;
+        case DEBUG_CONVERT_MAP_FILES: {
+            const bool binary = get_option<bool>( "BINARY_MAP_STORAGE" );
+            const bool regions = get_option<bool>( "MAP_REGION_FILES" );
+            // Write out what's in memory first, so the files are complete.
+            MAPBUFFER.save();
+            const int converted = MAPBUFFER.convert_saved_quads( binary, regions );
+            popup( _( "Converted %d map quads to %s, stored in %s." ), converted,
+                   binary ? _( "binary format" ) : _( "JSON format" ),
+                   regions ? _( "region files" ) : _( "separate files" ) );
+            break;
+        }
     }
     catacurses::erase();
     m.invalidate_map_cache( g->get_levz() );
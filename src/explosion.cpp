@@ -149,9 +149,79 @@ static float gurney_spherical( const double charge, const double mass )
                                          -0.5 ) * TYPICAL_GURNEY_CONSTANT );
 }
 
+/**
+ * The points an explosion reaches, stored densely in the box around the center that the
+ * blast can't get out of (see @ref blast_reach).
+ */
+class blast_grid
+{
+    public:
+        struct cell {
+            float dist = 0.0f;
+            bool reached = false;
+            bool closed = false;
+        };
+
+        /** Covers the points within @p reach of @p center horizontally and within [min_z, max_z]. */
+        blast_grid( const tripoint &center, int reach, int min_z, int max_z ) :
+            min( center.x - reach, center.y - reach, min_z ),
+            size( 2 * reach + 1, 2 * reach + 1, max_z - min_z + 1 ),
+            cells( static_cast<size_t>( size.x ) * size.y * size.z ) {
+        }
+
+        bool contains( const tripoint &p ) const {
+            const tripoint rel = p - min;
+            return rel.x >= 0 && rel.y >= 0 && rel.z >= 0 &&
+                   rel.x < size.x && rel.y < size.y && rel.z < size.z;
+        }
+
+        cell &at( const tripoint &p ) {
+            const tripoint rel = p - min;
+            return cells[( static_cast<size_t>( rel.x ) * size.y + rel.y ) * size.z + rel.z];
+        }
+
+        /** Calls @p func( const tripoint &, const cell & ) for each closed cell in tripoint order. */
+        template<typename Func>
+        void for_each_closed( Func func ) const {
+            size_t index = 0;
+            for( int x = 0; x < size.x; x++ ) {
+                for( int y = 0; y < size.y; y++ ) {
+                    for( int z = 0; z < size.z; z++, index++ ) {
+                        if( cells[index].closed ) {
+                            func( min + tripoint( x, y, z ), cells[index] );
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        tripoint min;
+        tripoint size;
+        std::vector<cell> cells;
+};
+
+/**
+ * How many tiles from the center a blast can spread: the force drops to 1 at
+ * the distance where power * distance_factor ^ distance = 1, and the points one step behind
+ * that are still looked at. Each step adds at least 1 to the distance.
+ */
+static int blast_reach( const float power, const float distance_factor )
+{
+    const int max_reach = std::max( MAPSIZE_X, MAPSIZE_Y );
+    if( power <= 1.0f ) {
+        return 1;
+    }
+    if( distance_factor <= 0.0f || distance_factor >= 1.0f ) {
+        return max_reach;
+    }
+    const float reach = std::log( power ) / -std::log( distance_factor );
+    return static_cast<int>( std::min( static_cast<float>( max_reach ), reach ) ) + 1;
+}
+
 // (C1001) Compiler Internal Error on Visual Studio 2015 with Update 2
-static void do_blast( const tripoint &p, const float power,
-                      const float distance_factor, const bool fire )
+std::vector<std::pair<tripoint, float>> blast_propagation( const tripoint &p, const float power,
+                                       const float distance_factor, const bool fire )
 {
     const float tile_dist = 1.0f;
     const float diag_dist = trigdist ? M_SQRT2 * tile_dist : 1.0f * tile_dist;
@@ -165,14 +235,19 @@ static void do_blast( const tripoint &p, const float power,
     static const int z_offset[10] = { 0, 0,  0, 0,  0,  0,  0, 0, 1, -1 };
     const size_t max_index = g->m.has_zlevels() ? 10 : 8;
 
-    g->m.bash( p, fire ? power : ( 2 * power ), true, false, false );
+    // A step up or down costs at least zlev_dist + tile_dist.
+    // Nothing above or below the map's z-levels is blasted, so the grid doesn't cover that.
+    const int reach = blast_reach( power, distance_factor );
+    const int reach_z = g->m.has_zlevels() ? reach / static_cast<int>( zlev_dist + tile_dist ) + 1 : 0;
+    blast_grid grid( p, reach, std::max( p.z - reach_z, -OVERMAP_DEPTH ),
+                     std::min( p.z + reach_z, OVERMAP_HEIGHT ) );
 
+    std::vector< std::pair<float, tripoint> > open_storage;
+    open_storage.reserve( 8 * reach * reach );
     std::priority_queue< std::pair<float, tripoint>, std::vector< std::pair<float, tripoint> >, pair_greater_cmp_first >
-    open;
-    std::set<tripoint> closed;
-    std::map<tripoint, float> dist_map;
+    open( pair_greater_cmp_first(), std::move( open_storage ) );
     open.push( std::make_pair( 0.0f, p ) );
-    dist_map[p] = 0.0f;
+    grid.at( p ).reached = true;
     // Find all points to blast
     while( !open.empty() ) {
         // Add some random factor to effective distance to make it look cooler
@@ -180,11 +255,12 @@ static void do_blast( const tripoint &p, const float power,
         const tripoint pt = open.top().second;
         open.pop();
 
-        if( closed.count( pt ) != 0 ) {
+        blast_grid::cell &current = grid.at( pt );
+        if( current.closed ) {
             continue;
         }
 
-        closed.insert( pt );
+        current.closed = true;
 
         const float force = power * std::pow( distance_factor, distance );
         if( force <= 1.0f ) {
@@ -201,7 +277,8 @@ static void do_blast( const tripoint &p, const float power,
         int empty_neighbors = 0;
         for( size_t i = 0; i < 8; i++ ) {
             tripoint dest( pt + tripoint( x_offset[i], y_offset[i], z_offset[i] ) );
-            if( closed.count( dest ) == 0 && g->m.valid_move( pt, dest, false, true ) ) {
+            if( ( !grid.contains( dest ) || !grid.at( dest ).closed ) &&
+                g->m.valid_move( pt, dest, false, true ) ) {
                 empty_neighbors++;
             }
         }
@@ -210,7 +287,7 @@ static void do_blast( const tripoint &p, const float power,
         // Iterate over all neighbors. Bash all of them, propagate to some
         for( size_t i = 0; i < max_index; i++ ) {
             tripoint dest( pt + tripoint( x_offset[i], y_offset[i], z_offset[i] ) );
-            if( closed.count( dest ) != 0 || !g->m.inbounds( dest ) ) {
+            if( !g->m.inbounds( dest ) || !grid.contains( dest ) || grid.at( dest ).closed ) {
                 continue;
             }
 
@@ -241,21 +318,43 @@ static void do_blast( const tripoint &p, const float power,
                 next_dist += zlev_dist;
             }
 
-            if( dist_map.count( dest ) == 0 || dist_map[dest] > next_dist ) {
+            blast_grid::cell &next = grid.at( dest );
+            if( !next.reached || next.dist > next_dist ) {
                 open.push( std::make_pair( next_dist, dest ) );
-                dist_map[dest] = next_dist;
+                next.reached = true;
+                next.dist = next_dist;
             }
         }
     }
 
+    std::vector<std::pair<tripoint, float>> reached;
+    grid.for_each_closed( [&]( const tripoint & pt, const blast_grid::cell & c ) {
+        reached.emplace_back( pt, c.dist );
+    } );
+    return reached;
+}
+
+static void do_blast( const tripoint &p, const float power,
+                      const float distance_factor, const bool fire )
+{
+    g->m.bash( p, fire ? power : ( 2 * power ), true, false, false );
+
+    // The force at each blasted point, computed once for drawing and for the damage.
+    std::vector<std::pair<tripoint, float>> blasted = blast_propagation( p, power, distance_factor,
+                                         fire );
+    for( std::pair<tripoint, float> &blast : blasted ) {
+        blast.second = power * std::pow( distance_factor, blast.second );
+    }
+
     // Draw the explosion
     std::map<tripoint, nc_color> explosion_colors;
-    for( auto &pt : closed ) {
+    for( const std::pair<tripoint, float> &blast : blasted ) {
+        const tripoint &pt = blast.first;
         if( g->m.impassable( pt ) ) {
             continue;
         }
 
-        const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+        const float force = blast.second;
         nc_color col = c_red;
         if( force < 10 ) {
             col = c_white;
@@ -268,8 +367,9 @@ static void do_blast( const tripoint &p, const float power,
 
     draw_custom_explosion( g->u.pos(), explosion_colors );
 
-    for( const tripoint &pt : closed ) {
-        const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+    for( const std::pair<tripoint, float> &blast : blasted ) {
+        const tripoint &pt = blast.first;
+        const float force = blast.second;
         if( force < 1.0f ) {
             // Too weak to matter
             continue;
@@ -4,6 +4,8 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 using itype_id = std::string;
 
@@ -64,6 +66,13 @@ void explosion(
 
 void explosion( const tripoint &p, const explosion_data &ex );
 
+/**
+ * Spreads the blast of an explosion at p through the map, bashing what it passes, and returns
+ * every point it reached with its distance from p, in tripoint order. The distance includes
+ * the random factor of the spreading. Does not bash p itself or deal any damage.
+ */
+std::vector<std::pair<tripoint, float>> blast_propagation( const tripoint &p, float power,
+                                       float distance_factor, bool fire );
 /** Triggers a flashbang explosion at p. */
 void flashbang( const tripoint &p, bool player_immune = false );
 /** Triggers a resonance cascade at p. */
@@ -39,6 +39,7 @@
 #include "auto_pickup.h"
 #include "avatar.h"
 #include "avatar_action.h"
+#include "background_save.h"
 #include "basecamp.h"
 #include "bionics.h"
 #include "bodypart.h"
@@ -299,7 +300,11 @@ game::game() :
     // The reason for this move is so that g is not uninitialized when it gets to installing the parts into vehicles.
 }
 
-game::~game() = default;
+game::~game()
+{
+    // Background overmap generation reads the game state.
+    overmap_buffer.cancel_pregeneration();
+}
 
 // Load everything that will not depend on any mods
 void game::load_static_data()
@@ -1035,8 +1040,18 @@ void game::create_starting_npcs()
                           tmp->getID() ) );
 }
 
+static void report_background_save_errors()
+{
+    for( const std::string &err : background_save::take_errors() ) {
+        popup( _( "Failed to save the game in the background: %s" ), err );
+    }
+}
+
 bool game::cleanup_at_end()
 {
+    // Don't leave the game (and possibly delete the world) while autosaves are still written.
+    background_save::wait_for_all();
+    report_background_save_errors();
     if( uquit == QUIT_DIED || uquit == QUIT_SUICIDE ) {
         // Put (non-hallucinations) into the overmap so they are not lost.
         for( monster &critter : all_monsters() ) {
@@ -1488,8 +1503,10 @@ bool game::do_turn()
     u.update_body();
 
     // Auto-save if autosave is enabled
-    if( get_option<bool>( "AUTOSAVE" ) &&
-        calendar::once_every( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
+    static const option_ref<bool> autosave_enabled( "AUTOSAVE" );
+    static const option_ref<int> autosave_turns( "AUTOSAVE_TURNS" );
+    if( autosave_enabled.get() &&
+        calendar::once_every( 1_turns * autosave_turns.get() ) &&
         !u.is_dead_state() ) {
         autosave();
     }
@@ -1621,7 +1638,8 @@ bool game::do_turn()
     update_stair_monsters();
     mon_info_update();
     u.process_turn();
-    if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
+    static const option_ref<bool> force_redraw( "FORCE_REDRAW" );
+    if( u.moves < 0 && force_redraw.get() ) {
         ui_manager::redraw();
         refresh_display();
     }
@@ -2764,6 +2782,9 @@ void game::load( const save_t &name )
     const std::string worldpath = get_world_base_save_path() + "/";
     const std::string playerpath = worldpath + name.base_path();
 
+    // The followers it knows are the ones of the game that is left.
+    *npc_loot_scan_ptr = npc_loot_scan();
+
     // Now load up the master game data; factions (and more?)
     load_master();
     u = avatar();
@@ -2965,8 +2986,7 @@ bool game::save_maps()
     try {
         m.save();
         overmap_buffer.save(); // can throw
-        MAPBUFFER.save(); // can throw
-        return true;
+        return MAPBUFFER.save();
     } catch( const std::exception &err ) {
         popup( _( "Failed to save the maps: %s" ), err.what() );
         return false;
@@ -3023,6 +3043,11 @@ spell_events &game::spell_events_subscriber()
     return *spell_events_ptr;
 }
 
+npc_loot_scan &game::loot_scan()
+{
+    return *npc_loot_scan_ptr;
+}
+
 bool game::save()
 {
     try {
@@ -4002,8 +4027,12 @@ void game::mon_info( const catacurses::window &w, int hor_padding )
 
 void game::mon_info_update( )
 {
+    static const option_ref<int> safe_mode_proximity( "SAFEMODEPROXIMITY" );
+    static const option_ref<int> safe_mode_ignore_turns( "SAFEMODEIGNORETURNS" );
+    static const option_ref<bool> autosafemode( "AUTOSAFEMODE" );
+    static const option_ref<int> autosafemode_turns( "AUTOSAFEMODETURNS" );
     int newseen = 0;
-    const int safe_proxy_dist = get_option<int>( "SAFEMODEPROXIMITY" );
+    const int safe_proxy_dist = safe_mode_proximity.get();
     const int iProxyDist = ( safe_proxy_dist <= 0 ) ? MAX_VIEW_DISTANCE :
                            safe_proxy_dist;
 
@@ -4030,7 +4059,7 @@ void game::mon_info_update( )
     static int previous_turn = 0;
     // TODO: change current_turn to time_point
     const int current_turn = to_turns<int>( calendar::turn - calendar::turn_zero );
-    const int sm_ignored_turns = get_option<int>( "SAFEMODEIGNORETURNS" );
+    const int sm_ignored_turns = safe_mode_ignore_turns.get();
 
     for( Creature *c : u.get_visible_creatures( MAPSIZE_X ) ) {
         monster *m = dynamic_cast<monster *>( c );
@@ -4178,10 +4207,10 @@ void game::mon_info_update( )
         if( safe_mode == SAFE_MODE_ON ) {
             set_safe_mode( SAFE_MODE_STOP );
         }
-    } else if( current_turn > previous_turn && get_option<bool>( "AUTOSAFEMODE" ) &&
+    } else if( current_turn > previous_turn && autosafemode.get() &&
                newseen == 0 ) { // Auto-safe mode, but only if it's a new turn
         turnssincelastmon += current_turn - previous_turn;
-        if( turnssincelastmon >= get_option<int>( "AUTOSAFEMODETURNS" ) && safe_mode == SAFE_MODE_OFF ) {
+        if( turnssincelastmon >= autosafemode_turns.get() && safe_mode == SAFE_MODE_OFF ) {
             set_safe_mode( SAFE_MODE_ON );
             add_msg( m_info, _( "Safe mode ON!" ) );
         }
@@ -10817,6 +10846,12 @@ point game::update_map( int &x, int &y )
     // This call will generate new monsters in addition to loading, so it's placed after NPC loading
     m.spawn_monsters( false ); // Static monsters
 
+    // Prepare the overmaps the player is heading to before they are needed
+    static const option_ref<bool> background_overmap_generation( "BACKGROUND_OVERMAP_GENERATION" );
+    if( background_overmap_generation.get() ) {
+        overmap_buffer.pregenerate_around( omt_to_om_copy( u.global_omt_location().xy() ) );
+    }
+
     // Update what parts of the world map we can see
     update_overmap_seen();
 
@@ -11323,6 +11358,8 @@ void game::quicksave()
     if( !moves_since_last_save ) {
         return;
     }
+    background_save::wait_for_all();
+    report_background_save_errors();
     add_msg( m_info, _( "Saving game, this may take a while" ) );
 
     static_popup popup;
@@ -11368,7 +11405,31 @@ void game::autosave()
     if( time( nullptr ) < last_save_timestamp + 60 * get_option<int>( "AUTOSAVE_MINUTES" ) ) {
         return;
     }
-    quicksave();    //Driving checks are handled by quicksave()
+    if( get_option<bool>( "AUTOSAVE_BACKGROUND" ) ) {
+        background_autosave();
+    } else {
+        quicksave();    //Driving checks are handled by quicksave()
+    }
+}
+
+void game::background_autosave()
+{
+    if( !moves_since_last_save ) {
+        return;
+    }
+    report_background_save_errors();
+    // Don't pile up snapshots if the disk can't keep up, try again next turn.
+    if( background_save::busy() ) {
+        return;
+    }
+    const time_t now = time( nullptr );
+    {
+        // Only serializes the game into memory, the files are written by the background thread.
+        background_save::deferred_writes deferred;
+        save();
+    }
+    moves_since_last_save = 0;
+    last_save_timestamp = now;
 }
 
 void game::process_artifact( item &it, player &p )
@@ -12035,6 +12096,11 @@ game::monster_range game::all_monsters()
     return monster_range( *this );
 }
 
+std::vector<shared_ptr_fast<monster>> game::monsters_within( const tripoint &p, const int radius )
+{
+    return critter_tracker->monsters_within( p, radius );
+}
+
 game::npc_range game::all_npcs()
 {
     return npc_range( *this );
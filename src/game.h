@@ -105,6 +105,7 @@ class map;
 class map_item_stack;
 class memorial_logger;
 class npc;
+struct npc_loot_scan;
 class player;
 class save_t;
 class scenario;
@@ -425,6 +426,12 @@ class game
         monster_range all_monsters();
         /// Same as @ref all_creatures but iterators only over npcs.
         npc_range all_npcs();
+        /**
+         * Returns the living monsters within @p radius of @p p, see
+         * @ref Creature_tracker::monsters_within. Prefer this over filtering
+         * @ref all_monsters by distance.
+         */
+        std::vector<shared_ptr_fast<monster>> monsters_within( const tripoint &p, int radius );
 
         /**
          * Returns all creatures matching a predicate. Only living ( not dead ) creatures
@@ -888,6 +895,7 @@ class game
 
         //  int autosave_timeout();  // If autosave enabled, how long we should wait for user inaction before saving.
         void autosave();         // automatic quicksaves - Performs some checks before calling quicksave()
+        void background_autosave(); // Autosave that writes the files on a background thread
     public:
         void quicksave();        // Saves the game without quitting
         void disp_NPCs();        // Currently for debug use.  Lists global NPCs.
@@ -941,6 +949,7 @@ class game
         pimpl<kill_tracker> kill_tracker_ptr;
         pimpl<memorial_logger> memorial_logger_ptr;
         pimpl<spell_events> spell_events_ptr;
+        pimpl<npc_loot_scan> npc_loot_scan_ptr;
 
     public:
         /** Make map a reference here, to avoid map.h in game.h */
@@ -953,6 +962,7 @@ class game
         stats_tracker &stats();
         memorial_logger &memorial();
         spell_events &spell_events_subscriber();
+        npc_loot_scan &loot_scan();
 
         pimpl<Creature_tracker> critter_tracker;
         pimpl<faction_manager> faction_manager_ptr;
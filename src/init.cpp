@@ -1,6 +1,8 @@
 #include "init.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <exception>
 #include <fstream>
@@ -82,6 +84,7 @@
 #include "start_location.h"
 #include "string_formatter.h"
 #include "text_snippets.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "trap.h"
 #include "type_id.h"
@@ -90,6 +93,27 @@
 #include "vitamin.h"
 #include "worldfactory.h"
 
+bool DynamicDataLoader::log_timings = false;
+
+using load_clock = std::chrono::steady_clock;
+
+static void log_timing( const std::string &what, const load_clock::time_point &start )
+{
+    if( !DynamicDataLoader::log_timings ) {
+        return;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>
+                         ( load_clock::now() - start );
+    DebugLog( D_INFO, D_MAIN ) << "Loading timings: " << what << ": " << elapsed.count() << " ms";
+}
+
+static std::string read_whole_file( const std::string &path )
+{
+    std::ifstream infile( path.c_str(), std::ifstream::in | std::ifstream::binary );
+    return std::string( ( std::istreambuf_iterator<char>( infile ) ),
+                        std::istreambuf_iterator<char>() );
+}
+
 DynamicDataLoader::DynamicDataLoader()
 {
     initialize();
@@ -426,26 +450,31 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
-    // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        std::ifstream infile( file.c_str(), std::ifstream::in | std::ifstream::binary );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
-        try {
-            // parse it
-            JsonIn jsin( iss );
-            load_all_from_json( jsin, src, ui, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( file + ": " + err.what() );
+    const load_clock::time_point start = load_clock::now();
+    // The files are read on the thread pool, a batch at a time, but the objects are
+    // loaded here in the order of the files, as later files may refer to earlier ones.
+    thread_pool &pool = get_thread_pool();
+    const size_t batch_size = 4 * pool.concurrency();
+    std::vector<std::string> contents;
+    for( size_t first = 0; first < files.size(); first += batch_size ) {
+        const size_t count = std::min( batch_size, files.size() - first );
+        contents.assign( count, std::string() );
+        pool.run( count, [&]( const size_t i ) {
+            contents[i] = read_whole_file( files[first + i] );
+        } );
+        for( size_t i = 0; i < count; i++ ) {
+            const std::string &file = files[first + i];
+            std::istringstream iss( contents[i] );
+            try {
+                // parse it
+                JsonIn jsin( iss );
+                load_all_from_json( jsin, src, ui, path, file );
+            } catch( const JsonError &err ) {
+                throw std::runtime_error( file + ": " + err.what() );
+            }
         }
     }
+    log_timing( "loading " + path, start );
 }
 
 void DynamicDataLoader::load_all_from_json( JsonIn &jsin, const std::string &src, loading_ui &,
@@ -629,7 +658,9 @@ void DynamicDataLoader::finalize_loaded_data( loading_ui &ui )
 
     ui.show();
     for( const named_entry &e : entries ) {
+        const load_clock::time_point start = load_clock::now();
         e.second();
+        log_timing( "finalizing " + e.first, start );
         ui.proceed();
     }
 
@@ -642,19 +673,33 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
     ui.new_context( _( "Verifying" ) );
 
     using named_entry = std::pair<std::string, std::function<void()>>;
-    const std::vector<named_entry> entries = {{
+    // These only read the loaded data, so they run at the same time on the thread pool.
+    const std::vector<named_entry> independent_entries = {{
             { _( "Flags" ), &json_flag::check_consistency },
+            { _( "Vitamins" ), &vitamin::check_consistency },
+            { _( "Activities" ), &activity_type::check_consistency },
+            { _( "Engine faults" ), &fault::check_consistency },
+            { _( "Overmap land use codes" ), &overmap_land_use_codes::check_consistency },
+            { _( "Overmap connections" ), &overmap_connections::check_consistency },
+            { _( "Overmap terrain" ), &overmap_terrains::check_consistency },
+            { _( "Overmap locations" ), &overmap_locations::check_consistency },
+            { _( "Overmap specials" ), &overmap_specials::check_consistency },
+            { _( "Ammunition types" ), &ammunition_type::check_consistency },
+            { _( "Harvest lists" ), &harvest_list::check_consistency },
+            { _( "Scent types" ), &scent_type::check_scent_consistency },
+            { _( "Disease types" ), &disease_type::check_disease_consistency },
+        }
+    };
+    const std::vector<named_entry> entries = {{
             {
                 _( "Crafting requirements" ), []()
                 {
                     requirement_data::check_consistency();
                 }
             },
-            { _( "Vitamins" ), &vitamin::check_consistency },
             { _( "Field types" ), &field_types::check_consistency },
             { _( "Ammo effects" ), &ammo_effects::check_consistency },
             { _( "Emissions" ), &emit::check_consistency },
-            { _( "Activities" ), &activity_type::check_consistency },
             {
                 _( "Items" ), []()
                 {
@@ -662,7 +707,6 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
                 }
             },
             { _( "Materials" ), &materials::check },
-            { _( "Engine faults" ), &fault::check_consistency },
             { _( "Vehicle parts" ), &vpart_info::check },
             { _( "Mapgen definitions" ), &check_mapgen_definitions },
             {
@@ -679,14 +723,8 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
             { _( "Martial arts" ), &check_martialarts },
             { _( "Mutations" ), &mutation_branch::check_consistency },
             { _( "Mutation Categories" ), &mutation_category_trait::check_consistency },
-            { _( "Overmap land use codes" ), &overmap_land_use_codes::check_consistency },
-            { _( "Overmap connections" ), &overmap_connections::check_consistency },
-            { _( "Overmap terrain" ), &overmap_terrains::check_consistency },
-            { _( "Overmap locations" ), &overmap_locations::check_consistency },
-            { _( "Overmap specials" ), &overmap_specials::check_consistency },
             { _( "Map extras" ), &MapExtras::check_consistency },
             { _( "Start locations" ), &start_locations::check_consistency },
-            { _( "Ammunition types" ), &ammunition_type::check_consistency },
             { _( "Traps" ), &trap::check_consistency },
             { _( "Bionics" ), &check_bionics },
             { _( "Gates" ), &gates::check },
@@ -699,28 +737,42 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
                     item_action_generator::generator().check_consistency();
                 }
             },
-            { _( "Harvest lists" ), &harvest_list::check_consistency },
             { _( "NPC templates" ), &npc_template::check_consistency },
             { _( "Body parts" ), &body_part_type::check_consistency },
             { _( "Anatomies" ), &anatomy::check_consistency },
             { _( "Spells" ), &spell_type::check_consistency },
             { _( "Transformations" ), &event_transformation::check_consistency },
             { _( "Statistics" ), &event_statistic::check_consistency },
-            { _( "Scent types" ), &scent_type::check_scent_consistency },
             { _( "Scores" ), &score::check_consistency },
             { _( "Achivements" ), &achievement::check_consistency },
-            { _( "Disease types" ), &disease_type::check_disease_consistency },
             { _( "Factions" ), &faction_template::check_consistency },
         }
     };
 
+    for( const named_entry &e : independent_entries ) {
+        ui.add_entry( e.first );
+    }
     for( const named_entry &e : entries ) {
         ui.add_entry( e.first );
     }
 
     ui.show();
+    // Their messages are shown afterwards, in the order of the list.
+    std::vector<captured_debug_output> outputs( independent_entries.size() );
+    get_thread_pool().run( independent_entries.size(), [&]( const size_t i ) {
+        capture_debug_output capture( outputs[i] );
+        const load_clock::time_point start = load_clock::now();
+        independent_entries[i].second();
+        log_timing( "verifying " + independent_entries[i].first, start );
+    } );
+    for( captured_debug_output &output : outputs ) {
+        replay_debug_output( output );
+        ui.proceed();
+    }
     for( const named_entry &e : entries ) {
+        const load_clock::time_point start = load_clock::now();
         e.second();
+        log_timing( "verifying " + e.first, start );
         ui.proceed();
     }
     catacurses::erase();
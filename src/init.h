@@ -113,6 +113,9 @@ class DynamicDataLoader
         void check_consistency( loading_ui &ui );
 
     public:
+        /** Log how long loading each path and each finalization step takes to debug.log. */
+        static bool log_timings;
+
         /**
          * Returns the single instance of this class.
          */
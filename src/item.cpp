@@ -243,6 +243,10 @@ static const std::string flag_WIND_EXTINGUISH( "WIND_EXTINGUISH" );
 
 static const matec_id rapid_strike( "RAPID" );
 
+static const option_ref<bool> option_ammo_in_names( "AMMO_IN_NAMES" );
+static const option_ref<bool> option_item_health_bar( "ITEM_HEALTH_BAR" );
+static const option_ref<bool> option_fast_forward_item_rot( "FAST_FORWARD_ITEM_ROT" );
+
 class npc_class;
 
 using npc_class_id = string_id<npc_class>;
@@ -4197,10 +4201,10 @@ std::string item::tname( unsigned int quantity, bool with_prefix, unsigned int t
     // for portions of string that have <color_ etc in them, this aims to truncate the whole string correctly
     unsigned int truncate_override = 0;
 
-    if( ( damage() != 0 || ( get_option<bool>( "ITEM_HEALTH_BAR" ) && is_armor() ) ) && !is_null() &&
+    if( ( damage() != 0 || ( option_item_health_bar.get() && is_armor() ) ) && !is_null() &&
         with_prefix ) {
         damtext = durability_indicator();
-        if( get_option<bool>( "ITEM_HEALTH_BAR" ) ) {
+        if( option_item_health_bar.get() ) {
             // get the utf8 width of the tags
             truncate_override = utf8_width( damtext, false ) - utf8_width( damtext, true );
         }
@@ -4481,7 +4485,7 @@ std::string item::display_name( unsigned int quantity ) const
     }
 
     std::string ammotext;
-    if( ( ( is_gun() && ammo_required() ) || is_magazine() ) && get_option<bool>( "AMMO_IN_NAMES" ) ) {
+    if( ( ( is_gun() && ammo_required() ) || is_magazine() ) && option_ammo_in_names.get() ) {
         if( ammo_current() != "null" ) {
             ammotext = find_type( ammo_current() )->ammo->type->name();
         } else {
@@ -5865,7 +5869,7 @@ std::string item::durability_indicator( bool include_intact ) const
     std::string outputstring;
 
     if( damage() < 0 )  {
-        if( get_option<bool>( "ITEM_HEALTH_BAR" ) ) {
+        if( option_item_health_bar.get() ) {
             outputstring = colorize( damage_symbol() + "\u00A0", damage_color() );
         } else if( is_gun() ) {
             outputstring = pgettext( "damage adjective", "accurized " );
@@ -5889,7 +5893,7 @@ std::string item::durability_indicator( bool include_intact ) const
                     break;
             }
         }
-    } else if( get_option<bool>( "ITEM_HEALTH_BAR" ) ) {
+    } else if( option_item_health_bar.get() ) {
         outputstring = colorize( damage_symbol() + "\u00A0", damage_color() );
     } else {
         outputstring = string_format( "%s ", get_base_material().dmg_adj( damage_level( 4 ) ) );
@@ -8723,16 +8727,14 @@ void item::process_temperature_rot( float insulation, const tripoint &pos,
             local_mod += 5; // body heat increases inventory temperature
         }
 
-        // Process the past of this item since the last time it was processed
-        while( now - time > 1_hours ) {
-            // Get the environment temperature
-            time_duration time_delta = std::min( 1_hours, now - 1_hours - time );
-            time += time_delta;
-
+        const bool fast_forward = option_fast_forward_item_rot.get();
+        const auto env_temperature_at = [&]( const time_point & t ) {
             //Use weather if above ground, use map temp if below
             double env_temperature = 0;
             if( pos.z >= 0 ) {
-                double weather_temperature = wgen.get_weather_temperature( pos, time, seed );
+                const double weather_temperature = fast_forward ?
+                                                   wgen.get_hourly_weather_temperature( pos, t, seed ) :
+                                                   wgen.get_weather_temperature( pos, t, seed );
                 env_temperature = weather_temperature + enviroment_mod + local_mod;
             } else {
                 env_temperature = AVERAGE_ANNUAL_TEMPERATURE + enviroment_mod + local_mod;
@@ -8757,6 +8759,21 @@ void item::process_temperature_rot( float insulation, const tripoint &pos,
                 default:
                     debugmsg( "Temperature flag enum not valid.  Using normal temperature." );
             }
+            return env_temperature;
+        };
+
+        if( fast_forward && !fast_forward_rot( time, env_temperature_at ) ) {
+            // No need to track item that will be gone
+            return;
+        }
+
+        // Process the past of this item since the last time it was processed
+        while( now - time > 1_hours ) {
+            // Get the environment temperature
+            time_duration time_delta = std::min( 1_hours, now - 1_hours - time );
+            time += time_delta;
+
+            const double env_temperature = env_temperature_at( time );
 
             // Calculate item temperature from environment temperature
             // If the time was more than 2 d ago just set the item to environment temperature
@@ -8796,6 +8813,78 @@ void item::process_temperature_rot( float insulation, const tripoint &pos,
     }
 }
 
+bool item::fast_forward_rot( time_point &time,
+                             const std::function<double( const time_point & )> &env_temperature_at )
+{
+    const time_point now = calendar::turn;
+    const time_duration smallest_interval = 10_minutes;
+    // The same steps as in process_temperature_rot, the ones that end more than two days ago.
+    const auto far_past = [&]() {
+        return now - ( time + 1_hours ) > 2_days;
+    };
+    if( !far_past() ) {
+        return true;
+    }
+
+    // The same step length as in process_temperature_rot, which is a whole hour this far back.
+    const auto step = [&]() {
+        time += std::min( 1_hours, now - 1_hours - time );
+    };
+
+    if( !goes_bad() ) {
+        // Only the temperature at the last step matters.
+        while( far_past() ) {
+            step();
+        }
+        temperature = static_cast<int>( 100000 * temp_to_kelvin( env_temperature_at( time ) ) );
+        last_temp_check = time;
+        return true;
+    }
+
+    // The same as in calc_rot.
+    const bool frozen = item_tags.count( "FROZEN" );
+    const bool cold = item_tags.count( "COLD" );
+    float factor = 1.0;
+    if( is_corpse() && has_flag( flag_FIELD_DRESS ) ) {
+        factor = 0.75;
+    }
+    if( item_tags.count( "MUSHY" ) ) {
+        factor = 3.0;
+    }
+
+    while( far_past() ) {
+        step();
+        const double env_temperature = env_temperature_at( time );
+        temperature = static_cast<int>( 100000 * temp_to_kelvin( env_temperature ) );
+        last_temp_check = time;
+
+        if( time - last_rot_check <= smallest_interval ) {
+            continue;
+        }
+        if( frozen || ( !is_corpse() && get_relative_rot() > 2.0 ) ) {
+            last_rot_check = time;
+            continue;
+        }
+        int temp = env_temperature;
+        if( cold ) {
+            temp = std::min( temperatures::fridge, temp );
+        }
+        if( last_rot_check <= calendar::start_of_cataclysm ) {
+            time_duration spoil_variation = get_shelf_life() * 0.2f;
+            rot += rng( -spoil_variation, spoil_variation );
+        }
+        // last_rot_check need not be on the hourly grid of the steps, so weight like calc_rot.
+        const time_duration time_delta = time - last_rot_check;
+        rot += factor * time_delta / 1_hours * get_hourly_rotpoints_at_temp( temp ) * 1_turns;
+        last_rot_check = time;
+
+        if( has_rotten_away() || ( is_corpse() && rot > 10_days ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void item::calc_temp( const int temp, const float insulation, const time_point &time )
 {
     // Limit calculations to max 4000 C (4273.15 K) to avoid specific energy from overflowing
@@ -2089,6 +2089,17 @@ class item : public visitable<item>
          */
         void calc_temp( int temp, float insulation, const time_point &time );
 
+        /**
+         * Adds up the rot of the hours that are more than two days in the past. The item just
+         * follows the environment temperature in that time and its tags don't change, so
+         * everything except the temperature is looked up only once.
+         * @param time Where the stepping is, advanced by this function
+         * @param env_temperature_at The environment temperature at a given time
+         * @return false if the item has rotten away
+         */
+        bool fast_forward_rot( time_point &time,
+                               const std::function<double( const time_point & )> &env_temperature_at );
+
         /**
          * Get the thermal energy of the item in Joules.
          */
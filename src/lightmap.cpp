@@ -1,6 +1,8 @@
 #include "lightmap.h" // IWYU pragma: associated
 #include "shadowcasting.h" // IWYU pragma: associated
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
@@ -27,10 +29,12 @@
 #include "mtype.h"
 #include "npc.h"
 #include "optional.h"
+#include "options.h"
 #include "player.h"
 #include "point.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "type_id.h"
 #include "veh_type.h"
@@ -44,6 +48,47 @@ static const bionic_id bio_night( "bio_night" );
 static const efftype_id effect_haslight( "haslight" );
 static const efftype_id effect_onfire( "onfire" );
 
+static const option_ref<bool> parallel_shadowcasting( "PARALLEL_SHADOWCASTING" );
+static const option_ref<bool> incremental_lightmap( "INCREMENTAL_LIGHTMAP" );
+
+/**
+ * Parallel shadowcasting: the octants (or light sources) are split into tasks that run on
+ * the thread pool. Each task but the first writes into its own copy of the output, which
+ * are merged into the output afterwards. All shadowcasting outputs are only ever updated
+ * with max(), so the merged result is identical to the serial one, whatever the order.
+ */
+static size_t shadowcasting_tasks( const size_t max_tasks )
+{
+    if( !parallel_shadowcasting.get() ) {
+        return 1;
+    }
+    return std::min( max_tasks, get_thread_pool().concurrency() );
+}
+
+using float_grid = float[MAPSIZE_X][MAPSIZE_Y];
+using quadrant_grid = four_quadrants[MAPSIZE_X][MAPSIZE_Y];
+
+// Wrapped in a struct, so they can be stored in a vector.
+template<typename T>
+struct grid_buffer {
+    T cells[MAPSIZE_X][MAPSIZE_Y];
+};
+
+static float elementwise_max( const float l, const float r )
+{
+    return std::max( l, r );
+}
+
+template<typename T>
+static void merge_max( T( &output )[MAPSIZE_X][MAPSIZE_Y], const T( &input )[MAPSIZE_X][MAPSIZE_Y] )
+{
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            output[x][y] = elementwise_max( output[x][y], input[x][y] );
+        }
+    }
+}
+
 #define LIGHTMAP_CACHE_X MAPSIZE_X
 #define LIGHTMAP_CACHE_Y MAPSIZE_Y
 
@@ -83,22 +128,28 @@ bool map::build_transparency_cache( const int zlev )
     auto &transparency_cache = map_cache.transparency_cache;
     auto &outside_cache = map_cache.outside_cache;
 
-    if( !map_cache.transparency_cache_dirty ) {
+    if( map_cache.transparency_cache_dirty.none() ) {
         return false;
     }
 
-    // Default to just barely not transparent.
-    std::uninitialized_fill_n(
-        &transparency_cache[0][0], MAPSIZE_X * MAPSIZE_Y,
-        static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR ) );
-
     const float sight_penalty = weather::sight_penalty( g->weather.weather );
 
-    // Traverse the submaps in order
+    // Traverse the submaps in order, skipping those that didn't change
+    int rebuilt = 0;
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            if( !map_cache.transparency_cache_dirty[smx + smy * MAPSIZE] ) {
+                continue;
+            }
+            rebuilt++;
             const auto cur_submap = get_submap_at_grid( {smx, smy, zlev} );
 
+            // Default to just barely not transparent.
+            for( int sx = 0; sx < SEEX; ++sx ) {
+                std::uninitialized_fill_n( &transparency_cache[sx + smx * SEEX][smy * SEEY], SEEY,
+                                           static_cast<float>( LIGHT_TRANSPARENCY_OPEN_AIR ) );
+            }
+
             float zero_value = LIGHT_TRANSPARENCY_OPEN_AIR;
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
@@ -144,8 +195,9 @@ bool map::build_transparency_cache( const int zlev )
             }
         }
     }
-    map_cache.transparency_cache_dirty = false;
-    return true;
+    map_cache.transparency_cache_dirty.reset();
+    cache_rebuilds_this_turn().transparency += rebuilt;
+    return rebuilt > 0;
 }
 
 bool map::build_vision_transparency_cache( const int zlev )
@@ -174,7 +226,7 @@ bool map::build_vision_transparency_cache( const int zlev )
         } else if( is_crouching && coverage( loc ) >= 30 ) {
             // If we're crouching behind an obstacle, we can't see past it.
             vision_transparency_cache[loc.x][loc.y] = LIGHT_TRANSPARENCY_SOLID;
-            map_cache.transparency_cache_dirty = true;
+            set_transparency_cache_dirty( loc );
             dirty = true;
         }
     }
@@ -477,10 +529,19 @@ void map::generate_lightmap( const int zlev )
     */
     const tripoint cache_start( 0, 0, zlev );
     const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
-    for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
-        if( light_source_buffer[p.x][p.y] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x][p.y] );
+    if( incremental_lightmap.get() ) {
+        // The light of the bulk sources is kept between turns, everything else is cheap.
+        update_buffered_lights( zlev );
+        merge_max( lm, buffered_lights->lm );
+        merge_max( sm, buffered_lights->sm );
+    } else {
+        std::vector<tripoint> buffered_sources;
+        for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
+            if( light_source_buffer[p.x][p.y] > 0.0 ) {
+                buffered_sources.push_back( p );
+            }
         }
+        apply_buffered_light_sources( buffered_sources, lm, sm );
     }
 
     if( g->u.has_active_bionic( bio_night ) ) {
@@ -1125,6 +1186,96 @@ castLightAll<fragment_cloud, fragment_cloud, shrapnel_calc, shrapnel_check,
     const fragment_cloud( &input_array )[MAPSIZE_X][MAPSIZE_Y],
     const point &offset, int offsetDistance, fragment_cloud numerator );
 
+template<int xx, int xy, int yx, int yy>
+static void cast_sight_octant( float_grid &output, const float_grid &input, const point &origin )
+{
+    castLight<xx, xy, yx, yy, float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+        output, input, origin, 0 );
+}
+
+// Same as castLightAll for the seen cache, but split into num_tasks tasks.
+static void cast_sight_parallel( float_grid &output, const float_grid &input, const point &origin,
+                                 const size_t num_tasks )
+{
+    using octant_function = void( * )( float_grid &, const float_grid &, const point & );
+    static const std::array<octant_function, 8> octants = {{
+            cast_sight_octant<0, 1, 1, 0>, cast_sight_octant<1, 0, 0, 1>,
+            cast_sight_octant < 0, -1, 1, 0 >, cast_sight_octant < -1, 0, 0, 1 >,
+            cast_sight_octant < 0, 1, -1, 0 >, cast_sight_octant < 1, 0, 0, -1 >,
+            cast_sight_octant < 0, -1, -1, 0 >, cast_sight_octant < -1, 0, 0, -1 >
+        }
+    };
+    std::vector<grid_buffer<float>> buffers( num_tasks - 1 );
+    for( grid_buffer<float> &buffer : buffers ) {
+        std::memcpy( buffer.cells, output, sizeof( output ) );
+    }
+    get_thread_pool().run( num_tasks, [&]( const size_t task ) {
+        float_grid &target = task == 0 ? output : buffers[task - 1].cells;
+        for( size_t i = task; i < octants.size(); i += num_tasks ) {
+            octants[i]( target, input, origin );
+        }
+    } );
+    for( const grid_buffer<float> &buffer : buffers ) {
+        merge_max( output, buffer.cells );
+    }
+}
+
+template<int xx, int xy, int xz, int yx, int yy, int yz, int zz>
+static void cast_sight_segment( const array_of_grids_of<float> &output_caches,
+                                const array_of_grids_of<const float> &input_arrays,
+                                const array_of_grids_of<const bool> &floor_caches,
+                                const tripoint &origin )
+{
+    cast_zlight_segment<xx, xy, xz, yx, yy, yz, zz, float, sight_calc, sight_check, accumulate_transparency>(
+        output_caches, input_arrays, floor_caches, origin, 0, 1.0f );
+}
+
+// Same as cast_zlight for the seen caches, but split into num_tasks tasks.
+static void cast_zsight_parallel( const array_of_grids_of<float> &output_caches,
+                                  const array_of_grids_of<const float> &input_arrays,
+                                  const array_of_grids_of<const bool> &floor_caches,
+                                  const tripoint &origin, const size_t num_tasks )
+{
+    using segment_function = void( * )( const array_of_grids_of<float> &,
+                                        const array_of_grids_of<const float> &,
+                                        const array_of_grids_of<const bool> &, const tripoint & );
+    static const std::array<segment_function, 16> segments = {{
+            cast_sight_segment < 0, 1, 0, 1, 0, 0, -1 >, cast_sight_segment < 1, 0, 0, 0, 1, 0, -1 >,
+            cast_sight_segment < 0, -1, 0, 1, 0, 0, -1 >, cast_sight_segment < -1, 0, 0, 0, 1, 0, -1 >,
+            cast_sight_segment < 0, 1, 0, -1, 0, 0, -1 >, cast_sight_segment < 1, 0, 0, 0, -1, 0, -1 >,
+            cast_sight_segment < 0, -1, 0, -1, 0, 0, -1 >, cast_sight_segment < -1, 0, 0, 0, -1, 0, -1 >,
+            cast_sight_segment<0, 1, 0, 1, 0, 0, 1>, cast_sight_segment<1, 0, 0, 0, 1, 0, 1>,
+            cast_sight_segment < 0, -1, 0, 1, 0, 0, 1 >, cast_sight_segment < -1, 0, 0, 0, 1, 0, 1 >,
+            cast_sight_segment < 0, 1, 0, -1, 0, 0, 1 >, cast_sight_segment < 1, 0, 0, 0, -1, 0, 1 >,
+            cast_sight_segment < 0, -1, 0, -1, 0, 0, 1 >, cast_sight_segment < -1, 0, 0, 0, -1, 0, 1 >
+        }
+    };
+    // The segments only reach fov_3d_z_range levels up and down, only those need copies.
+    const int min_z = std::max( origin.z - fov_3d_z_range, -OVERMAP_DEPTH ) + OVERMAP_DEPTH;
+    const int max_z = std::min( origin.z + fov_3d_z_range, OVERMAP_HEIGHT ) + OVERMAP_DEPTH;
+    const size_t num_levels = max_z - min_z + 1;
+
+    std::vector<grid_buffer<float>> buffers( ( num_tasks - 1 ) * num_levels );
+    std::vector<array_of_grids_of<float>> task_caches( num_tasks, output_caches );
+    for( size_t task = 1; task < num_tasks; task++ ) {
+        for( size_t level = 0; level < num_levels; level++ ) {
+            grid_buffer<float> &buffer = buffers[( task - 1 ) * num_levels + level];
+            std::memcpy( buffer.cells, output_caches[min_z + level], sizeof( float_grid ) );
+            task_caches[task][min_z + level] = &buffer.cells;
+        }
+    }
+    get_thread_pool().run( num_tasks, [&]( const size_t task ) {
+        for( size_t i = task; i < segments.size(); i += num_tasks ) {
+            segments[i]( task_caches[task], input_arrays, floor_caches, origin );
+        }
+    } );
+    for( size_t task = 1; task < num_tasks; task++ ) {
+        for( size_t level = 0; level < num_levels; level++ ) {
+            merge_max( *output_caches[min_z + level], *task_caches[task][min_z + level] );
+        }
+    }
+}
+
 /**
  * Calculates the Field Of View for the provided map from the given x, y
  * coordinates. Returns a lightmap for a result where the values represent a
@@ -1154,8 +1305,13 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
             &seen_cache[0][0], map_dimensions, light_transparency_solid );
         seen_cache[origin.x][origin.y] = LIGHT_TRANSPARENCY_CLEAR;
 
-        castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
-            seen_cache, transparency_cache, origin.xy(), 0 );
+        const size_t num_tasks = shadowcasting_tasks( 8 );
+        if( num_tasks > 1 ) {
+            cast_sight_parallel( seen_cache, transparency_cache, origin.xy(), num_tasks );
+        } else {
+            castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+                seen_cache, transparency_cache, origin.xy(), 0 );
+        }
     } else {
         // Cache the caches (pointers to them)
         array_of_grids_of<const float> transparency_caches;
@@ -1172,8 +1328,13 @@ void map::build_seen_cache( const tripoint &origin, const int target_z )
         if( origin.z == target_z ) {
             get_cache( origin.z ).seen_cache[origin.x][origin.y] = LIGHT_TRANSPARENCY_CLEAR;
         }
-        cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
-            seen_caches, transparency_caches, floor_caches, origin, 0, 1.0 );
+        const size_t num_tasks = shadowcasting_tasks( 16 );
+        if( num_tasks > 1 ) {
+            cast_zsight_parallel( seen_caches, transparency_caches, floor_caches, origin, num_tasks );
+        } else {
+            cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
+                seen_caches, transparency_caches, floor_caches, origin, 0, 1.0 );
+        }
     }
 
     const optional_vpart_position vp = veh_at( origin );
@@ -1266,10 +1427,16 @@ static bool light_check( const float &transparency, const float &intensity )
 void map::apply_light_source( const tripoint &p, float luminance )
 {
     auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
-    float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
+    apply_light_source( p, luminance, cache.lm, cache.sm );
+}
+
+void map::apply_light_source( const tripoint &p, float luminance,
+                              four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                              float ( &sm )[MAPSIZE_X][MAPSIZE_Y] ) const
+{
+    const auto &cache = get_cache( p.z );
+    const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
+    const float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
 
     const int x = p.x;
     const int y = p.y;
@@ -1344,6 +1511,216 @@ void map::apply_light_source( const tripoint &p, float luminance )
     }
 }
 
+void map::apply_light_sources_parallel( const std::vector<tripoint> &sources,
+        const size_t num_tasks, quadrant_grid &lm, float_grid &sm ) const
+{
+    // The sources are interleaved over the tasks, bright sources tend to be clustered.
+    const auto &cache = get_cache( sources.front().z );
+    std::vector<grid_buffer<four_quadrants>> lm_buffers( num_tasks - 1 );
+    std::vector<grid_buffer<float>> sm_buffers( num_tasks - 1 );
+    for( size_t i = 0; i + 1 < num_tasks; i++ ) {
+        std::memcpy( lm_buffers[i].cells, lm, sizeof( lm ) );
+        std::memcpy( sm_buffers[i].cells, sm, sizeof( sm ) );
+    }
+    get_thread_pool().run( num_tasks, [&]( const size_t task ) {
+        quadrant_grid &task_lm = task == 0 ? lm : lm_buffers[task - 1].cells;
+        float_grid &task_sm = task == 0 ? sm : sm_buffers[task - 1].cells;
+        for( size_t i = task; i < sources.size(); i += num_tasks ) {
+            const tripoint &p = sources[i];
+            apply_light_source( p, cache.light_source_buffer[p.x][p.y], task_lm, task_sm );
+        }
+    } );
+    for( size_t i = 0; i + 1 < num_tasks; i++ ) {
+        merge_max( lm, lm_buffers[i].cells );
+        merge_max( sm, sm_buffers[i].cells );
+    }
+}
+
+void map::apply_buffered_light_sources( const std::vector<tripoint> &sources,
+                                        quadrant_grid &lm, float_grid &sm ) const
+{
+    const size_t num_tasks = shadowcasting_tasks( sources.size() );
+    if( num_tasks > 1 ) {
+        apply_light_sources_parallel( sources, num_tasks, lm, sm );
+        return;
+    }
+    for( const tripoint &p : sources ) {
+        apply_light_source( p, get_cache( p.z ).light_source_buffer[p.x][p.y], lm, sm );
+    }
+}
+
+// Farthest (in squares) apply_light_source can cast the light of a source, the intensity
+// falls off at least as 1/distance and casting stops below LIGHT_AMBIENT_LOW.
+static rectangle light_source_area( const point &p, const float luminance )
+{
+    const int range = std::min( 60, static_cast<int>( std::ceil( luminance / LIGHT_AMBIENT_LOW ) ) + 1 );
+    return rectangle( p - point( range, range ), p + point( range + 1, range + 1 ) );
+}
+
+/**
+ * Counts marked squares of the map in rectangles in constant time (summed-area table).
+ * Marking is done in bulk: either single squares or whole rectangles, then @ref finish.
+ */
+class marked_area
+{
+    public:
+        marked_area() : sums( ( MAPSIZE_X + 1 ) * ( MAPSIZE_Y + 1 ), 0 ) {}
+
+        void mark( const point &p ) {
+            at( p.x + 1, p.y + 1 ) += 1;
+        }
+        // Marking rectangles must not be mixed with marking single squares.
+        void mark( const rectangle &r ) {
+            const rectangle c = clip( r );
+            if( c.p_min.x >= c.p_max.x || c.p_min.y >= c.p_max.y ) {
+                return;
+            }
+            // Corners of the rectangle in a difference table, summed up twice by finish.
+            add_corner( c.p_min.x, c.p_min.y, 1 );
+            add_corner( c.p_max.x, c.p_min.y, -1 );
+            add_corner( c.p_min.x, c.p_max.y, -1 );
+            add_corner( c.p_max.x, c.p_max.y, 1 );
+            rectangles = true;
+        }
+        void finish() {
+            if( rectangles ) {
+                prefix_sum();
+                for( int &s : sums ) {
+                    s = s > 0 ? 1 : 0;
+                }
+            }
+            prefix_sum();
+        }
+        bool contains( const point &p ) const {
+            return count( rectangle( p, p + point( 1, 1 ) ) ) > 0;
+        }
+        int count( const rectangle &r ) const {
+            const rectangle c = clip( r );
+            if( c.p_min.x >= c.p_max.x || c.p_min.y >= c.p_max.y ) {
+                return 0;
+            }
+            return at( c.p_max.x, c.p_max.y ) - at( c.p_min.x, c.p_max.y ) -
+                   at( c.p_max.x, c.p_min.y ) + at( c.p_min.x, c.p_min.y );
+        }
+
+    private:
+        static rectangle clip( const rectangle &r ) {
+            return rectangle( point( std::max( r.p_min.x, 0 ), std::max( r.p_min.y, 0 ) ),
+                              point( std::min( r.p_max.x, MAPSIZE_X ), std::min( r.p_max.y, MAPSIZE_Y ) ) );
+        }
+        int &at( const int x, const int y ) {
+            return sums[x * ( MAPSIZE_Y + 1 ) + y];
+        }
+        int at( const int x, const int y ) const {
+            return sums[x * ( MAPSIZE_Y + 1 ) + y];
+        }
+        void add_corner( const int x, const int y, const int value ) {
+            // Corners past the end of the map don't affect any square.
+            if( x < MAPSIZE_X && y < MAPSIZE_Y ) {
+                at( x + 1, y + 1 ) += value;
+            }
+        }
+        void prefix_sum() {
+            for( int x = 1; x <= MAPSIZE_X; x++ ) {
+                for( int y = 1; y <= MAPSIZE_Y; y++ ) {
+                    at( x, y ) += at( x - 1, y ) + at( x, y - 1 ) - at( x - 1, y - 1 );
+                }
+            }
+        }
+
+        std::vector<int> sums;
+        bool rectangles = false;
+};
+
+void map::update_buffered_lights( const int zlev )
+{
+    if( !buffered_lights ) {
+        buffered_lights = std::make_unique<buffered_light_cache>();
+    }
+    buffered_light_cache &state = *buffered_lights;
+    const level_cache &cache = get_cache( zlev );
+    const float_grid &sources = cache.light_source_buffer;
+    const float_grid &transparency = cache.transparency_cache;
+    const tripoint cache_start( 0, 0, zlev );
+    const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
+
+    std::vector<tripoint> recast;
+    if( !state.valid || state.zlev != zlev ) {
+        // Nothing to compare with, cast everything.
+        std::memset( state.lm, 0, sizeof( state.lm ) );
+        std::memset( state.sm, 0, sizeof( state.sm ) );
+        for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
+            if( sources[p.x][p.y] > 0.0f ) {
+                recast.push_back( p );
+            }
+        }
+    } else {
+        /* The light of a source only depends on its luminance, the luminance of the four
+           neighbouring sources (see apply_light_source) and the transparency in its area.
+           Every source that changed in any of these ways has its old and its new area cleared,
+           then all sources reaching into the cleared squares are cast again. The light of the
+           unchanged ones is the same as before, so outside the cleared squares it only
+           rewrites values that are already there.
+        */
+        marked_area changed_transparency;
+        marked_area changed_sources;
+        for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
+            if( transparency[p.x][p.y] != state.transparency[p.x][p.y] ) {
+                changed_transparency.mark( p.xy() );
+            }
+            if( sources[p.x][p.y] != state.sources[p.x][p.y] ) {
+                changed_sources.mark( p.xy() );
+            }
+        }
+        changed_transparency.finish();
+        changed_sources.finish();
+
+        marked_area dirty;
+        for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
+            const float old_luminance = state.sources[p.x][p.y];
+            const float new_luminance = sources[p.x][p.y];
+            if( old_luminance <= 0.0f && new_luminance <= 0.0f ) {
+                continue;
+            }
+            const bool changed = changed_sources.contains( p.xy() ) ||
+                                 changed_sources.contains( p.xy() + point_north ) ||
+                                 changed_sources.contains( p.xy() + point_south ) ||
+                                 changed_sources.contains( p.xy() + point_east ) ||
+                                 changed_sources.contains( p.xy() + point_west ) ||
+                                 changed_transparency.count( light_source_area( p.xy(), old_luminance ) ) > 0;
+            if( !changed ) {
+                continue;
+            }
+            if( old_luminance > 0.0f ) {
+                dirty.mark( light_source_area( p.xy(), old_luminance ) );
+            }
+            if( new_luminance > 0.0f ) {
+                dirty.mark( light_source_area( p.xy(), new_luminance ) );
+            }
+        }
+        dirty.finish();
+
+        for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
+            if( dirty.contains( p.xy() ) ) {
+                state.lm[p.x][p.y].fill( 0.0f );
+                state.sm[p.x][p.y] = 0.0f;
+            }
+            if( sources[p.x][p.y] > 0.0f &&
+                dirty.count( light_source_area( p.xy(), sources[p.x][p.y] ) ) > 0 ) {
+                recast.push_back( p );
+            }
+        }
+    }
+
+    if( !recast.empty() ) {
+        apply_buffered_light_sources( recast, state.lm, state.sm );
+    }
+    std::memcpy( state.sources, sources, sizeof( state.sources ) );
+    std::memcpy( state.transparency, transparency, sizeof( state.transparency ) );
+    state.zlev = zlev;
+    state.valid = true;
+}
+
 void map::apply_directional_light( const tripoint &p, int direction, float luminance )
 {
     const int x = p.x;
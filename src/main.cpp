@@ -28,6 +28,7 @@
 #include "filesystem.h"
 #include "game.h"
 #include "game_ui.h"
+#include "init.h"
 #include "input.h"
 #include "loading_ui.h"
 #include "main_menu.h"
@@ -184,7 +185,7 @@ int main( int argc, char *argv[] )
         const char *section_default = nullptr;
         const char *section_map_sharing = "Map sharing";
         const char *section_user_directory = "User directories";
-        const std::array<arg_handler, 12> first_pass_arguments = {{
+        const std::array<arg_handler, 13> first_pass_arguments = {{
                 {
                     "--seed", "<string of letters and or numbers>",
                     "Sets the random number generator's seed value",
@@ -208,6 +209,15 @@ int main( int argc, char *argv[] )
                         return 0;
                     }
                 },
+                {
+                    "--load-timings", nullptr,
+                    "Logs how long each step of loading the game data takes to debug.log",
+                    section_default,
+                    []( int, const char ** ) -> int {
+                        DynamicDataLoader::log_timings = true;
+                        return 0;
+                    }
+                },
                 {
                     "--check-mods", "[mods…]",
                     "Checks the json files belonging to CDDA mods",
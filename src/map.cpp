@@ -145,6 +145,8 @@ map::map( int mapsize, bool zlev )
     for( auto &ptr : pathfinding_caches ) {
         ptr = std::make_unique<pathfinding_cache>();
     }
+    route_memory = std::make_unique<route_memo>();
+    flow_fields = std::make_unique<flow_field_cache>();
 
     dbg( D_INFO ) << "map::map(): my_MAPSIZE: " << my_MAPSIZE << " z-levels enabled:" << zlevels;
     traplocs.resize( trap::count() );
@@ -221,6 +223,24 @@ void map::add_vehicle_to_cache( vehicle *veh )
 
     auto &ch = get_cache( veh->sm_pos.z );
     ch.veh_in_active_range = true;
+    const auto has_vehicle = [veh]( const level_cache::veh_slot & slot ) {
+        return slot.veh == veh;
+    };
+    auto slot = std::find_if( ch.veh_slots.begin(), ch.veh_slots.end(), has_vehicle );
+    if( slot != ch.veh_slots.end() ) {
+        // Already cached, the parts might have moved since.
+        uncache_vehicle_tiles( ch, *slot, static_cast<uint16_t>( slot - ch.veh_slots.begin() + 1 ) );
+    } else {
+        slot = std::find_if( ch.veh_slots.begin(), ch.veh_slots.end(),
+        []( const level_cache::veh_slot & slot ) {
+            return slot.veh == nullptr;
+        } );
+        if( slot == ch.veh_slots.end() ) {
+            slot = ch.veh_slots.emplace( ch.veh_slots.end() );
+        }
+        slot->veh = veh;
+    }
+    const uint16_t slot_id = static_cast<uint16_t>( slot - ch.veh_slots.begin() + 1 );
     // Get parts
     std::vector<vehicle_part> &parts = veh->parts;
     int partid = 0;
@@ -230,12 +250,28 @@ void map::add_vehicle_to_cache( vehicle *veh )
             continue;
         }
         const tripoint p = veh->global_part_pos3( *it );
-        ch.veh_cached_parts.insert( std::make_pair( p,
-                                    std::make_pair( veh, partid ) ) );
-        if( inbounds( p ) ) {
-            ch.veh_exists_at[p.x][p.y] = true;
+        if( !inbounds( p ) ) {
+            continue;
+        }
+        level_cache::veh_part_ref &ref = ch.veh_parts_at[p.x][p.y];
+        if( ref.slot == 0 ) {
+            ref.slot = slot_id;
+            ref.part = static_cast<uint16_t>( partid );
+            slot->tiles.push_back( p.xy() );
+        }
+    }
+}
+
+void map::uncache_vehicle_tiles( level_cache &ch, level_cache::veh_slot &slot,
+                                 const uint16_t slot_id )
+{
+    for( const point &p : slot.tiles ) {
+        level_cache::veh_part_ref &ref = ch.veh_parts_at[p.x][p.y];
+        if( ref.slot == slot_id ) {
+            ref.slot = 0;
         }
     }
+    slot.tiles.clear();
 }
 
 void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
@@ -247,20 +283,17 @@ void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
 
     // Existing must be cleared
     auto &ch = get_cache( old_zlevel );
-    auto it = ch.veh_cached_parts.begin();
-    const auto end = ch.veh_cached_parts.end();
-    while( it != end ) {
-        if( it->second.first == veh ) {
-            const tripoint p = it->first;
-            if( inbounds( p ) ) {
-                ch.veh_exists_at[p.x][p.y] = false;
-            }
-            ch.veh_cached_parts.erase( it++ );
+    for( auto slot = ch.veh_slots.begin(); slot != ch.veh_slots.end(); ++slot ) {
+        if( slot->veh != veh ) {
+            continue;
+        }
+        for( const point &p : slot->tiles ) {
             // If something was resting on vehicle, drop it
-            support_dirty( tripoint( p.xy(), old_zlevel + 1 ) );
-        } else {
-            ++it;
+            support_dirty( tripoint( p, old_zlevel + 1 ) );
         }
+        uncache_vehicle_tiles( ch, *slot, static_cast<uint16_t>( slot - ch.veh_slots.begin() + 1 ) );
+        slot->veh = nullptr;
+        break;
     }
 
     add_vehicle_to_cache( veh );
@@ -269,14 +302,10 @@ void map::update_vehicle_cache( vehicle *veh, const int old_zlevel )
 void map::clear_vehicle_cache( const int zlev )
 {
     auto &ch = get_cache( zlev );
-    while( !ch.veh_cached_parts.empty() ) {
-        const auto part = ch.veh_cached_parts.begin();
-        const auto &p = part->first;
-        if( inbounds( p ) ) {
-            ch.veh_exists_at[p.x][p.y] = false;
-        }
-        ch.veh_cached_parts.erase( part );
+    for( size_t i = 0; i < ch.veh_slots.size(); i++ ) {
+        uncache_vehicle_tiles( ch, ch.veh_slots[i], static_cast<uint16_t>( i + 1 ) );
     }
+    ch.veh_slots.clear();
 }
 
 void map::clear_vehicle_list( const int zlev )
@@ -935,20 +964,18 @@ const vehicle *map::veh_at_internal( const tripoint &p, int &part_num ) const
 {
     // This function is called A LOT. Move as much out of here as possible.
     const auto &ch = get_cache_ref( p.z );
-    if( !ch.veh_in_active_range || !ch.veh_exists_at[p.x][p.y] ) {
+    if( !ch.veh_in_active_range ) {
         part_num = -1;
         return nullptr; // Clear cache indicates no vehicle. This should optimize a great deal.
     }
 
-    const auto it = ch.veh_cached_parts.find( p );
-    if( it != ch.veh_cached_parts.end() ) {
-        part_num = it->second.second;
-        return it->second.first;
+    const level_cache::veh_part_ref &ref = ch.veh_parts_at[p.x][p.y];
+    if( ref.slot == 0 ) {
+        part_num = -1;
+        return nullptr;
     }
-
-    debugmsg( "vehicle part cache indicated vehicle not found: %d %d %d", p.x, p.y, p.z );
-    part_num = -1;
-    return nullptr;
+    part_num = ref.part;
+    return ch.veh_slots[ref.slot - 1].veh;
 }
 
 vehicle *map::veh_at_internal( const tripoint &p, int &part_num )
@@ -1043,6 +1070,8 @@ bool map::displace_vehicle( vehicle &veh, const tripoint &dp )
     point dst_offset;
     submap *src_submap = get_submap_at( src, src_offset );
     submap *const dst_submap = get_submap_at( dst, dst_offset );
+    // Cables are found by the position of the vehicle they are plugged into.
+    vehicle_power_grid::invalidate_all();
 
     // first, let's find our position in current vehicles vector
     size_t our_i = 0;
@@ -1300,15 +1329,15 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture )
         field_furn_locs.push_back( p );
     }
     if( old_t.transparent != new_t.transparent ) {
-        set_transparency_cache_dirty( p.z );
+        set_transparency_cache_dirty( p );
     }
 
     if( old_t.has_flag( TFLAG_INDOORS ) != new_t.has_flag( TFLAG_INDOORS ) ) {
-        set_outside_cache_dirty( p.z );
+        set_outside_cache_dirty( p );
     }
 
     if( old_t.has_flag( TFLAG_NO_FLOOR ) != new_t.has_flag( TFLAG_NO_FLOOR ) ) {
-        set_floor_cache_dirty( p.z );
+        set_floor_cache_dirty( p );
     }
     set_memory_seen_cache_dirty( p );
 
@@ -1545,15 +1574,15 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     }
 
     if( old_t.transparent != new_t.transparent ) {
-        set_transparency_cache_dirty( p.z );
+        set_transparency_cache_dirty( p );
     }
 
     if( old_t.has_flag( TFLAG_INDOORS ) != new_t.has_flag( TFLAG_INDOORS ) ) {
-        set_outside_cache_dirty( p.z );
+        set_outside_cache_dirty( p );
     }
 
     if( new_t.has_flag( TFLAG_NO_FLOOR ) != old_t.has_flag( TFLAG_NO_FLOOR ) ) {
-        set_floor_cache_dirty( p.z );
+        set_floor_cache_dirty( p );
         // It's a set, not a flag
         support_cache_dirty.insert( p );
     }
@@ -2540,34 +2569,26 @@ void map::decay_fields_and_scent( const time_duration &amount )
                 continue;
             }
 
-            for( int sx = 0; sx < SEEX; ++sx ) {
-                if( to_proc < 1 ) {
-                    // This submap had some fields, but all got proc'd already
-                    break;
-                }
-
-                for( int sy = 0; sy < SEEY; ++sy ) {
-                    const int x = sx + smx * SEEX;
-                    const int y = sy + smy * SEEY;
+            cur_submap->for_each_field( [&]( const point & sp, field & fields ) {
+                const int x = sp.x + smx * SEEX;
+                const int y = sp.y + smy * SEEY;
 
-                    field &fields = cur_submap->get_field( { sx, sy} );
-                    if( !outside_cache[x][y] ) {
-                        to_proc -= fields.field_count();
-                        continue;
-                    }
+                if( !outside_cache[x][y] ) {
+                    to_proc -= fields.field_count();
+                    return;
+                }
 
-                    for( auto &fp : fields ) {
-                        to_proc--;
-                        field_entry &cur = fp.second;
-                        const field_type_id type = cur.get_field_type();
-                        const int decay_amount_factor =  type.obj().decay_amount_factor;
-                        if( decay_amount_factor != 0 ) {
-                            const time_duration decay_amount = amount / decay_amount_factor;
-                            cur.set_field_age( cur.get_field_age() + decay_amount );
-                        }
+                for( auto &fp : fields ) {
+                    to_proc--;
+                    field_entry &cur = fp.second;
+                    const field_type_id type = cur.get_field_type();
+                    const int decay_amount_factor =  type.obj().decay_amount_factor;
+                    if( decay_amount_factor != 0 ) {
+                        const time_duration decay_amount = amount / decay_amount_factor;
+                        cur.set_field_age( cur.get_field_age() + decay_amount );
                     }
                 }
-            }
+            } );
 
             if( to_proc > 0 ) {
                 cur_submap->field_count = cur_submap->field_count - to_proc;
@@ -4454,11 +4475,15 @@ void map::process_items( const bool active, map::map_process_func processor,
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int gz = minz; gz <= maxz; ++gz ) {
         level_cache &cache = access_cache( gz );
-        std::set<tripoint> submaps_with_vehicles;
+        std::vector<tripoint> submaps_with_vehicles;
+        submaps_with_vehicles.reserve( cache.vehicle_list.size() );
         for( vehicle *this_vehicle : cache.vehicle_list ) {
             tripoint pos = this_vehicle->global_pos3();
-            submaps_with_vehicles.emplace( pos.x / SEEX, pos.y / SEEY, pos.z );
+            submaps_with_vehicles.emplace_back( pos.x / SEEX, pos.y / SEEY, pos.z );
         }
+        std::sort( submaps_with_vehicles.begin(), submaps_with_vehicles.end() );
+        submaps_with_vehicles.erase( std::unique( submaps_with_vehicles.begin(),
+                                     submaps_with_vehicles.end() ), submaps_with_vehicles.end() );
         for( const tripoint &pos : submaps_with_vehicles ) {
             submap *const current_submap = get_submap_at_grid( pos );
             // Vehicles first in case they get blown up and drop active items on the map.
@@ -4466,7 +4491,8 @@ void map::process_items( const bool active, map::map_process_func processor,
         }
     }
     // Making a copy, in case the original variable gets modified during `process_items_in_submap`
-    const std::set<tripoint> submaps_with_active_items_copy = submaps_with_active_items;
+    const std::vector<tripoint> submaps_with_active_items_copy( submaps_with_active_items.begin(),
+            submaps_with_active_items.end() );
     for( const tripoint &abs_pos : submaps_with_active_items_copy ) {
         const tripoint local_pos = abs_pos - abs_sub.xy();
         submap *const current_submap = get_submap_at_grid( local_pos );
@@ -5284,9 +5310,9 @@ bool map::add_field( const tripoint &p, const field_type_id &type, int intensity
     submap *const current_submap = get_submap_at( p, l );
     current_submap->is_uniform = false;
 
-    if( current_submap->get_field( l ).add_field( type, intensity, age ) ) {
+    if( current_submap->add_field( l, type, intensity, age ) ) {
         //Only adding it to the count if it doesn't exist.
-        if( !current_submap->field_count++ ) {
+        if( current_submap->field_count == 1 ) {
             get_cache( p.z ).field_cache.set( static_cast<size_t>( p.x / SEEX + ( (
                                                   p.y / SEEX ) * MAPSIZE ) ) );
         }
@@ -5298,7 +5324,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type, int intensity
 
     // Dirty the transparency cache now that field processing doesn't always do it
     // TODO: Make it skip transparent fields
-    set_transparency_cache_dirty( p.z );
+    set_transparency_cache_dirty( p );
 
     if( type.obj().is_dangerous() ) {
         set_pathfinding_cache_dirty( p.z );
@@ -5329,7 +5355,7 @@ void map::remove_field( const tripoint &p, const field_type_id &field_to_remove
         }
         const auto &fdata = field_to_remove.obj();
         if( fdata.is_transparent() ) {
-            set_transparency_cache_dirty( p.z );
+            set_transparency_cache_dirty( p );
         }
         if( fdata.is_dangerous() ) {
             set_pathfinding_cache_dirty( p.z );
@@ -6544,6 +6570,8 @@ void map::shift( const point &sp )
         }
 
         reset_vehicle_cache( gridz );
+        // The caches are in local coordinates, so every cached tile moved
+        invalidate_map_cache( gridz );
     }
 
     g->setremoteveh( remoteveh );
@@ -6682,10 +6710,17 @@ void map::loadn( const tripoint &grid, const bool update_vehicles )
         }
     }
 
-    // New submap changes the content of the map and all caches must be recalculated
-    set_transparency_cache_dirty( grid.z );
-    set_outside_cache_dirty( grid.z );
-    set_floor_cache_dirty( grid.z );
+    // New submap changes the content of the map and all caches covering it must be recalculated
+    const tripoint grid_origin( grid.x * SEEX, grid.y * SEEY, grid.z );
+    for( const tripoint &corner : {
+             grid_origin, grid_origin + point( SEEX - 1, 0 ), grid_origin + point( 0, SEEY - 1 ),
+             grid_origin + point( SEEX - 1, SEEY - 1 )
+         } ) {
+        // Indoor tiles at the edges spill into the neighbouring submaps
+        set_outside_cache_dirty( corner );
+    }
+    set_transparency_cache_dirty( grid_origin );
+    set_floor_cache_dirty( grid_origin );
     set_pathfinding_cache_dirty( grid.z );
     setsubmap( gridn, tmpsub );
     if( !tmpsub->active_items.empty() ) {
@@ -7536,42 +7571,54 @@ int map::determine_wall_corner( const tripoint &p ) const
 void map::build_outside_cache( const int zlev )
 {
     auto &ch = get_cache( zlev );
-    if( !ch.outside_cache_dirty ) {
+    if( ch.outside_cache_dirty.none() ) {
         return;
     }
 
-    // Make a bigger cache to avoid bounds checking
-    // We will later copy it to our regular cache
-    const size_t padded_w = ( MAPSIZE_X ) + 2;
-    const size_t padded_h = ( MAPSIZE_Y ) + 2;
-    bool padded_cache[padded_w][padded_h];
-
     auto &outside_cache = ch.outside_cache;
     if( zlev < 0 ) {
         std::uninitialized_fill_n(
             &outside_cache[0][0], ( MAPSIZE_X ) * ( MAPSIZE_Y ), false );
+        ch.outside_cache_dirty.reset();
         return;
     }
 
-    std::uninitialized_fill_n(
-        &padded_cache[0][0], padded_w * padded_h, true );
+    const int map_w = SEEX * my_MAPSIZE;
+    const int map_h = SEEY * my_MAPSIZE;
+    const auto is_indoors = [this, zlev]( const int x, const int y ) {
+        const submap *cur_submap = get_submap_at_grid( { x / SEEX, y / SEEY, zlev } );
+        const point sp( x % SEEX, y % SEEY );
+        return cur_submap->get_ter( sp ).obj().has_flag( TFLAG_INDOORS ) ||
+               cur_submap->get_furn( sp ).obj().has_flag( TFLAG_INDOORS );
+    };
 
+    int rebuilt = 0;
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
-            const auto cur_submap = get_submap_at_grid( { smx, smy, zlev } );
+            const size_t sm_index = smx + smy * MAPSIZE;
+            if( !ch.outside_cache_dirty[sm_index] ) {
+                continue;
+            }
+            rebuilt++;
 
-            for( int sx = 0; sx < SEEX; ++sx ) {
-                for( int sy = 0; sy < SEEY; ++sy ) {
-                    point sp( sx, sy );
-                    if( cur_submap->get_ter( sp ).obj().has_flag( TFLAG_INDOORS ) ||
-                        cur_submap->get_furn( sp ).obj().has_flag( TFLAG_INDOORS ) ) {
-                        const int x = sx + smx * SEEX;
-                        const int y = sy + smy * SEEY;
-                        // Add 1 to both coordinates, because we're operating on the padded cache
-                        for( int dx = 0; dx <= 2; dx++ ) {
-                            for( int dy = 0; dy <= 2; dy++ ) {
-                                padded_cache[x + dx][y + dy] = false;
-                            }
+            const int minx = smx * SEEX;
+            const int miny = smy * SEEY;
+            const int maxx = minx + SEEX - 1;
+            const int maxy = miny + SEEY - 1;
+            for( int x = minx; x <= maxx; x++ ) {
+                std::fill_n( &outside_cache[x][miny], SEEY, true );
+            }
+
+            // Indoor tiles make their neighbours inside too, including those on the other side
+            // of the submap border
+            for( int x = std::max( minx - 1, 0 ); x <= std::min( maxx + 1, map_w - 1 ); x++ ) {
+                for( int y = std::max( miny - 1, 0 ); y <= std::min( maxy + 1, map_h - 1 ); y++ ) {
+                    if( !is_indoors( x, y ) ) {
+                        continue;
+                    }
+                    for( int dx = std::max( x - 1, minx ); dx <= std::min( x + 1, maxx ); dx++ ) {
+                        for( int dy = std::max( y - 1, miny ); dy <= std::min( y + 1, maxy ); dy++ ) {
+                            outside_cache[dx][dy] = false;
                         }
                     }
                 }
@@ -7579,12 +7626,10 @@ void map::build_outside_cache( const int zlev )
         }
     }
 
-    // Copy the padded cache back to the proper one, but with no padding
-    for( int x = 0; x < SEEX * my_MAPSIZE; x++ ) {
-        std::copy_n( &padded_cache[x + 1][1], SEEX * my_MAPSIZE, &outside_cache[x][0] );
-    }
-
-    ch.outside_cache_dirty = false;
+    // Transparency depends on being outside
+    ch.transparency_cache_dirty |= ch.outside_cache_dirty;
+    ch.outside_cache_dirty.reset();
+    cache_rebuilds_this_turn().outside += rebuilt;
 }
 
 void map::build_obstacle_cache( const tripoint &start, const tripoint &end,
@@ -7661,24 +7706,27 @@ void map::build_obstacle_cache( const tripoint &start, const tripoint &end,
 bool map::build_floor_cache( const int zlev )
 {
     auto &ch = get_cache( zlev );
-    if( !ch.floor_cache_dirty ) {
+    if( ch.floor_cache_dirty.none() ) {
         return false;
     }
 
     auto &floor_cache = ch.floor_cache;
-    std::uninitialized_fill_n(
-        &floor_cache[0][0], ( MAPSIZE_X ) * ( MAPSIZE_Y ), true );
-
+    int rebuilt = 0;
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            if( !ch.floor_cache_dirty[smx + smy * MAPSIZE] ) {
+                continue;
+            }
+            rebuilt++;
             const auto cur_submap = get_submap_at_grid( { smx, smy, zlev } );
 
             for( int sx = 0; sx < SEEX; ++sx ) {
+                const int x = sx + smx * SEEX;
+                std::fill_n( &floor_cache[x][smy * SEEY], SEEY, true );
                 for( int sy = 0; sy < SEEY; ++sy ) {
                     // Note: furniture currently can't affect existence of floor
                     const ter_t &terrain = cur_submap->get_ter( { sx, sy } ).obj();
                     if( terrain.has_flag( TFLAG_NO_FLOOR ) ) {
-                        const int x = sx + smx * SEEX;
                         const int y = sy + smy * SEEY;
                         floor_cache[x][y] = false;
                     }
@@ -7687,8 +7735,9 @@ bool map::build_floor_cache( const int zlev )
         }
     }
 
-    ch.floor_cache_dirty = false;
-    return zlevels;
+    ch.floor_cache_dirty.reset();
+    cache_rebuilds_this_turn().floor += rebuilt;
+    return zlevels && rebuilt > 0;
 }
 
 void map::build_floor_caches()
@@ -8248,9 +8297,9 @@ const level_cache &map::access_cache( int zlev ) const
 level_cache::level_cache()
 {
     const int map_dimensions = MAPSIZE_X * MAPSIZE_Y;
-    transparency_cache_dirty = true;
-    outside_cache_dirty = true;
-    floor_cache_dirty = false;
+    transparency_cache_dirty.set();
+    outside_cache_dirty.set();
+    floor_cache_dirty.reset();
     constexpr four_quadrants four_zeros( 0.0f );
     std::fill_n( &lm[0][0], map_dimensions, four_zeros );
     std::fill_n( &sm[0][0], map_dimensions, 0.0f );
@@ -8263,13 +8312,55 @@ level_cache::level_cache()
     std::fill_n( &camera_cache[0][0], map_dimensions, 0.0f );
     std::fill_n( &visibility_cache[0][0], map_dimensions, LL_DARK );
     veh_in_active_range = false;
-    std::fill_n( &veh_exists_at[0][0], map_dimensions, false );
+    std::fill_n( &veh_parts_at[0][0], map_dimensions, veh_part_ref{ 0, 0 } );
     max_populated_zlev = OVERMAP_HEIGHT;
 }
 
+void map::set_transparency_cache_dirty( const tripoint &p )
+{
+    if( inbounds( p ) ) {
+        get_cache( p.z ).transparency_cache_dirty.set( p.x / SEEX + ( p.y / SEEY ) * MAPSIZE );
+    }
+}
+
+void map::set_outside_cache_dirty( const tripoint &p )
+{
+    if( !inbounds( p ) ) {
+        return;
+    }
+    // Indoor tiles also affect their neighbours, which may be in another submap
+    level_cache &ch = get_cache( p.z );
+    const int map_w = SEEX * my_MAPSIZE;
+    const int map_h = SEEY * my_MAPSIZE;
+    for( int x = std::max( p.x - 1, 0 ); x <= std::min( p.x + 1, map_w - 1 ); x++ ) {
+        for( int y = std::max( p.y - 1, 0 ); y <= std::min( p.y + 1, map_h - 1 ); y++ ) {
+            ch.outside_cache_dirty.set( x / SEEX + ( y / SEEY ) * MAPSIZE );
+        }
+    }
+}
+
+void map::set_floor_cache_dirty( const tripoint &p )
+{
+    if( inbounds( p ) ) {
+        get_cache( p.z ).floor_cache_dirty.set( p.x / SEEX + ( p.y / SEEY ) * MAPSIZE );
+    }
+}
+
+level_cache_rebuild_counters &map::cache_rebuilds_this_turn()
+{
+    if( cache_rebuilds.turn != calendar::turn ) {
+        cache_rebuilds = level_cache_rebuild_counters();
+        cache_rebuilds.turn = calendar::turn;
+    }
+    return cache_rebuilds;
+}
+
 pathfinding_cache::pathfinding_cache()
 {
     dirty = true;
+    generation = 0;
+    std::fill_n( &special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
+    std::fill_n( &changed_at[0][0], MAPSIZE_X * MAPSIZE_Y, 0 );
 }
 
 pathfinding_cache::~pathfinding_cache() = default;
@@ -8307,12 +8398,29 @@ void map::update_pathfinding_cache( int zlev ) const
         return;
     }
 
+    const std::vector<pf_special> previous( &cache.special[0][0],
+                                            &cache.special[0][0] + MAPSIZE_X * MAPSIZE_Y );
     std::uninitialized_fill_n( &cache.special[0][0], MAPSIZE_X * MAPSIZE_Y, PF_NORMAL );
+    const auto stamp_changes = [&cache, &previous]() {
+        // Costs of non-trivial tiles depend on more than the flags, so those always count as changed
+        static const pf_special non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
+        const int generation = ++cache.generation;
+        const pf_special *old_value = previous.data();
+        for( int x = 0; x < MAPSIZE_X; x++ ) {
+            for( int y = 0; y < MAPSIZE_Y; y++, old_value++ ) {
+                const pf_special cur_value = cache.special[x][y];
+                if( cur_value != *old_value || ( ( cur_value | *old_value ) & non_normal ) ) {
+                    cache.changed_at[x][y] = generation;
+                }
+            }
+        }
+    };
 
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
             const auto cur_submap = get_submap_at_grid( { smx, smy, zlev } );
             if( !cur_submap ) {
+                stamp_changes();
                 return;
             }
 
@@ -8375,6 +8483,7 @@ void map::update_pathfinding_cache( int zlev ) const
         }
     }
 
+    stamp_changes();
     cache.dirty = false;
 }
 
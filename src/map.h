@@ -29,6 +29,7 @@
 #include "line.h"
 #include "lru_cache.h"
 #include "mapdata.h"
+#include "optional.h"
 #include "point.h"
 #include "rng.h"
 #include "shadowcasting.h"
@@ -89,6 +90,10 @@ class map;
 enum ter_bitflags : int;
 struct pathfinding_cache;
 struct pathfinding_settings;
+struct route_memo;
+enum pf_special : int;
+struct flow_field;
+struct flow_field_cache;
 template<typename T>
 struct weighted_int_list;
 
@@ -155,9 +160,10 @@ struct level_cache {
     level_cache();
     level_cache( const level_cache &other ) = default;
 
-    bool transparency_cache_dirty;
-    bool outside_cache_dirty;
-    bool floor_cache_dirty;
+    // Submaps whose part of the respective cache has to be rebuilt, indexed like field_cache
+    std::bitset<MAPSIZE *MAPSIZE> transparency_cache_dirty;
+    std::bitset<MAPSIZE *MAPSIZE> outside_cache_dirty;
+    std::bitset<MAPSIZE *MAPSIZE> floor_cache_dirty;
 
     four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
     float sm[MAPSIZE_X][MAPSIZE_Y];
@@ -175,14 +181,51 @@ struct level_cache {
     std::bitset<MAPSIZE *MAPSIZE> field_cache;
 
     bool veh_in_active_range;
-    bool veh_exists_at[MAPSIZE_X][MAPSIZE_Y];
-    std::map< tripoint, std::pair<vehicle *, int> > veh_cached_parts;
+    // A vehicle part in veh_parts_at, slot is the index in veh_slots plus one (0 for none).
+    struct veh_part_ref {
+        uint16_t slot;
+        uint16_t part;
+    };
+    // A vehicle in the cache and the tiles that refer to it (empty slots have no vehicle).
+    struct veh_slot {
+        vehicle *veh = nullptr;
+        std::vector<point> tiles;
+    };
+    // The vehicle part on each tile, if several vehicles overlap the first one cached wins.
+    veh_part_ref veh_parts_at[MAPSIZE_X][MAPSIZE_Y];
+    std::vector<veh_slot> veh_slots;
     std::set<vehicle *> vehicle_list;
     std::set<vehicle *> zone_vehicles;
 
     int max_populated_zlev;
 };
 
+/**
+ * The light cast by the bulk light sources (see @ref map::add_light_source) on the last
+ * lightmap update, so later updates only need to re-cast the sources that changed.
+ */
+struct buffered_light_cache {
+    // Whether the fields below describe the sources of zlev.
+    bool valid = false;
+    int zlev = 0;
+    // The light_source_buffer and transparency_cache the light was cast with.
+    float sources[MAPSIZE_X][MAPSIZE_Y];
+    float transparency[MAPSIZE_X][MAPSIZE_Y];
+    // The light of those sources alone.
+    four_quadrants lm[MAPSIZE_X][MAPSIZE_Y];
+    float sm[MAPSIZE_X][MAPSIZE_Y];
+};
+
+/**
+ * Number of submaps whose part of the level caches had to be rebuilt during a turn.
+ */
+struct level_cache_rebuild_counters {
+    time_point turn;
+    int transparency = 0;
+    int outside = 0;
+    int floor = 0;
+};
+
 /**
  * Manage and cache data about a part of the map.
  *
@@ -227,22 +270,27 @@ class map
         /*@{*/
         void set_transparency_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
-                get_cache( zlev ).transparency_cache_dirty = true;
+                get_cache( zlev ).transparency_cache_dirty.set();
             }
         }
 
         void set_outside_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
-                get_cache( zlev ).outside_cache_dirty = true;
+                get_cache( zlev ).outside_cache_dirty.set();
             }
         }
 
         void set_floor_cache_dirty( const int zlev ) {
             if( inbounds_z( zlev ) ) {
-                get_cache( zlev ).floor_cache_dirty = true;
+                get_cache( zlev ).floor_cache_dirty.set();
             }
         }
 
+        // Versions for a change of a single tile, they only dirty the submaps the tile can affect
+        void set_transparency_cache_dirty( const tripoint &p );
+        void set_outside_cache_dirty( const tripoint &p );
+        void set_floor_cache_dirty( const tripoint &p );
+
         void set_pathfinding_cache_dirty( int zlev );
         /*@}*/
 
@@ -256,9 +304,9 @@ class map
         void invalidate_map_cache( const int zlev ) {
             if( inbounds_z( zlev ) ) {
                 level_cache &ch = get_cache( zlev );
-                ch.floor_cache_dirty = true;
-                ch.transparency_cache_dirty = true;
-                ch.outside_cache_dirty = true;
+                ch.floor_cache_dirty.set();
+                ch.transparency_cache_dirty.set();
+                ch.outside_cache_dirty.set();
             }
         }
 
@@ -384,8 +432,25 @@ class map
         maptile maptile_at_internal( const tripoint &p );
         maptile maptile_has_bounds( const tripoint &p, bool bounds_checked );
         std::array<maptile, 8> get_neighbors( const tripoint &p );
+        /**
+         * Ages the gas and neutralizes scent around it, and if @p spread is true, moves
+         * one intensity level of it to a neighbouring tile (see @ref gas_spread_target).
+         */
         void spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
-                         const time_duration &outdoor_age_speedup, scent_block &sblk );
+                         const time_duration &outdoor_age_speedup, scent_block &sblk, bool spread = true );
+        /**
+         * Picks the tile the gas at @p p spreads to this turn, if any. Only reads the map,
+         * so this can run concurrently for different tiles (each thread using its own
+         * random engine) as long as nothing else modifies the map meanwhile.
+         */
+        cata::optional<maptile> gas_spread_target( field_entry &cur, const tripoint &p,
+                int percent_spread, int windpower, bool sheltered );
+        /**
+         * Spreads the gases of all submaps on z-level @p z at once: the targets are picked
+         * for all submaps in parallel from the state of the previous turn, and only then
+         * applied, in submap order. See the DOUBLE_BUFFERED_GAS_SPREAD option.
+         */
+        void spread_gases_double_buffered( int z );
         void create_hot_air( const tripoint &p, int intensity );
         bool gas_can_spread_to( field_entry &cur, const maptile &dst );
         void gas_spread_to( field_entry &cur, maptile &dst );
@@ -537,7 +602,21 @@ class map
          */
         std::vector<tripoint> route( const tripoint &f, const tripoint &t,
                                      const pathfinding_settings &settings,
-        const std::set<tripoint> &pre_closed = {{ }} ) const;
+        const std::set<tripoint> &pre_closed = {} ) const;
+
+        /**
+         * Distances toward the target over its z-level, shared between every caller that asks
+         * for the same target with settings of the same cost class during the current turn.
+         */
+        const flow_field &get_flow_field( const tripoint &t, const pathfinding_settings &settings ) const;
+        /**
+         * Next step from f toward t, taken from the straight line if it is clear or from the
+         * shared flow field of t otherwise. Empty if t can't be reached within the settings limits
+         * or isn't on the same z-level as f. Targets outside the map are clipped to its edge,
+         * like in @ref route.
+         */
+        cata::optional<tripoint> flow_step( const tripoint &f, const tripoint &t,
+                                            const pathfinding_settings &settings ) const;
 
         // Vehicles: Common to 2D and 3D
         VehicleList get_vehicles();
@@ -1641,6 +1720,13 @@ class map
         int bash_rating_internal( int str, const furn_t &furniture,
                                   const ter_t &terrain, bool allow_floor,
                                   const vehicle *veh, int part ) const;
+        /**
+         * Cost of stepping onto p for the cost class of the settings, -1 if it can't be entered.
+         * Simplified version of the per-step costs used by @ref route.
+         */
+        int flow_enter_cost( const tripoint &p, pf_special p_special,
+                             const pathfinding_settings &settings ) const;
+        void build_flow_field( flow_field &field ) const;
 
         /**
          * Internal version of the drawsq. Keeps a cached maptile for less re-getting.
@@ -1665,6 +1751,21 @@ class map
         int determine_wall_corner( const tripoint &p ) const;
         // apply a circular light pattern immediately, however it's best to use...
         void apply_light_source( const tripoint &p, float luminance );
+        // Same, but writes the light into the given arrays instead of the level cache.
+        void apply_light_source( const tripoint &p, float luminance,
+                                 four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                                 float ( &sm )[MAPSIZE_X][MAPSIZE_Y] ) const;
+        // Applies the light_source_buffer entries at these points on several threads.
+        void apply_light_sources_parallel( const std::vector<tripoint> &sources, size_t num_tasks,
+                                           four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                                           float ( &sm )[MAPSIZE_X][MAPSIZE_Y] ) const;
+        // Applies the light_source_buffer entries at these points, in parallel if enabled.
+        void apply_buffered_light_sources( const std::vector<tripoint> &sources,
+                                           four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y],
+                                           float ( &sm )[MAPSIZE_X][MAPSIZE_Y] ) const;
+        // Brings buffered_lights up to date with the light_source_buffer of zlev, only
+        // re-casting the sources that moved, changed or had the transparency around them change.
+        void update_buffered_lights( int zlev );
         // ...this, which will apply the light after at the end of generate_lightmap, and prevent redundant
         // light rays from causing massive slowdowns, if there's a huge amount of light.
         void add_light_source( const tripoint &p, float luminance );
@@ -1701,6 +1802,9 @@ class map
         using map_process_func = bool ( * )( item_stack &, safe_reference<item> &, const tripoint &,
                                              const std::string &, float, temperature_flag );
     private:
+        /** Removes the tiles of a vehicle slot from the vehicle part cache. */
+        static void uncache_vehicle_tiles( level_cache &ch, level_cache::veh_slot &slot,
+                                           uint16_t slot_id );
 
         // Iterates over every item on the map, passing each item to the provided function.
         void process_items( bool active, map_process_func processor, const std::string &signal );
@@ -1755,6 +1859,21 @@ class map
         std::array< std::unique_ptr<level_cache>, OVERMAP_LAYERS > caches;
 
         mutable std::array< std::unique_ptr<pathfinding_cache>, OVERMAP_LAYERS > pathfinding_caches;
+        level_cache_rebuild_counters cache_rebuilds;
+        // Counters for the current turn, resets them first if the turn changed
+        level_cache_rebuild_counters &cache_rebuilds_this_turn();
+        /**
+         * Routes recently returned by @ref route, reused for repeated queries.
+         */
+        mutable std::unique_ptr<route_memo> route_memory;
+        /**
+         * Flow fields built this turn, see @ref get_flow_field.
+         */
+        mutable std::unique_ptr<flow_field_cache> flow_fields;
+        /**
+         * Light of the bulk light sources, see @ref update_buffered_lights.
+         */
+        std::unique_ptr<buffered_light_cache> buffered_lights;
         /**
          * Set of submaps that contain active items in absolute coordinates.
          */
@@ -1792,6 +1911,10 @@ class map
         const std::set<tripoint> &get_submaps_with_active_items() const {
             return submaps_with_active_items;
         }
+        // Counters of the last turn the level caches were built in.
+        const level_cache_rebuild_counters &get_cache_rebuild_counters() const {
+            return cache_rebuilds;
+        }
         // Clips the area to map bounds
         tripoint_range points_in_rectangle( const tripoint &from, const tripoint &to ) const;
         tripoint_range points_in_radius( const tripoint &center, size_t radius, size_t radiusz = 0 ) const;
@@ -44,6 +44,7 @@
 #include "mtype.h"
 #include "npc.h"
 #include "optional.h"
+#include "options.h"
 #include "overmapbuffer.h"
 #include "player.h"
 #include "pldata.h"
@@ -53,6 +54,7 @@
 #include "string_id.h"
 #include "submap.h"
 #include "teleport.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "type_id.h"
 #include "units.h"
@@ -135,32 +137,32 @@ int map::burn_body_part( player &u, field_entry &cur, body_part bp, const int sc
 
 bool map::process_fields()
 {
+    static const option_ref<bool> double_buffered_gas_spread( "DOUBLE_BUFFERED_GAS_SPREAD" );
     bool dirty_transparency_cache = false;
     const int minz = zlevels ? -OVERMAP_DEPTH : abs_sub.z;
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int z = minz; z <= maxz; z++ ) {
-        bool zlev_dirty = false;
+        if( double_buffered_gas_spread.get() ) {
+            spread_gases_double_buffered( z );
+        }
         auto &field_cache = get_cache( z ).field_cache;
         for( int x = 0; x < my_MAPSIZE; x++ ) {
             for( int y = 0; y < my_MAPSIZE; y++ ) {
                 if( field_cache[ x + y * MAPSIZE ] ) {
                     submap *const current_submap = get_submap_at_grid( { x, y, z } );
-                    const bool cur_dirty = process_fields_in_submap( current_submap, tripoint( x, y, z ) );
-                    zlev_dirty |= cur_dirty;
+                    if( process_fields_in_submap( current_submap, tripoint( x, y, z ) ) ) {
+                        // For now, just always dirty the transparency cache
+                        // when a field might possibly be changed.
+                        // TODO: check if there are any fields(mostly fire)
+                        //       that frequently change, if so set the dirty
+                        //       flag, otherwise only set the dirty flag if
+                        //       something actually changed
+                        set_transparency_cache_dirty( tripoint( x * SEEX, y * SEEY, z ) );
+                        dirty_transparency_cache = true;
+                    }
                 }
             }
         }
-
-        if( zlev_dirty ) {
-            // For now, just always dirty the transparency cache
-            // when a field might possibly be changed.
-            // TODO: check if there are any fields(mostly fire)
-            //       that frequently change, if so set the dirty
-            //       flag, otherwise only set the dirty flag if
-            //       something actually changed
-            set_transparency_cache_dirty( z );
-            dirty_transparency_cache = true;
-        }
     }
 
     return dirty_transparency_cache;
@@ -248,14 +250,8 @@ void map::gas_spread_to( field_entry &cur, maptile &dst )
 }
 
 void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
-                      const time_duration &outdoor_age_speedup, scent_block &sblk )
+                      const time_duration &outdoor_age_speedup, scent_block &sblk, const bool spread )
 {
-    const oter_id &cur_om_ter = overmap_buffer.ter( ms_to_omt_copy( g->m.getabs( p ) ) );
-    const bool sheltered = g->is_sheltered( p );
-    const int winddirection = g->weather.winddirection;
-    const int windpower = get_local_windpower( g->weather.windspeed, cur_om_ter, p, winddirection,
-                          sheltered );
-
     const int current_intensity = cur.get_field_intensity();
     const field_type_id ft_id = cur.get_field_type();
 
@@ -275,19 +271,35 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
         cur.set_field_age( current_age + outdoor_age_speedup );
     }
 
-    // Bail out if we don't meet the spread chance or required intensity.
-    if( current_intensity <= 1 || rng( 1, 100 - windpower ) > percent_spread ) {
+    if( !spread ) {
         return;
     }
 
+    const oter_id &cur_om_ter = overmap_buffer.ter( ms_to_omt_copy( g->m.getabs( p ) ) );
+    const bool sheltered = g->is_sheltered( p );
+    const int windpower = get_local_windpower( g->weather.windspeed, cur_om_ter, p,
+                          g->weather.winddirection, sheltered );
+    cata::optional<maptile> dst = gas_spread_target( cur, p, percent_spread, windpower, sheltered );
+    if( dst ) {
+        gas_spread_to( cur, *dst );
+    }
+}
+
+cata::optional<maptile> map::gas_spread_target( field_entry &cur, const tripoint &p,
+        int percent_spread, int windpower, bool sheltered )
+{
+    // Bail out if we don't meet the spread chance or required intensity.
+    if( cur.get_field_intensity() <= 1 || rng( 1, 100 - windpower ) > percent_spread ) {
+        return cata::nullopt;
+    }
+
     // First check if we can fall
     // TODO: Make fall and rise chances parameters to enable heavy/light gas
     if( zlevels && p.z > -OVERMAP_DEPTH ) {
         const tripoint down{ p.xy(), p.z - 1 };
         maptile down_tile = maptile_at_internal( down );
         if( gas_can_spread_to( cur, down_tile ) && valid_move( p, down, true, true ) ) {
-            gas_spread_to( cur, down_tile );
-            return;
+            return down_tile;
         }
     }
 
@@ -307,15 +319,15 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
             spread.push_back( i );
         }
     }
-    auto maptiles = get_wind_blockers( winddirection, p );
+    auto maptiles = get_wind_blockers( g->weather.winddirection, p );
     // Three map tiles that are facing the wind direction.
     const maptile remove_tile = std::get<0>( maptiles );
     const maptile remove_tile2 = std::get<1>( maptiles );
     const maptile remove_tile3 = std::get<2>( maptiles );
     if( !spread.empty() && ( !zlevels || one_in( spread.size() ) ) ) {
         // Construct the destination from offset and p
-        if( g->is_sheltered( p ) || windpower < 5 ) {
-            gas_spread_to( cur, neighs[ random_entry( spread ) ] );
+        if( sheltered || windpower < 5 ) {
+            return neighs[ random_entry( spread ) ];
         } else {
             end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
             // Start at end_it + 1, then wrap around until all elements have been processed.
@@ -332,14 +344,91 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
                 }
             }
             if( !neighbour_vec.empty() ) {
-                gas_spread_to( cur, neighbour_vec[rng( 0, neighbour_vec.size() - 1 )] );
+                return neighbour_vec[rng( 0, neighbour_vec.size() - 1 )];
             }
         }
     } else if( zlevels && p.z < OVERMAP_HEIGHT ) {
         const tripoint up{ p.xy(), p.z + 1 };
         maptile up_tile = maptile_at_internal( up );
         if( gas_can_spread_to( cur, up_tile ) && valid_move( p, up, true, true ) ) {
-            gas_spread_to( cur, up_tile );
+            return up_tile;
+        }
+    }
+    return cata::nullopt;
+}
+
+void map::spread_gases_double_buffered( const int z )
+{
+    struct gas_spread {
+        tripoint from;
+        field_type_id type;
+        maptile to;
+    };
+
+    const auto &field_cache = get_cache( z ).field_cache;
+    std::vector<tripoint> grids;
+    std::vector<oter_id> terrains;
+    // game::is_sheltered may refresh the insides of vehicles, so it's checked up front
+    // for the squares with fields, indexed by x + y * SEEX.
+    std::vector<std::bitset<SEEX * SEEY>> sheltered_squares;
+    for( int x = 0; x < my_MAPSIZE; x++ ) {
+        for( int y = 0; y < my_MAPSIZE; y++ ) {
+            if( field_cache[ x + y * MAPSIZE ] ) {
+                const tripoint grid( x, y, z );
+                grids.push_back( grid );
+                // A submap is always within a single overmap terrain.
+                terrains.push_back( overmap_buffer.ter( ms_to_omt_copy( getabs( tripoint( x * SEEX,
+                                    y * SEEY, z ) ) ) ) );
+                std::bitset<SEEX * SEEY> sheltered;
+                get_submap_at_grid( grid )->for_each_field( [&]( const point & loc, field & ) {
+                    sheltered[loc.x + loc.y * SEEX] = g->is_sheltered( tripoint( x * SEEX + loc.x,
+                                                      y * SEEY + loc.y, z ) );
+                } );
+                sheltered_squares.push_back( sheltered );
+            }
+        }
+    }
+
+    std::vector<std::vector<gas_spread>> spreads( grids.size() );
+    const unsigned int turn = to_turn<int>( calendar::turn );
+    get_thread_pool().run( grids.size(), [&]( const size_t i ) {
+        // Each submap has its own random sequence, so the result doesn't depend on
+        // which thread processes it. The engine of the main thread is restored after.
+        cata_default_random_engine &engine = rng_get_engine();
+        const cata_default_random_engine old_engine = engine;
+        const tripoint abs_grid = abs_sub + grids[i];
+        engine.seed( turn * 2654435761U ^ abs_grid.x * 73856093U ^ abs_grid.y * 19349663U ^
+                     abs_grid.z * 83492791U );
+
+        get_submap_at_grid( grids[i] )->for_each_field( [&]( const point & loc, field & fields ) {
+            const tripoint p( grids[i].x * SEEX + loc.x, grids[i].y * SEEY + loc.y, z );
+            for( auto &fp : fields ) {
+                field_entry &cur = fp.second;
+                const field_type &type = cur.get_field_type().obj();
+                // Newborn fields aren't processed, see process_fields_in_submap.
+                if( !cur.gas_can_spread() || cur.get_field_age() == 0_turns ) {
+                    continue;
+                }
+                const bool sheltered = sheltered_squares[i][loc.x + loc.y * SEEX];
+                const int windpower = get_local_windpower( g->weather.windspeed, terrains[i], p,
+                                      g->weather.winddirection, sheltered );
+                cata::optional<maptile> dst = gas_spread_target( cur, p, type.percent_spread,
+                                              windpower, sheltered );
+                if( dst ) {
+                    spreads[i].push_back( { p, cur.get_field_type(), *dst } );
+                }
+            }
+        } );
+        engine = old_engine;
+    } );
+
+    for( std::vector<gas_spread> &submap_spreads : spreads ) {
+        for( gas_spread &spread : submap_spreads ) {
+            // Each gas spreads at most once, so it still has the intensity to give away.
+            field_entry *cur = maptile_at_internal( spread.from ).find_field( spread.type );
+            if( cur != nullptr ) {
+                gas_spread_to( *cur, spread.to );
+            }
         }
     }
 }
@@ -383,6 +472,7 @@ If you need to insert a new field behavior per unit time add a case statement in
 bool map::process_fields_in_submap( submap *const current_submap,
                                     const tripoint &submap )
 {
+    static const option_ref<bool> double_buffered_gas_spread( "DOUBLE_BUFFERED_GAS_SPREAD" );
     scent_block sblk( submap.x, submap.y, submap.z, g->scent );
 
     // This should be true only when the field changes transparency
@@ -400,9 +490,10 @@ bool map::process_fields_in_submap( submap *const current_submap,
     maptile map_tile( current_submap, 0, 0 );
     size_t &locx = map_tile.x;
     size_t &locy = map_tile.y;
-    // Loop through all tiles in this submap indicated by current_submap
+    // Loop through all tiles in this submap indicated by current_submap that have fields
     for( locx = 0; locx < SEEX; locx++ ) {
-        for( locy = 0; locy < SEEY; locy++ ) {
+        for( locy = current_submap->next_field_tile( locx, 0 ); locy < SEEY;
+             locy = current_submap->next_field_tile( locx, locy + 1 ) ) {
             // This is a translation from local coordinates to submap coordinates.
             // All submaps are in one long 1d array.
             thep.x = locx + submap.x * SEEX;
@@ -972,7 +1063,9 @@ bool map::process_fields_in_submap( submap *const current_submap,
                     const int gas_percent_spread = curtype.obj().percent_spread;
                     if( gas_percent_spread > 0 ) {
                         const time_duration outdoor_age_speedup = curtype.obj().outdoor_age_speedup;
-                        spread_gas( cur, p, gas_percent_spread, outdoor_age_speedup, sblk );
+                        // Otherwise spread_gases_double_buffered has moved it already.
+                        spread_gas( cur, p, gas_percent_spread, outdoor_age_speedup, sblk,
+                                    !double_buffered_gas_spread.get() );
                     }
                 }
 
@@ -0,0 +1,321 @@
+#include "map_region_file.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#if defined(_WIN32)
+#   include <io.h>
+#else
+#   include <unistd.h>
+#endif
+
+#include "debug.h"
+#include "filesystem.h"
+#include "string_formatter.h"
+
+static const char region_magic[] = { 'C', 'D', 'D', 'A', 'R', 'E', 'G', 'N' };
+static constexpr uint32_t region_format_version = 1;
+static constexpr size_t entry_size = sizeof( uint64_t ) + sizeof( uint32_t );
+static constexpr size_t table_start = sizeof( region_magic ) + sizeof( uint32_t );
+static constexpr size_t header_size = table_start +
+                                      map_region_file::quads_per_region * entry_size;
+// Dead space is only reclaimed once there is more of it than live data, so the
+// rewrites cost O(1) per written byte on average.
+static constexpr uint64_t min_dead_space_to_compact = 256 * 1024;
+
+static void put_le( std::string &buffer, const uint64_t value, const size_t bytes )
+{
+    for( size_t i = 0; i < bytes; i++ ) {
+        buffer.push_back( static_cast<char>( ( value >> ( i * 8 ) ) & 0xff ) );
+    }
+}
+
+static uint64_t get_le( const char *const data, const size_t bytes )
+{
+    uint64_t result = 0;
+    for( size_t i = 0; i < bytes; i++ ) {
+        result |= static_cast<uint64_t>( static_cast<unsigned char>( data[i] ) ) << ( i * 8 );
+    }
+    return result;
+}
+
+static void check_header( const char *const header, const std::string &path )
+{
+    if( std::memcmp( header, region_magic, sizeof( region_magic ) ) != 0 ) {
+        throw std::runtime_error( string_format( "%s is not a map region file", path ) );
+    }
+    const uint64_t version = get_le( header + sizeof( region_magic ), sizeof( uint32_t ) );
+    if( version > region_format_version ) {
+        throw std::runtime_error( string_format( "%s has unsupported region format version %d", path,
+                                  version ) );
+    }
+}
+
+static size_t quad_index( const point &quad )
+{
+    if( quad.x < 0 || quad.x >= SEG_SIZE || quad.y < 0 || quad.y >= SEG_SIZE ) {
+        throw std::out_of_range( string_format( "quad %d,%d is outside of a map region",
+                                                quad.x, quad.y ) );
+    }
+    return quad.x + quad.y * SEG_SIZE;
+}
+
+/**
+ * Makes the OS write what was written to the file at @p path so far to the disk, a stream's
+ * flush only hands it to the OS. Syncing through another descriptor of the same file works.
+ */
+static void sync_file( const std::string &path )
+{
+#if defined(_WIN32)
+    const int fd = _open( path.c_str(), _O_RDWR | _O_BINARY );
+    bool ok = fd >= 0 && _commit( fd ) == 0;
+    ok = fd >= 0 && _close( fd ) == 0 && ok;
+#else
+    const int fd = open( path.c_str(), O_RDWR );
+    bool ok = fd >= 0 && fsync( fd ) == 0;
+    ok = fd >= 0 && close( fd ) == 0 && ok;
+#endif
+    if( !ok ) {
+        throw std::runtime_error( string_format( "syncing %s failed", path ) );
+    }
+}
+
+static void read_exactly( std::istream &fin, const uint64_t offset, char *const dest,
+                          const size_t size, const std::string &path )
+{
+    fin.seekg( offset );
+    fin.read( dest, size );
+    if( !fin || static_cast<size_t>( fin.gcount() ) != size ) {
+        throw std::runtime_error( string_format( "reading from %s failed, file truncated?", path ) );
+    }
+}
+
+map_region_file::map_region_file( const std::string &path ) : path( path )
+{
+    if( !file_exist( path ) ) {
+        return;
+    }
+    std::ifstream fin( path, std::ios::binary );
+    std::string header( header_size, '\0' );
+    read_exactly( fin, 0, &header[0], header_size, path );
+    check_header( header.data(), path );
+    for( size_t i = 0; i < quads_per_region; i++ ) {
+        const char *const entry = header.data() + table_start + i * entry_size;
+        table[i].offset = get_le( entry, sizeof( uint64_t ) );
+        table[i].size = get_le( entry + sizeof( uint64_t ), sizeof( uint32_t ) );
+    }
+    exists = true;
+}
+
+map_region_file::~map_region_file() = default;
+
+bool map_region_file::contains( const point &quad ) const
+{
+    return table[quad_index( quad )].size != 0;
+}
+
+std::vector<point> map_region_file::stored_quads() const
+{
+    std::vector<point> result;
+    for( size_t i = 0; i < quads_per_region; i++ ) {
+        if( table[i].size != 0 ) {
+            result.emplace_back( i % SEG_SIZE, i / SEG_SIZE );
+        }
+    }
+    return result;
+}
+
+std::string map_region_file::read( const point &quad )
+{
+    const table_entry &entry = table[quad_index( quad )];
+    if( entry.size == 0 ) {
+        throw std::runtime_error( string_format( "%s does not contain quad %d,%d", path, quad.x,
+                                  quad.y ) );
+    }
+    if( file.is_open() ) {
+        file.flush();
+    }
+    std::ifstream fin( path, std::ios::binary );
+    std::string data( entry.size, '\0' );
+    read_exactly( fin, entry.offset, &data[0], entry.size, path );
+    return data;
+}
+
+void map_region_file::open_for_writing()
+{
+    if( file.is_open() ) {
+        return;
+    }
+    if( !exists ) {
+        std::ofstream fout( path, std::ios::binary | std::ios::trunc );
+        std::string header( region_magic, sizeof( region_magic ) );
+        put_le( header, region_format_version, sizeof( uint32_t ) );
+        header.resize( header_size, '\0' );
+        fout.write( header.data(), header.size() );
+        if( !fout ) {
+            throw std::runtime_error( string_format( "creating %s failed", path ) );
+        }
+        exists = true;
+    }
+    file.open( path, std::ios::in | std::ios::out | std::ios::binary );
+    if( !file ) {
+        throw std::runtime_error( string_format( "opening %s failed", path ) );
+    }
+}
+
+void map_region_file::write( const point &quad, const std::string &data )
+{
+    table_entry &entry = table[quad_index( quad )];
+    if( data.empty() || data.size() > UINT32_MAX ) {
+        throw std::runtime_error( string_format( "invalid size %d of quad %d,%d for %s", data.size(),
+                                  quad.x, quad.y, path ) );
+    }
+    open_for_writing();
+    file.seekp( 0, std::ios::end );
+    entry.offset = file.tellp();
+    entry.size = data.size();
+    file.write( data.data(), data.size() );
+    if( !file ) {
+        throw std::runtime_error( string_format( "writing to %s failed", path ) );
+    }
+    dirty = true;
+}
+
+void map_region_file::erase( const point &quad )
+{
+    table_entry &entry = table[quad_index( quad )];
+    if( entry.size != 0 ) {
+        entry = table_entry();
+        dirty = true;
+    }
+}
+
+void map_region_file::flush()
+{
+    if( !dirty ) {
+        return;
+    }
+    open_for_writing();
+    // The data of changed quads has been appended behind everything the old table
+    // points to. Only once it's on disk, the table is updated in place, so every
+    // entry always points to complete data, old or new.
+    file.flush();
+    if( !file ) {
+        throw std::runtime_error( string_format( "writing to %s failed", path ) );
+    }
+    sync_file( path );
+    std::string table_data;
+    uint64_t live_size = 0;
+    for( const table_entry &entry : table ) {
+        put_le( table_data, entry.offset, sizeof( uint64_t ) );
+        put_le( table_data, entry.size, sizeof( uint32_t ) );
+        live_size += entry.size;
+    }
+    file.seekp( table_start );
+    file.write( table_data.data(), table_data.size() );
+    file.seekp( 0, std::ios::end );
+    const uint64_t file_size = file.tellp();
+    file.flush();
+    if( !file ) {
+        throw std::runtime_error( string_format( "writing to %s failed", path ) );
+    }
+    dirty = false;
+
+    const uint64_t dead_space = file_size - header_size - live_size;
+    if( dead_space >= min_dead_space_to_compact && dead_space > live_size ) {
+        try {
+            rewrite_without_dead_space();
+        } catch( const std::exception &err ) {
+            // The changes are saved already and the file is still intact, the next flush
+            // tries again.
+            file.close();
+            DebugLog( D_WARNING, D_MAP ) << "compacting " << path << " failed: " << err.what();
+        }
+    }
+}
+
+void map_region_file::compact()
+{
+    if( !exists ) {
+        return;
+    }
+    flush();
+    rewrite_without_dead_space();
+}
+
+void map_region_file::rewrite_without_dead_space()
+{
+    // The new file only replaces the old one once it's complete. If this stops
+    // midway, the old file is still intact.
+    open_for_writing();
+    file.flush();
+    const std::string temp_path = path + ".tmp";
+    std::array<table_entry, quads_per_region> new_table;
+    {
+        std::ofstream fout( temp_path, std::ios::binary | std::ios::trunc );
+        std::string header( region_magic, sizeof( region_magic ) );
+        put_le( header, region_format_version, sizeof( uint32_t ) );
+        header.resize( header_size, '\0' );
+        fout.write( header.data(), header.size() );
+
+        std::string data;
+        for( size_t i = 0; i < quads_per_region; i++ ) {
+            if( table[i].size == 0 ) {
+                continue;
+            }
+            data.resize( table[i].size );
+            read_exactly( file, table[i].offset, &data[0], data.size(), path );
+            new_table[i].offset = fout.tellp();
+            new_table[i].size = table[i].size;
+            fout.write( data.data(), data.size() );
+        }
+
+        header.resize( table_start );
+        for( const table_entry &entry : new_table ) {
+            put_le( header, entry.offset, sizeof( uint64_t ) );
+            put_le( header, entry.size, sizeof( uint32_t ) );
+        }
+        fout.seekp( 0 );
+        fout.write( header.data(), header.size() );
+        fout.close();
+        if( !fout ) {
+            remove_file( temp_path );
+            throw std::runtime_error( string_format( "writing to %s failed", temp_path ) );
+        }
+    }
+    // Otherwise the rename could reach the disk before the data it points to.
+    try {
+        sync_file( temp_path );
+    } catch( const std::exception & ) {
+        remove_file( temp_path );
+        throw;
+    }
+    file.close();
+    if( !rename_file( temp_path, path ) ) {
+        throw std::runtime_error( string_format( "replacing %s with the compacted file failed", path ) );
+    }
+    table = new_table;
+}
+
+cata::optional<std::string> map_region_file::read_quad( const std::string &path, const point &quad )
+{
+    if( !file_exist( path ) ) {
+        return cata::nullopt;
+    }
+    std::ifstream fin( path, std::ios::binary );
+    char header[table_start];
+    read_exactly( fin, 0, header, table_start, path );
+    check_header( header, path );
+
+    char entry[entry_size];
+    read_exactly( fin, table_start + quad_index( quad ) * entry_size, entry, entry_size, path );
+    const uint64_t offset = get_le( entry, sizeof( uint64_t ) );
+    const size_t size = get_le( entry + sizeof( uint64_t ), sizeof( uint32_t ) );
+    if( size == 0 ) {
+        return cata::nullopt;
+    }
+    std::string data( size, '\0' );
+    read_exactly( fin, offset, &data[0], size, path );
+    return data;
+}
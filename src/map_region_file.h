@@ -0,0 +1,89 @@
+#pragma once
+#ifndef CATA_SRC_MAP_REGION_FILE_H
+#define CATA_SRC_MAP_REGION_FILE_H
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "game_constants.h"
+#include "optional.h"
+#include "point.h"
+
+/**
+ * A region file packs the saved map quads of one segment (SEG_SIZE x SEG_SIZE overmap
+ * terrains on one z-level) into a single file, instead of one file per quad.
+ *
+ * The file starts with a fixed size header: magic bytes, a format version and an offset
+ * table with one (offset, size) entry per quad. The quad data itself is opaque to this
+ * class (it's whatever @ref mapbuffer serialized, in JSON or binary).
+ *
+ * Writing a quad appends its data at the end of the file and points the table entry at
+ * it, the previous data becomes dead space. @ref flush updates the table in place once the
+ * appended data has been synced to the disk, so the table on disk only ever points to
+ * complete data.
+ * When the dead space outgrows the live data, or on @ref compact, the live data is copied
+ * to a temporary file that then replaces the region file.
+ *
+ * Quads are addressed by their position inside the segment, both coordinates in
+ * [0, SEG_SIZE).
+ */
+class map_region_file
+{
+    public:
+        /** Opens the region file at @p path, it is created on the first write. */
+        explicit map_region_file( const std::string &path );
+        ~map_region_file();
+
+        map_region_file( const map_region_file & ) = delete;
+        map_region_file &operator=( const map_region_file & ) = delete;
+
+        bool contains( const point &quad ) const;
+        /** Quads stored in the file, in no particular order. */
+        std::vector<point> stored_quads() const;
+        /** @throws std::exception if the quad is not stored or reading fails. */
+        std::string read( const point &quad );
+        /** Stores the quad data (replacing any previous data). */
+        void write( const point &quad, const std::string &data );
+        /** Removes the quad from the table, its data becomes dead space. */
+        void erase( const point &quad );
+        /**
+         * Writes the new offset table, and drops the dead space if there is too much of it.
+         * Must be called after writing, otherwise the changes are lost.
+         * @throws std::exception on any failure.
+         */
+        void flush();
+        /**
+         * Flushes and rewrites the file without any dead space.
+         * @throws std::exception on any failure.
+         */
+        void compact();
+
+        /**
+         * Reads a single quad directly via its table entry, without loading the whole table.
+         * @returns nothing if the file doesn't exist or does not contain the quad.
+         * @throws std::exception if the file is corrupted.
+         */
+        static cata::optional<std::string> read_quad( const std::string &path, const point &quad );
+
+        static constexpr size_t quads_per_region = SEG_SIZE * SEG_SIZE;
+
+    private:
+        struct table_entry {
+            uint64_t offset = 0;
+            uint32_t size = 0;
+        };
+
+        std::string path;
+        std::array<table_entry, quads_per_region> table;
+        std::fstream file;
+        bool exists = false;
+        bool dirty = false;
+
+        void open_for_writing();
+        void rewrite_without_dead_space();
+};
+
+#endif // CATA_SRC_MAP_REGION_FILE_H
@@ -1,13 +1,17 @@
 #include "mapbuffer.h"
 
 #include <algorithm>
+#include <cstring>
 #include <exception>
 #include <functional>
+#include <iterator>
 #include <set>
 #include <sstream>
 #include <utility>
 #include <vector>
 
+#include "background_save.h"
+#include "binary_io.h"
 #include "cata_utility.h"
 #include "coordinate_conversions.h"
 #include "debug.h"
@@ -16,6 +20,8 @@
 #include "game_constants.h"
 #include "json.h"
 #include "map.h"
+#include "map_region_file.h"
+#include "options.h"
 #include "output.h"
 #include "popup.h"
 #include "string_formatter.h"
@@ -37,6 +43,172 @@ static std::string find_dirname( const tripoint &om_addr )
                           segment_addr.y, segment_addr.z );
 }
 
+static std::string find_region_path( const tripoint &om_addr )
+{
+    const tripoint segment_addr = omt_to_seg_copy( om_addr );
+    return string_format( "%s/maps/%d.%d.%d.region", g->get_world_base_save_path(), segment_addr.x,
+                          segment_addr.y, segment_addr.z );
+}
+
+/** Position of the quad inside its region file. */
+static point find_region_quad( const tripoint &om_addr )
+{
+    const tripoint segment_addr = omt_to_seg_copy( om_addr );
+    return om_addr.xy() - segment_addr.xy() * SEG_SIZE;
+}
+
+// Binary quad files start with this, anything else is read as JSON.
+static const char binary_quad_magic[] = { 'C', 'D', 'D', 'A', 'M', 'A', 'P', 'B' };
+static constexpr uint64_t binary_quad_format_version = 1;
+
+using saved_quad = std::vector<std::pair<tripoint, const submap *>>;
+using loaded_quad = std::vector<std::pair<tripoint, std::unique_ptr<submap>>>;
+
+static void write_json_quad( std::ostream &fout, const saved_quad &quad )
+{
+    JsonOut jsout( fout );
+    jsout.start_array();
+    for( const auto &entry : quad ) {
+        jsout.start_object();
+
+        jsout.member( "version", savegame_version );
+        jsout.member( "coordinates" );
+
+        jsout.start_array();
+        jsout.write( entry.first.x );
+        jsout.write( entry.first.y );
+        jsout.write( entry.first.z );
+        jsout.end_array();
+
+        entry.second->store( jsout );
+
+        jsout.end_object();
+    }
+    jsout.end_array();
+}
+
+/**
+ * Layout: the magic bytes, the format version, the uncompressed size of the payload and
+ * the @ref lz_compress ed payload. The payload contains the number of submaps and for each
+ * one the savegame version, its coordinates and its data (see @ref submap::store).
+ */
+static void write_binary_quad( std::ostream &fout, const saved_quad &quad )
+{
+    binary_out payload;
+    payload.write_uint( quad.size() );
+    for( const auto &entry : quad ) {
+        payload.write_int( savegame_version );
+        payload.write_int( entry.first.x );
+        payload.write_int( entry.first.y );
+        payload.write_int( entry.first.z );
+        entry.second->store( payload );
+    }
+
+    binary_out header;
+    header.write_bytes( binary_quad_magic, sizeof( binary_quad_magic ) );
+    header.write_uint( binary_quad_format_version );
+    header.write_uint( payload.data().size() );
+    const std::string compressed = lz_compress( payload.data() );
+    fout.write( header.data().data(), header.data().size() );
+    fout.write( compressed.data(), compressed.size() );
+}
+
+static void read_json_quad( JsonIn &jsin, loaded_quad &quad )
+{
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        std::unique_ptr<submap> sm = std::make_unique<submap>();
+        tripoint submap_coordinates;
+        jsin.start_object();
+        int version = 0;
+        while( !jsin.end_object() ) {
+            std::string submap_member_name = jsin.get_member_name();
+            if( submap_member_name == "version" ) {
+                version = jsin.get_int();
+            } else if( submap_member_name == "coordinates" ) {
+                jsin.start_array();
+                int locx = jsin.get_int();
+                int locy = jsin.get_int();
+                int locz = jsin.get_int();
+                jsin.end_array();
+                submap_coordinates = tripoint( locx, locy, locz );
+            } else {
+                sm->load( jsin, submap_member_name, version );
+            }
+        }
+        quad.emplace_back( submap_coordinates, std::move( sm ) );
+    }
+}
+
+// Expects the magic bytes to have been consumed already.
+static void read_binary_quad( std::istream &fin, loaded_quad &quad )
+{
+    const std::string data( ( std::istreambuf_iterator<char>( fin ) ),
+                            std::istreambuf_iterator<char>() );
+    binary_in header( data );
+    const uint64_t format_version = header.read_uint();
+    if( format_version > binary_quad_format_version ) {
+        throw binary_error( string_format( "unsupported binary map format version %d",
+                                           format_version ) );
+    }
+    const size_t payload_size = header.read_uint();
+    std::string compressed;
+    header.read_bytes( compressed, data.size() - header.offset() );
+    const std::string payload = lz_decompress( compressed, payload_size );
+
+    binary_in in( payload );
+    for( uint64_t count = in.read_uint(); count > 0; count-- ) {
+        const int version = static_cast<int>( in.read_int() );
+        tripoint submap_coordinates;
+        submap_coordinates.x = static_cast<int>( in.read_int() );
+        submap_coordinates.y = static_cast<int>( in.read_int() );
+        submap_coordinates.z = static_cast<int>( in.read_int() );
+        std::unique_ptr<submap> sm = std::make_unique<submap>();
+        sm->load( in, version );
+        quad.emplace_back( submap_coordinates, std::move( sm ) );
+    }
+}
+
+/** Reads a quad in either format, returns whether it was in the binary one. */
+static bool read_quad( std::istream &fin, loaded_quad &quad )
+{
+    char magic[sizeof( binary_quad_magic )];
+    fin.read( magic, sizeof( magic ) );
+    if( fin.gcount() == sizeof( magic ) &&
+        std::memcmp( magic, binary_quad_magic, sizeof( magic ) ) == 0 ) {
+        read_binary_quad( fin, quad );
+        return true;
+    }
+    fin.clear();
+    fin.seekg( 0 );
+    JsonIn jsin( fin );
+    read_json_quad( jsin, quad );
+    return false;
+}
+
+static std::string quad_to_string( const saved_quad &quad, const bool binary )
+{
+    std::ostringstream fout;
+    if( binary ) {
+        write_binary_quad( fout, quad );
+    } else {
+        write_json_quad( fout, quad );
+    }
+    return fout.str();
+}
+
+using region_files = std::map<std::string, std::unique_ptr<map_region_file>>;
+
+static map_region_file &get_region_file( region_files &regions, const std::string &path )
+{
+    auto iter = regions.find( path );
+    if( iter == regions.end() ) {
+        // Only added once it could be opened.
+        iter = regions.emplace( path, std::make_unique<map_region_file>( path ) ).first;
+    }
+    return *iter->second;
+}
+
 mapbuffer MAPBUFFER;
 
 mapbuffer::mapbuffer() = default;
@@ -117,7 +289,178 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
     return iter->second;
 }
 
-void mapbuffer::save( bool delete_after_save )
+static void write_quad_file( const tripoint &om_addr, const std::string &data )
+{
+    const std::string dirname = find_dirname( om_addr );
+    // Don't create the directory if it would be empty
+    assure_dir_exist( dirname );
+    write_to_file( find_quad_path( dirname, om_addr ), [&]( std::ostream & fout ) {
+        fout << data;
+    } );
+}
+
+/**
+ * Writes the quads of one @ref mapbuffer::save into their region files, or with region files
+ * disabled, into separate quad files while dropping the outdated copies from the region files.
+ * The region files are only written in @ref finish. Quads whose region file can't be written
+ * are saved as separate files instead.
+ */
+class region_quad_saver
+{
+    public:
+        /** @p reserialize gives the data of a quad again, if it has to go elsewhere. */
+        region_quad_saver( const bool use_regions,
+                           const std::function<std::string( const tripoint & )> &reserialize ) :
+            use_regions( use_regions ), reserialize( reserialize ) {
+        }
+
+        void save_quad( const tripoint &om_addr, const std::string &quad_path,
+                        const std::string &data ) {
+            const std::string region_path = find_region_path( om_addr );
+            const point region_quad = find_region_quad( om_addr );
+            const auto failed_region = failed_regions.find( region_path );
+            if( failed_region != failed_regions.end() ) {
+                // Without region files, what the broken file still has is unknown.
+                save_quad_file( om_addr, data, !use_regions ||
+                                failed_region->second.count( region_quad ) != 0 );
+            } else if( use_regions ) {
+                bool stored_in_region = false;
+                try {
+                    map_region_file &region = get_region_file( regions, region_path );
+                    stored_in_region = region.contains( region_quad );
+                    if( !stored_in_region ) {
+                        obsolete_quad_files[region_path].push_back( quad_path );
+                    }
+                    region.write( region_quad, data );
+                    region_quads[region_path].emplace_back( om_addr, stored_in_region );
+                } catch( const std::exception &err ) {
+                    give_up_region( region_path, err );
+                    save_quad_file( om_addr, data, stored_in_region );
+                }
+            } else {
+                save_quad_file( om_addr, data, false );
+                // The region file is checked first when loading, drop the outdated copy there
+                // (if the option was enabled before).
+                if( missing_regions.count( region_path ) != 0 ) {
+                    return;
+                }
+                try {
+                    if( regions.count( region_path ) != 0 || file_exist( region_path ) ) {
+                        get_region_file( regions, region_path ).erase( region_quad );
+                    } else {
+                        missing_regions.insert( region_path );
+                    }
+                } catch( const std::exception &err ) {
+                    debugmsg( "Failed to remove outdated map quads from %s: %s", region_path,
+                              err.what() );
+                    failed_regions.emplace( region_path, std::set<point>() );
+                    unsaved_quads.insert( om_addr );
+                }
+            }
+        }
+
+        /**
+         * Writes the region files and removes the quad files they replace.
+         * @param saved_quads All the quads of this save, in case a region file can't drop
+         * the outdated copies of them.
+         */
+        void finish( const std::set<tripoint> &saved_quads ) {
+            for( auto iter = regions.begin(); iter != regions.end(); ) {
+                // give_up_region removes the file from regions.
+                const std::string region_path = iter->first;
+                map_region_file &region = *iter->second;
+                ++iter;
+                try {
+                    region.flush();
+                } catch( const std::exception &err ) {
+                    if( use_regions ) {
+                        give_up_region( region_path, err );
+                        continue;
+                    }
+                    debugmsg( "Failed to remove outdated map quads from %s: %s", region_path,
+                              err.what() );
+                    for( const tripoint &om_addr : saved_quads ) {
+                        if( find_region_path( om_addr ) == region_path ) {
+                            unsaved_quads.insert( om_addr );
+                        }
+                    }
+                }
+            }
+            for( const auto &region : obsolete_quad_files ) {
+                for( const std::string &path : region.second ) {
+                    // An earlier background save may still be writing the file.
+                    background_save::wait_for( path );
+                    if( file_exist( path ) ) {
+                        remove_file( path );
+                    }
+                }
+            }
+        }
+
+        /** Quads that could not be saved, their submaps have to stay in memory. */
+        const std::set<tripoint> &get_unsaved_quads() const {
+            return unsaved_quads;
+        }
+
+    private:
+        const bool use_regions;
+        const std::function<std::string( const tripoint & )> reserialize;
+        // Region files touched by this save, they are only written at the end.
+        region_files regions;
+        // The quads written into each region file (and whether it had them before), and the
+        // separate quad files they replace.
+        std::map<std::string, std::vector<std::pair<tripoint, bool>>> region_quads;
+        std::map<std::string, std::vector<std::string>> obsolete_quad_files;
+        // Region files that can't be written, their quads are saved as separate files instead.
+        // Mapped to the quads the file still has an outdated copy of.
+        std::map<std::string, std::set<point>> failed_regions;
+        // Region files that don't exist, so there's nothing to erase from them.
+        std::set<std::string> missing_regions;
+        std::set<tripoint> unsaved_quads;
+
+        // The region file is checked first when loading, a quad it still has an older copy of
+        // would be loaded instead of the separate file.
+        void save_quad_file( const tripoint &om_addr, const std::string &data,
+                             const bool outdated_in_region ) {
+            try {
+                write_quad_file( om_addr, data );
+            } catch( const std::exception &err ) {
+                debugmsg( "Failed to save map quad %d,%d,%d: %s", om_addr.x, om_addr.y, om_addr.z,
+                          err.what() );
+                unsaved_quads.insert( om_addr );
+            }
+            if( outdated_in_region ) {
+                unsaved_quads.insert( om_addr );
+            }
+        }
+
+        // Saves the quads written into a region file by this save as separate files instead.
+        void give_up_region( const std::string &region_path, const std::exception &err ) {
+            debugmsg( "Failed to write map region %s, saving its quads as separate files: %s",
+                      region_path, err.what() );
+            std::set<point> &outdated = failed_regions[region_path];
+            const auto iter = regions.find( region_path );
+            if( iter != regions.end() ) {
+                const std::vector<point> stored = iter->second->stored_quads();
+                outdated.insert( stored.begin(), stored.end() );
+                regions.erase( iter );
+            }
+            std::vector<std::pair<tripoint, bool>> &written = region_quads[region_path];
+            // Quads that weren't in the file before are only in its unwritten table.
+            for( const std::pair<tripoint, bool> &quad : written ) {
+                if( !quad.second ) {
+                    outdated.erase( find_region_quad( quad.first ) );
+                }
+            }
+            for( const std::pair<tripoint, bool> &quad : written ) {
+                save_quad_file( quad.first, reserialize( quad.first ), quad.second );
+            }
+            region_quads.erase( region_path );
+            obsolete_quad_files.erase( region_path );
+        }
+};
+
+bool mapbuffer::save( bool delete_after_save )
 {
     assure_dir_exist( g->get_world_base_save_path() + "/maps" );
 
@@ -128,13 +471,22 @@ void mapbuffer::save( bool delete_after_save )
     const bool map_has_zlevels = g != nullptr && g->m.has_zlevels();
 
     static_popup popup;
+    // Background saves must not block on redrawing the progress popup.
+    const bool show_progress = !background_save::is_deferring();
+
+    const bool binary = get_option<bool>( "BINARY_MAP_STORAGE" );
+    region_quad_saver quad_saver( get_option<bool>( "MAP_REGION_FILES" ),
+    [this, binary]( const tripoint & om_addr ) {
+        std::list<tripoint> ignored;
+        return *serialize_quad( om_addr, ignored, false, binary );
+    } );
 
     // A set of already-saved submaps, in global overmap coordinates.
     std::set<tripoint> saved_submaps;
     std::list<tripoint> submaps_to_delete;
     int next_report = 0;
     for( auto &elem : submaps ) {
-        if( num_total_submaps > 100 && num_saved_submaps >= next_report ) {
+        if( show_progress && num_total_submaps > 100 && num_saved_submaps >= next_report ) {
             popup.message( _( "Please wait as the map saves [%d/%d]" ),
                            num_saved_submaps, num_total_submaps );
             ui_manager::redraw();
@@ -162,21 +514,28 @@ void mapbuffer::save( bool delete_after_save )
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
         const bool zlev_del = !map_has_zlevels && om_addr.z != g->get_levz();
-        save_quad( dirname, quad_path, om_addr, submaps_to_delete,
-                   delete_after_save || zlev_del ||
-                   om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
-                   om_addr.x > map_origin.x + HALF_MAPSIZE ||
-                   om_addr.y > map_origin.y + HALF_MAPSIZE );
+        const cata::optional<std::string> data = serialize_quad( om_addr, submaps_to_delete,
+                delete_after_save || zlev_del ||
+                om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
+                om_addr.x > map_origin.x + HALF_MAPSIZE ||
+                om_addr.y > map_origin.y + HALF_MAPSIZE, binary );
         num_saved_submaps += 4;
+        if( data ) {
+            quad_saver.save_quad( om_addr, quad_path, *data );
+        }
     }
+    quad_saver.finish( saved_submaps );
+    const std::set<tripoint> &unsaved_quads = quad_saver.get_unsaved_quads();
     for( auto &elem : submaps_to_delete ) {
-        remove_submap( elem );
+        if( unsaved_quads.count( sm_to_omt_copy( elem ) ) == 0 ) {
+            remove_submap( elem );
+        }
     }
+    return unsaved_quads.empty();
 }
 
-void mapbuffer::save_quad( const std::string &dirname, const std::string &filename,
-                           const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                           bool delete_after_save )
+cata::optional<std::string> mapbuffer::serialize_quad( const tripoint &om_addr,
+        std::list<tripoint> &submaps_to_delete, bool delete_after_save, bool binary )
 {
     std::vector<point> offsets;
     std::vector<tripoint> submap_addrs;
@@ -207,55 +566,142 @@ void mapbuffer::save_quad( const std::string &dirname, const std::string &filena
             }
         }
 
-        return;
+        return cata::nullopt;
     }
 
-    // Don't create the directory if it would be empty
-    assure_dir_exist( dirname );
-    write_to_file( filename, [&]( std::ostream & fout ) {
-        JsonOut jsout( fout );
-        jsout.start_array();
-        for( auto &submap_addr : submap_addrs ) {
-            if( submaps.count( submap_addr ) == 0 ) {
-                continue;
-            }
-
-            submap *sm = submaps[submap_addr];
+    saved_quad quad;
+    for( auto &submap_addr : submap_addrs ) {
+        if( submaps.count( submap_addr ) == 0 ) {
+            continue;
+        }
 
-            if( sm == nullptr ) {
-                continue;
-            }
+        submap *sm = submaps[submap_addr];
 
-            jsout.start_object();
+        if( sm == nullptr ) {
+            continue;
+        }
 
-            jsout.member( "version", savegame_version );
-            jsout.member( "coordinates" );
+        quad.emplace_back( submap_addr, sm );
 
-            jsout.start_array();
-            jsout.write( submap_addr.x );
-            jsout.write( submap_addr.y );
-            jsout.write( submap_addr.z );
-            jsout.end_array();
+        if( delete_after_save ) {
+            submaps_to_delete.push_back( submap_addr );
+        }
+    }
 
-            sm->store( jsout );
+    return quad_to_string( quad, binary );
+}
 
-            jsout.end_object();
+int mapbuffer::convert_saved_quads( const bool to_binary, const bool to_regions )
+{
+    int converted = 0;
+    const std::string maps_dir = g->get_world_base_save_path() + "/maps";
+
+    // Separate quad files first, they are rewritten or moved into region files.
+    region_files regions;
+    std::vector<std::string> obsolete_quad_files;
+    for( const std::string &path : get_files_from_path( ".map", maps_dir, true, true ) ) {
+        loaded_quad loaded;
+        bool is_binary = false;
+        if( !read_from_file_optional( path, [&]( std::istream & fin ) {
+        is_binary = read_quad( fin, loaded );
+        } ) || loaded.empty() ) {
+            // Already reported, leave the file as it is.
+            continue;
+        }
+        if( is_binary == to_binary && !to_regions ) {
+            continue;
+        }
+        saved_quad quad;
+        for( const auto &entry : loaded ) {
+            quad.emplace_back( entry.first, entry.second.get() );
+        }
+        const std::string data = quad_to_string( quad, to_binary );
+        if( to_regions ) {
+            const tripoint om_addr = sm_to_omt_copy( loaded.front().first );
+            get_region_file( regions, find_region_path( om_addr ) ).write( find_region_quad( om_addr ),
+                    data );
+            obsolete_quad_files.push_back( path );
+            converted++;
+        } else if( write_to_file( path, [&]( std::ostream & fout ) {
+        fout << data;
+    }, _( "map data" ) ) ) {
+            converted++;
+        }
+    }
+    for( auto &region : regions ) {
+        region.second->flush();
+    }
+    for( const std::string &path : obsolete_quad_files ) {
+        remove_file( path );
+    }
 
-            if( delete_after_save ) {
-                submaps_to_delete.push_back( submap_addr );
+    // Then the quads in region files, they are rewritten or unpacked into separate files.
+    for( const std::string &path : get_files_from_path( ".region", maps_dir, false, true ) ) {
+        try {
+            map_region_file region( path );
+            for( const point &region_quad : region.stored_quads() ) {
+                std::istringstream fin( region.read( region_quad ) );
+                loaded_quad loaded;
+                const bool is_binary = read_quad( fin, loaded );
+                if( loaded.empty() || ( is_binary == to_binary && to_regions ) ) {
+                    continue;
+                }
+                saved_quad quad;
+                for( const auto &entry : loaded ) {
+                    quad.emplace_back( entry.first, entry.second.get() );
+                }
+                const std::string data = quad_to_string( quad, to_binary );
+                if( to_regions ) {
+                    region.write( region_quad, data );
+                } else {
+                    const tripoint om_addr = sm_to_omt_copy( loaded.front().first );
+                    const std::string dirname = find_dirname( om_addr );
+                    assure_dir_exist( dirname );
+                    write_to_file( find_quad_path( dirname, om_addr ), [&]( std::ostream & fout ) {
+                        fout << data;
+                    } );
+                    region.erase( region_quad );
+                }
+                converted++;
+            }
+            // This rewrites everything anyway, so drop the dead space as well.
+            region.compact();
+            if( region.stored_quads().empty() ) {
+                remove_file( path );
             }
+        } catch( const std::exception &err ) {
+            debugmsg( "Failed to convert map region %s: %s", path, err.what() );
         }
-
-        jsout.end_array();
-    } );
+    }
+    return converted;
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
-// seeking around in them, so we're using the json streaming API.
+// seeking around in them, so we're using the json streaming API (or the binary format).
 submap *mapbuffer::unserialize_submaps( const tripoint &p )
 {
     // Map the tripoint to the submap quad that stores it.
     const tripoint om_addr = sm_to_omt_copy( p );
+    loaded_quad quad;
+    const std::string region_path = find_region_path( om_addr );
+    bool loaded_from_region = false;
+    try {
+        const cata::optional<std::string> region_data =
+            map_region_file::read_quad( region_path, find_region_quad( om_addr ) );
+        if( region_data ) {
+            std::istringstream fin( *region_data );
+            read_quad( fin, quad );
+            loaded_from_region = true;
+        }
+    } catch( const std::exception &err ) {
+        // Try the separate quad file instead, or generate the quad anew.
+        debugmsg( _( "Failed to read from \"%1$s\": %2$s" ), region_path, err.what() );
+        quad.clear();
+    }
+    if( loaded_from_region ) {
+        return add_loaded_quad( quad, p, region_path );
+    }
+
     const std::string dirname = find_dirname( om_addr );
     std::string quad_path = find_quad_path( dirname, om_addr );
 
@@ -271,46 +717,29 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
         }
     }
 
-    using namespace std::placeholders;
-    if( !read_from_file_optional_json( quad_path, std::bind( &mapbuffer::deserialize, this, _1 ) ) ) {
+    if( !read_from_file_optional( quad_path, [&quad]( std::istream & fin ) {
+    read_quad( fin, quad );
+    } ) ) {
         // If it doesn't exist, trigger generating it.
         return nullptr;
     }
-    if( submaps.count( p ) == 0 ) {
-        debugmsg( "file %s did not contain the expected submap %d,%d,%d",
-                  quad_path, p.x, p.y, p.z );
-        return nullptr;
-    }
-    return submaps[ p ];
+    return add_loaded_quad( quad, p, quad_path );
 }
 
-void mapbuffer::deserialize( JsonIn &jsin )
+submap *mapbuffer::add_loaded_quad( std::vector<std::pair<tripoint, std::unique_ptr<submap>>> &quad,
+                                    const tripoint &p, const std::string &quad_path )
 {
-    jsin.start_array();
-    while( !jsin.end_array() ) {
-        std::unique_ptr<submap> sm = std::make_unique<submap>();
-        tripoint submap_coordinates;
-        jsin.start_object();
-        int version = 0;
-        while( !jsin.end_object() ) {
-            std::string submap_member_name = jsin.get_member_name();
-            if( submap_member_name == "version" ) {
-                version = jsin.get_int();
-            } else if( submap_member_name == "coordinates" ) {
-                jsin.start_array();
-                int locx = jsin.get_int();
-                int locy = jsin.get_int();
-                int locz = jsin.get_int();
-                jsin.end_array();
-                submap_coordinates = tripoint( locx, locy, locz );
-            } else {
-                sm->load( jsin, submap_member_name, version );
-            }
-        }
-
-        if( !add_submap( submap_coordinates, sm ) ) {
+    for( auto &entry : quad ) {
+        const tripoint &submap_coordinates = entry.first;
+        if( !add_submap( submap_coordinates, entry.second ) ) {
             debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
                       submap_coordinates.z );
         }
     }
+    if( submaps.count( p ) == 0 ) {
+        debugmsg( "file %s did not contain the expected submap %d,%d,%d",
+                  quad_path, p.x, p.y, p.z );
+        return nullptr;
+    }
+    return submaps[ p ];
 }
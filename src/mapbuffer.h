@@ -6,11 +6,13 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "optional.h"
 #include "point.h"
 
 class submap;
-class JsonIn;
 
 /**
  * Store, buffer, save and load the entire world map.
@@ -24,8 +26,20 @@ class mapbuffer
         /** Store all submaps in this instance into savefiles.
          * @param delete_after_save If true, the saved submaps are removed
          * from the mapbuffer (and deleted).
+         * If a region file can't be written, its quads are saved as separate files instead.
+         * Quads that could not be saved at all are reported via debugmsg and stay in the buffer.
+         * @return Whether all submaps have been saved.
          **/
-        void save( bool delete_after_save = false );
+        bool save( bool delete_after_save = false );
+
+        /**
+         * Rewrites all saved map quads of the current world in the binary (or JSON) format
+         * and moves them into region files (or unpacks them into separate files).
+         * Quads that are already stored as requested are skipped. Submaps in this
+         * buffer are not touched, they should be saved first.
+         * @return The number of converted quads.
+         */
+        int convert_saved_quads( bool to_binary, bool to_regions );
 
         /** Delete all buffered submaps. **/
         void reset();
@@ -73,10 +87,15 @@ class mapbuffer
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( tripoint addr );
         submap *unserialize_submaps( const tripoint &p );
-        void deserialize( JsonIn &jsin );
-        void save_quad( const std::string &dirname, const std::string &filename,
-                        const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                        bool delete_after_save );
+        /** Adds the submaps read from @p quad_path, returns the one at @p p (if any). */
+        submap *add_loaded_quad( std::vector<std::pair<tripoint, std::unique_ptr<submap>>> &quad,
+                                 const tripoint &p, const std::string &quad_path );
+        /**
+         * Serializes the quad at @p om_addr (JSON or binary).
+         * @returns nothing if the quad doesn't need to be saved.
+         */
+        cata::optional<std::string> serialize_quad( const tripoint &om_addr,
+                std::list<tripoint> &submaps_to_delete, bool delete_after_save, bool binary );
         submap_map_t submaps;
 };
 
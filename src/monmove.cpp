@@ -304,6 +304,8 @@ void monster::plan()
     bool smart_planning = has_flag( MF_PRIORITIZE_TARGETS );
     Creature *target = nullptr;
     int max_sight_range = std::max( type->vision_day, type->vision_night );
+    // Creatures farther away can't be seen, so rate_target gives them FLT_MAX.
+    const int target_search_range = std::max( max_sight_range, 1 );
     // 8.6f is rating for tank drone 60 tiles away, moose 16 or boomer 33
     float dist = !smart_planning ? max_sight_range : 8.6f;
     bool fleeing = false;
@@ -344,12 +346,16 @@ void monster::plan()
                 }
             }
         }
-        if( angers_cub_threatened > 0 ) {
-            for( monster &tmp : g->all_monsters() ) {
-                if( type->baby_monster == tmp.type->id ) {
+        if( angers_cub_threatened > 0 && type->baby_monster.is_valid() ) {
+            // Only babies that can see the player can feel threatened.
+            const mtype &baby_type = type->baby_monster.obj();
+            const int baby_sight_range = std::max( { baby_type.vision_day, baby_type.vision_night, 1 } );
+            for( const shared_ptr_fast<monster> &tmp :
+                 g->critter_tracker->monsters_within( g->u.pos(), baby_sight_range ) ) {
+                if( type->baby_monster == tmp->type->id ) {
                     // baby nearby; is the player too close?
-                    dist = tmp.rate_target( g->u, dist, smart_planning );
-                    if( dist <= 3 ) {
+                    const float baby_dist = tmp->rate_target( g->u, dist, smart_planning );
+                    if( baby_dist <= 3 ) {
                         //proximity to baby; monster gets furious and less likely to flee
                         anger += angers_cub_threatened;
                         morale += angers_cub_threatened / 2;
@@ -358,11 +364,12 @@ void monster::plan()
             }
         }
     } else if( friendly != 0 && !docile ) {
-        for( monster &tmp : g->all_monsters() ) {
-            if( tmp.friendly == 0 ) {
-                float rating = rate_target( tmp, dist, smart_planning );
+        for( const shared_ptr_fast<monster> &tmp :
+             g->critter_tracker->monsters_within( pos(), target_search_range ) ) {
+            if( tmp->friendly == 0 ) {
+                float rating = rate_target( *tmp, dist, smart_planning );
                 if( rating < dist ) {
-                    target = &tmp;
+                    target = tmp.get();
                     dist = rating;
                 }
             }
@@ -426,33 +433,42 @@ void monster::plan()
 
     fleeing = fleeing || ( mood == MATT_FLEE );
     if( friendly == 0 ) {
+        const auto rate_hostile = [&]( monster & mon ) {
+            float rating = rate_target( mon, dist, smart_planning );
+            if( rating == dist ) {
+                ++valid_targets;
+                if( one_in( valid_targets ) ) {
+                    target = &mon;
+                }
+            }
+            if( rating < dist ) {
+                target = &mon;
+                dist = rating;
+                valid_targets = 1;
+            }
+            if( rating <= 5 ) {
+                anger += angers_hostile_near;
+                morale -= fears_hostile_near;
+            }
+        };
         for( const auto &fac : factions ) {
             auto faction_att = faction.obj().attitude( fac.first );
             if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
                 continue;
             }
 
+            if( dist < FLT_MAX ) {
+                // Unseen monsters can't tie with or beat the current rating.
+                for( const shared_ptr_fast<monster> &shared :
+                     g->critter_tracker->monsters_of_faction_within( fac.first, pos(), target_search_range ) ) {
+                    rate_hostile( *shared );
+                }
+                continue;
+            }
             for( const weak_ptr_fast<monster> &weak : fac.second ) {
                 const shared_ptr_fast<monster> shared = weak.lock();
-                if( !shared ) {
-                    continue;
-                }
-                monster &mon = *shared;
-                float rating = rate_target( mon, dist, smart_planning );
-                if( rating == dist ) {
-                    ++valid_targets;
-                    if( one_in( valid_targets ) ) {
-                        target = &mon;
-                    }
-                }
-                if( rating < dist ) {
-                    target = &mon;
-                    dist = rating;
-                    valid_targets = 1;
-                }
-                if( rating <= 5 ) {
-                    anger += angers_hostile_near;
-                    morale -= fears_hostile_near;
+                if( shared ) {
+                    rate_hostile( *shared );
                 }
             }
         }
@@ -471,11 +487,9 @@ void monster::plan()
     }
     swarms = swarms && target == nullptr; // Only swarm if we have no target
     if( group_morale || swarms ) {
-        for( const weak_ptr_fast<monster> &weak : myfaction_iter->second ) {
-            const shared_ptr_fast<monster> shared = weak.lock();
-            if( !shared ) {
-                continue;
-            }
+        // Only monsters in sight have a rating that matters here.
+        for( const shared_ptr_fast<monster> &shared :
+             g->critter_tracker->monsters_of_faction_within( actual_faction, pos(), target_search_range ) ) {
             monster &mon = *shared;
             float rating = rate_target( mon, dist, smart_planning );
             if( group_morale && rating <= 10 ) {
@@ -783,14 +797,26 @@ void monster::move()
         }
 
         const auto &pf_settings = get_pathfinding_settings();
-        if( pf_settings.max_dist >= rl_dist( pos(), goal ) &&
-            ( path.empty() || rl_dist( pos(), path.front() ) >= 2 || path.back() != goal ) ) {
-            // We need a new path
-            path = g->m.route( pos(), goal, pf_settings, get_path_avoid() );
+        cata::optional<tripoint> flow_step;
+        if( pf_settings.max_dist >= rl_dist( pos(), goal ) ) {
+            if( goal.z == posz() && get_path_avoid().empty() ) {
+                // Monsters converging on the same target share one flow field instead of searching alone
+                flow_step = g->m.flow_step( pos(), goal, pf_settings );
+            }
+            if( flow_step ) {
+                path.clear();
+            } else if( path.empty() || rl_dist( pos(), path.front() ) >= 2 || path.back() != goal ) {
+                // We need a new path
+                path = g->m.route( pos(), goal, pf_settings, get_path_avoid() );
+            }
         }
 
-        // Try to respect old paths, even if we can't pathfind at the moment
-        if( !path.empty() && path.back() == goal ) {
+        if( flow_step ) {
+            destination = *flow_step;
+            moved = true;
+            pathed = true;
+        } else if( !path.empty() && path.back() == goal ) {
+            // Try to respect old paths, even if we can't pathfind at the moment
             destination = path.front();
             moved = true;
             pathed = true;
@@ -161,6 +161,8 @@ static const mtype_id mon_zombie_technician( "mon_zombie_technician" );
 static const mtype_id mon_zombie_tough( "mon_zombie_tough" );
 static const mtype_id mon_zombie_waif( "mon_zombie_waif" );
 
+static const option_ref<float> monster_upgrade_factor( "MONSTER_UPGRADE_FACTOR" );
+
 struct pathfinding_settings;
 
 // Limit the number of iterations for next upgrade_time calculations.
@@ -302,7 +304,7 @@ void monster::poly( const mtype_id &id )
 
 bool monster::can_upgrade()
 {
-    return upgrades && get_option<float>( "MONSTER_UPGRADE_FACTOR" ) > 0.0;
+    return upgrades && monster_upgrade_factor.get() > 0.0;
 }
 
 // For master special attack.
@@ -312,7 +314,7 @@ void monster::hasten_upgrade()
         return;
     }
 
-    const int scaled_half_life = type->half_life * get_option<float>( "MONSTER_UPGRADE_FACTOR" );
+    const int scaled_half_life = type->half_life * monster_upgrade_factor.get();
     upgrade_time -= rng( 1, scaled_half_life );
     if( upgrade_time < 0 ) {
         upgrade_time = 0;
@@ -337,7 +339,7 @@ int monster::next_upgrade_time()
     if( type->age_grow > 0 ) {
         return type->age_grow;
     }
-    const int scaled_half_life = type->half_life * get_option<float>( "MONSTER_UPGRADE_FACTOR" );
+    const int scaled_half_life = type->half_life * monster_upgrade_factor.get();
     int day = 1; // 1 day of guaranteed evolve time
     for( int i = 0; i < UPGRADE_MAX_ITERS; i++ ) {
         if( one_in( 2 ) ) {
@@ -783,6 +783,28 @@ struct npc_chatbin {
     void deserialize( JsonIn &jsin );
 };
 
+class npc;
+
+/**
+ * The part of the search for items that is the same for all NPCs searching in a turn:
+ * who could witness an NPC taking items that aren't theirs, and which squares those
+ * witnesses can see. Built once per turn and kept by the game, see npc::find_item.
+ */
+struct npc_loot_scan {
+    time_point turn = calendar::before_time_starts;
+    // The followers are looked up again when someone joins or leaves during the turn.
+    std::set<character_id> follower_ids;
+    // Not owned, the followers can be unloaded during the turn.
+    std::vector<weak_ptr_fast<npc>> followers;
+    // Where the player and the followers were when witnessed_squares was filled.
+    std::vector<tripoint> witness_positions;
+    // Whether a witness sees the square, by absolute position.
+    std::unordered_map<tripoint, bool> witnessed_squares;
+
+    /** Whether the player or one of their followers can see @p p. */
+    bool witnessed( const tripoint &p );
+};
+
 class npc_template;
 
 class npc : public player
@@ -9,7 +9,11 @@
 #include <memory>
 #include <numeric>
 #include <ostream>
+#include <set>
+#include <string>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include "active_item_cache.h"
 #include "activity_handlers.h"
@@ -2720,6 +2724,50 @@ void npc::see_item_say_smth( const itype_id &object, const std::string &smth )
     }
 }
 
+bool npc_loot_scan::witnessed( const tripoint &p )
+{
+    const auto iter = witnessed_squares.emplace( g->m.getabs( p ), false );
+    if( iter.second ) {
+        iter.first->second = g->u.sees( p ) ||
+        std::any_of( followers.begin(), followers.end(), [&p]( const weak_ptr_fast<npc> &guy ) {
+            const shared_ptr_fast<npc> witness = guy.lock();
+            return witness && witness->sees( p );
+        } );
+    }
+    return iter.first->second;
+}
+
+static npc_loot_scan &current_loot_scan()
+{
+    npc_loot_scan &scan = g->loot_scan();
+    std::set<character_id> follower_ids = g->get_follower_list();
+    const bool follower_unloaded = std::any_of( scan.followers.begin(), scan.followers.end(),
+    []( const weak_ptr_fast<npc> &guy ) {
+        return guy.expired();
+    } );
+    if( scan.turn != calendar::turn || follower_ids != scan.follower_ids || follower_unloaded ) {
+        scan.turn = calendar::turn;
+        scan.follower_ids = std::move( follower_ids );
+        scan.followers.clear();
+        scan.witnessed_squares.clear();
+        for( const character_id &id : scan.follower_ids ) {
+            if( shared_ptr_fast<npc> guy = overmap_buffer.find_npc( id ) ) {
+                scan.followers.push_back( guy );
+            }
+        }
+    }
+    // A witness that moved (e.g. a follower that took its turn) sees other squares.
+    std::vector<tripoint> witness_positions{ g->u.global_square_location() };
+    for( const weak_ptr_fast<npc> &guy : scan.followers ) {
+        witness_positions.push_back( guy.lock()->global_square_location() );
+    }
+    if( witness_positions != scan.witness_positions ) {
+        scan.witness_positions = std::move( witness_positions );
+        scan.witnessed_squares.clear();
+    }
+    return scan;
+}
+
 void npc::find_item()
 {
     if( is_hallucination() ) {
@@ -2734,7 +2782,7 @@ void npc::find_item()
     }
 
     fetching_item = false;
-    int best_value = minimum_item_value();
+    const int min_value = minimum_item_value();
     // Not perfect, but has to mirror pickup code
     units::volume volume_allowed = volume_capacity() - volume_carried();
     units::mass   weight_allowed = weight_capacity() - weight_carried();
@@ -2753,50 +2801,43 @@ void npc::find_item()
         return;
     }
 
+    // Items worth picking up, the best one nobody sees us steal gets picked.
+    struct candidate {
+        const item *it;
+        tripoint pos;
+        int value;
+    };
+    std::vector<candidate> candidates;
     const auto consider_item =
-        [&wanted, &best_value, whitelisting, volume_allowed, weight_allowed, this]
+        [&candidates, min_value, whitelisting, volume_allowed, weight_allowed, this]
     ( const item & it, const tripoint & p ) {
         if( it.made_of_from_type( LIQUID ) ) {
             // Don't even consider liquids.
-            return;
-        }
-        std::vector<npc *> followers;
-        for( auto &elem : g->get_follower_list() ) {
-            shared_ptr_fast<npc> npc_to_get = overmap_buffer.find_npc( elem );
-            if( !npc_to_get ) {
-                continue;
-            }
-            npc *npc_to_add = npc_to_get.get();
-            followers.push_back( npc_to_add );
-        }
-        for( auto &elem : followers ) {
-            if( !it.is_owned_by( *this, true ) && ( g->u.sees( this->pos() ) || g->u.sees( wanted_item_pos ) ||
-                                                    elem->sees( this->pos() ) || elem->sees( wanted_item_pos ) ) ) {
-                return;
-            }
+            return false;
         }
         if( whitelisting && !item_whitelisted( it ) ) {
-            return;
+            return false;
         }
 
         // When using a whitelist, skip the value check
         // TODO: Whitelist hierarchy?
         int itval = whitelisting ? 1000 : value( it );
 
-        if( itval > best_value &&
+        if( itval > min_value &&
             ( it.volume() <= volume_allowed && it.weight() <= weight_allowed ) ) {
-            wanted_item_pos = p;
-            wanted = &( it );
-            best_value = itval;
+            candidates.push_back( { &it, p, itval } );
+            return true;
         }
+        return false;
     };
 
     // Harvest item doesn't exist, so we'll be checking by its name
     std::string wanted_name;
+    tripoint wanted_terrain_pos;
     const auto consider_terrain =
-    [ this, whitelisting, volume_allowed, &wanted, &wanted_name ]( const tripoint & p ) {
+    [ this, whitelisting, volume_allowed, &wanted_name, &wanted_terrain_pos ]( const tripoint & p ) {
         // We only want to pick plants when there are no items to pick
-        if( !whitelisting || wanted != nullptr || !wanted_name.empty() || volume_allowed < 250_ml ) {
+        if( !whitelisting || !wanted_name.empty() || volume_allowed < 250_ml ) {
             return;
         }
 
@@ -2804,7 +2845,7 @@ void npc::find_item()
         for( const auto &entry : harvest ) {
             if( item_name_whitelisted( entry ) ) {
                 wanted_name = entry;
-                wanted_item_pos = p;
+                wanted_terrain_pos = p;
                 break;
             }
         }
@@ -2833,26 +2874,26 @@ void npc::find_item()
         if( prev_num_items == num_items ) {
             continue;
         }
-        auto cache_tile = [this, &abs_p, num_items, &wanted]() {
-            if( wanted == nullptr ) {
+        // Tiles with something worth taking are searched again next time.
+        bool found_something = false;
+        auto cache_tile = [this, &abs_p, num_items, &found_something]() {
+            if( !found_something ) {
                 ai_cache.searched_tiles.insert( 1000, abs_p, num_items );
             }
         };
-        bool can_see = false;
-        if( g->m.sees_some_items( p, *this ) && sees( p ) ) {
-            can_see = true;
+        const bool can_see = sees( p );
+        if( can_see && g->m.sees_some_items( p, *this ) ) {
             for( const item &it : m_stack ) {
-                consider_item( it, p );
+                found_something |= consider_item( it, p );
             }
         }
 
         // Not cached because it gets checked once and isn't expected to change.
-        if( can_see || sees( p ) ) {
-            can_see = true;
+        if( can_see ) {
             consider_terrain( p );
         }
 
-        if( !vp || vp->vehicle().is_moving() || !( can_see || sees( p ) ) ) {
+        if( !vp || vp->vehicle().is_moving() || !can_see ) {
             cache_tile();
             continue;
         }
@@ -2871,11 +2912,31 @@ void npc::find_item()
         }
 
         for( const item &it : cargo->vehicle().get_items( cargo->part_index() ) ) {
-            consider_item( it, p );
+            found_something |= consider_item( it, p );
         }
         cache_tile();
     }
 
+    // Best first, ties go to the closest one.
+    std::stable_sort( candidates.begin(), candidates.end(),
+    []( const candidate & lhs, const candidate & rhs ) {
+        return lhs.value > rhs.value;
+    } );
+    npc_loot_scan &scan = current_loot_scan();
+    for( const candidate &c : candidates ) {
+        // Don't take other people's stuff while the player or their followers are watching.
+        if( !scan.followers.empty() && !c.it->is_owned_by( *this, true ) &&
+            ( scan.witnessed( pos() ) || scan.witnessed( c.pos ) ) ) {
+            continue;
+        }
+        wanted = c.it;
+        wanted_item_pos = c.pos;
+        break;
+    }
+    if( wanted == nullptr && !wanted_name.empty() ) {
+        wanted_item_pos = wanted_terrain_pos;
+    }
+
     if( wanted != nullptr ) {
         wanted_name = wanted->tname();
     }
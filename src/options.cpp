@@ -1073,6 +1073,7 @@ void options_manager::Page::removeRepeatedEmptyLines()
 
 void options_manager::init()
 {
+    invalidate_option_refs();
     options.clear();
     for( Page &p : pages_ ) {
         p.items_.clear();
@@ -1248,6 +1249,13 @@ void options_manager::add_options_general()
 
     get_option( "AUTOSAVE_MINUTES" ).setPrerequisite( "AUTOSAVE" );
 
+    add( "AUTOSAVE_BACKGROUND", "general", translate_marker( "Autosave in the background" ),
+         translate_marker( "If true, autosaves only take a snapshot of the game and write it to disk in the background, so the game does not pause while the files are written." ),
+         true
+       );
+
+    get_option( "AUTOSAVE_BACKGROUND" ).setPrerequisite( "AUTOSAVE" );
+
     add_empty_line();
 
     add( "AUTO_NOTES", "general", translate_marker( "Auto notes" ),
@@ -1988,6 +1996,36 @@ void options_manager::add_options_debug()
 
     get_option( "FOV_3D_Z_RANGE" ).setPrerequisite( "FOV_3D" );
 
+    add( "PARALLEL_SHADOWCASTING", "debug", translate_marker( "Multithreaded shadowcasting" ),
+         translate_marker( "If true, the field of vision and the light sources are calculated on several threads.  The result is the same, but it can be faster on machines with many cores." ),
+         false
+       );
+
+    add( "INCREMENTAL_LIGHTMAP", "debug", translate_marker( "Incremental lightmap" ),
+         translate_marker( "If true, only the light sources that changed since the last turn are recalculated.  The result is the same as recalculating all of them." ),
+         true
+       );
+
+    add( "BACKGROUND_OVERMAP_GENERATION", "debug", translate_marker( "Background overmap generation" ),
+         translate_marker( "If true, the overmaps around the player are generated on a separate thread before they are needed, instead of pausing the game when they are first visited or searched." ),
+         true
+       );
+
+    add( "PARALLEL_OVERMAP_GENERATION", "debug", translate_marker( "Multithreaded overmap generation" ),
+         translate_marker( "If true, parts of overmap generation run on several threads.  The generated overmaps are the same either way." ),
+         true
+       );
+
+    add( "FAST_FORWARD_ITEM_ROT", "debug", translate_marker( "Fast-forward item rot" ),
+         translate_marker( "If true, the rot and temperature of items that were away from the player for a long time are caught up on with cached hourly weather samples.  If false, the weather is calculated exactly for every hour of every item." ),
+         true
+       );
+
+    add( "DOUBLE_BUFFERED_GAS_SPREAD", "debug", translate_marker( "Double-buffered gas spread" ),
+         translate_marker( "If true, gases spread based on the previous turn's state, with the submaps handled on several threads.  If false, each gas spreads in turn, seeing the moves of the gases processed before it." ),
+         false
+       );
+
     add( "ENCODING_CONV", "debug", translate_marker( "Experimental path name encoding conversion" ),
          translate_marker( "If true, file path names are going to be transcoded from system encoding to UTF-8 when reading and will be transcoded back when writing.  Mainly for CJK Windows users." ),
          true
@@ -2149,6 +2187,16 @@ void options_manager::add_options_world_default()
          true
        );
 
+    add( "BINARY_MAP_STORAGE", "world_default", translate_marker( "Binary map storage" ),
+         translate_marker( "If true, map data is saved in a compressed binary format, which is smaller and faster to save and load than JSON.  Map files in either format can always be loaded, existing ones can be converted from the debug menu." ),
+         false
+       );
+
+    add( "MAP_REGION_FILES", "world_default", translate_marker( "Map region files" ),
+         translate_marker( "If true, saved map data is packed into one file per region of 32x32 overmap tiles, instead of one file per overmap tile.  This greatly reduces the number of files in the save directory.  Map data can always be loaded from either layout, existing data can be converted from the debug menu." ),
+         false
+       );
+
     add_empty_line();
 
     add( "CHARACTER_POINT_POOLS", "world_default", translate_marker( "Character point pools" ),
@@ -2879,6 +2927,7 @@ std::string options_manager::show( bool ingame, const bool world_options_only,
             if( ingame && world_options_changed ) {
                 ACTIVE_WORLD_OPTIONS = WOPTIONS_OLD;
             }
+            invalidate_option_refs();
         }
     }
 
@@ -2996,6 +3045,7 @@ bool options_manager::save()
 
 void options_manager::load()
 {
+    invalidate_option_refs();
     const auto file = PATH_INFO::options();
     if( !read_from_file_optional_json( file, [&]( JsonIn & jsin ) {
     deserialize( jsin );
@@ -3088,6 +3138,7 @@ options_manager::options_container options_manager::get_world_defaults() const
 
 void options_manager::set_world_options( options_container *options )
 {
+    invalidate_option_refs();
     if( options == nullptr ) {
         world_options.reset();
     } else {
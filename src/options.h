@@ -223,6 +223,14 @@ class options_manager
 
         cOpt &get_option( const std::string &name );
 
+        /**
+         * Changes whenever references to options returned by @ref get_option may have become
+         * invalid (options reloaded, world options switched or restored), see @ref option_ref.
+         */
+        unsigned int get_generation() const {
+            return generation;
+        }
+
         //add hidden external option with value
         void add_external( const std::string &sNameIn, const std::string &sPageIn, const std::string &sType,
                            const std::string &sMenuTextIn, const std::string &sTooltipIn );
@@ -270,6 +278,12 @@ class options_manager
     private:
         options_container options;
         cata::optional<options_container *> world_options;
+        // Starts at 1, so default constructed option_ref objects are always resolved first.
+        unsigned int generation = 1;
+
+        void invalidate_option_refs() {
+            generation++;
+        }
 
         /**
          * A page (or tab) to be displayed in the options UI.
@@ -323,4 +337,35 @@ inline T get_option( const std::string &name )
     return get_options().get_option( name ).value_as<T>();
 }
 
+/**
+ * A pre-resolved handle to an option, for options that are read on hot paths (every turn,
+ * every tile). @ref get_option looks the name up in one or two maps on each call, this
+ * looks it up once and afterwards only dereferences the cached pointer, until the option
+ * containers change (see @ref options_manager::get_generation).
+ *
+ * Meant to be used as a static object:
+ * static const option_ref<bool> force_redraw( "FORCE_REDRAW" );
+ * if( force_redraw.get() ) ...
+ */
+template<typename T>
+class option_ref
+{
+    public:
+        explicit option_ref( const std::string &name ) : name( name ) { }
+
+        T get() const {
+            options_manager &opts = get_options();
+            if( generation != opts.get_generation() ) {
+                opt = &opts.get_option( name );
+                generation = opts.get_generation();
+            }
+            return opt->value_as<T>();
+        }
+
+    private:
+        std::string name;
+        mutable options_manager::cOpt *opt = nullptr;
+        mutable unsigned int generation = 0;
+};
+
 #endif // CATA_SRC_OPTIONS_H
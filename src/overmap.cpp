@@ -3,13 +3,19 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 #include <exception>
+#include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <ostream>
+#include <random>
 #include <set>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
@@ -48,6 +54,7 @@
 #include "rotatable_symbols.h"
 #include "simple_pathfinding.h"
 #include "string_formatter.h"
+#include "thread_pool.h"
 #include "translations.h"
 
 static const efftype_id effect_pet( "pet" );
@@ -444,7 +451,12 @@ const std::vector<overmap_special> &overmap_specials::get_all()
 
 overmap_special_batch overmap_specials::get_default_batch( const point &origin )
 {
-    const int city_size = get_option<int>( "CITY_SIZE" );
+    return get_default_batch( origin, get_option<int>( "CITY_SIZE" ) );
+}
+
+overmap_special_batch overmap_specials::get_default_batch( const point &origin,
+        const int city_size )
+{
     std::vector<const overmap_special *> res;
 
     res.reserve( specials.size() );
@@ -1057,6 +1069,12 @@ overmap::overmap( const point &p ) : loc( p )
     init_layers();
 }
 
+overmap::overmap( const point &p, const regional_settings &rsettings ) : loc( p ),
+    settings( rsettings )
+{
+    init_layers();
+}
+
 overmap::~overmap() = default;
 
 void overmap::populate( overmap_special_batch &enabled_specials )
@@ -1070,7 +1088,65 @@ void overmap::populate( overmap_special_batch &enabled_specials )
 
 void overmap::populate()
 {
-    overmap_special_batch enabled_specials = overmap_specials::get_default_batch( loc );
+    overmap_special_batch enabled_specials =
+        enabled_specials_batch( get_option<int>( "CITY_SIZE" ) );
+    populate( enabled_specials );
+}
+
+bool overmap::generate_detached( const overmap *north, const overmap *east,
+                                 const overmap *south, const overmap *west,
+                                 const generation_context &new_context )
+{
+    overmap_special_batch enabled_specials = enabled_specials_batch( new_context.city_size );
+    context = new_context;
+    detached = true;
+    detached_failed = false;
+    generate( north, east, south, west, enabled_specials );
+    detached = false;
+    return !detached_failed;
+}
+
+overmap::generation_context overmap::prepare_detached_generation()
+{
+    return game_context();
+}
+
+overmap::generation_context overmap::game_context()
+{
+    generation_context result;
+    result.defense_mode = g->gametype() == SGAME_DEFENSE;
+    result.world_seed = g->get_seed();
+    result.city_size = get_option<int>( "CITY_SIZE" );
+    result.city_spacing = get_option<int>( "CITY_SPACING" );
+    result.wander_spawns = get_option<bool>( "WANDER_SPAWNS" );
+    result.disable_animal_clash = get_option<bool>( "DISABLE_ANIMAL_CLASH" );
+    result.parallel_generation = get_option<bool>( "PARALLEL_OVERMAP_GENERATION" );
+    return result;
+}
+
+std::unique_ptr<overmap> overmap::edge_snapshot() const
+{
+    // Not make_unique, the constructor that doesn't read the region from the options is private.
+    std::unique_ptr<overmap> result( new overmap( loc, settings ) );
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        const map_layer &from = layer[z + OVERMAP_DEPTH];
+        map_layer &to = result->layer[z + OVERMAP_DEPTH];
+        for( int i = 0; i < OMAPX; i++ ) {
+            to.terrain[i][0] = from.terrain[i][0];
+            to.terrain[i][OMAPY - 1] = from.terrain[i][OMAPY - 1];
+        }
+        for( int j = 0; j < OMAPY; j++ ) {
+            to.terrain[0][j] = from.terrain[0][j];
+            to.terrain[OMAPX - 1][j] = from.terrain[OMAPX - 1][j];
+        }
+    }
+    result->connections_out = connections_out;
+    return result;
+}
+
+overmap_special_batch overmap::enabled_specials_batch( const int city_size ) const
+{
+    overmap_special_batch enabled_specials = overmap_specials::get_default_batch( loc, city_size );
 
     const bool should_blacklist = !settings.overmap_feature_flag.blacklist.empty();
     const bool should_whitelist = !settings.overmap_feature_flag.whitelist.empty();
@@ -1112,7 +1188,7 @@ void overmap::populate()
         }
     }
 
-    populate( enabled_specials );
+    return enabled_specials;
 }
 
 oter_id overmap::get_default_terrain( int z ) const
@@ -1130,6 +1206,7 @@ oter_id overmap::get_default_terrain( int z ) const
 
 void overmap::init_layers()
 {
+    location_index_valid = false;
     for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
         const oter_id tid = get_default_terrain( k - OVERMAP_DEPTH );
 
@@ -1150,7 +1227,25 @@ void overmap::ter_set( const tripoint &p, const oter_id &id )
         return;
     }
 
-    layer[p.z + OVERMAP_DEPTH].terrain[p.x][p.y] = id;
+    oter_id &current = layer[p.z + OVERMAP_DEPTH].terrain[p.x][p.y];
+    if( location_index_valid && current != id ) {
+        const oter_id default_terrain = get_default_terrain( p.z );
+        if( current != default_terrain ) {
+            // Move the last location of the old terrain into the slot of this one.
+            std::vector<tripoint> &locations = terrain_locations[current];
+            const size_t slot = terrain_location_slots[p];
+            locations[slot] = locations.back();
+            terrain_location_slots[locations[slot]] = slot;
+            locations.pop_back();
+            terrain_location_slots.erase( p );
+        }
+        if( id != default_terrain ) {
+            std::vector<tripoint> &locations = terrain_locations[id];
+            terrain_location_slots[p] = locations.size();
+            locations.push_back( p );
+        }
+    }
+    current = id;
 }
 
 const oter_id &overmap::ter( const tripoint &p ) const
@@ -1460,44 +1555,115 @@ void overmap::set_scent( const tripoint &loc, const scent_trace &new_scent )
     scents[loc] = new_scent;
 }
 
+std::map<std::string, std::chrono::duration<double>> &overmap_generation_timings()
+{
+    static thread_local std::map<std::string, std::chrono::duration<double>> timings;
+    return timings;
+}
+
+/**
+ * The points that map::points_in_radius returns on the game's map, generation used to call
+ * it. They are clipped to the size of the reality bubble, which is kept so that a seed
+ * still generates the same overmaps. This doesn't touch the map, so it works on any thread.
+ */
+static tripoint_range points_in_map_radius( const tripoint &center, const size_t radius )
+{
+    const int minx = std::max<int>( 0, center.x - radius );
+    const int miny = std::max<int>( 0, center.y - radius );
+    const int maxx = std::min<int>( SEEX * MAPSIZE - 1, center.x + radius );
+    const int maxy = std::min<int>( SEEX * MAPSIZE - 1, center.y + radius );
+    const int z = clamp<int>( center.z, -OVERMAP_DEPTH, OVERMAP_HEIGHT );
+    return tripoint_range( tripoint( minx, miny, z ), tripoint( maxx, maxy, z ) );
+}
+
+/**
+ * Calls @p task( first_x, last_x ) for slices of columns covering the overmap, on several
+ * threads if enabled. The slices don't depend on the number of threads, and the tasks
+ * must only read shared state and write their own columns of any output, so the result
+ * is the same either way.
+ */
+static void for_each_column_slice( const bool parallel,
+                                   const std::function<void( int, int )> &task )
+{
+    static constexpr int num_slices = 12;
+    static_assert( OMAPX % num_slices == 0, "slices must cover the whole overmap" );
+    if( !parallel ) {
+        task( 0, OMAPX );
+        return;
+    }
+    get_thread_pool().run( num_slices, [&]( const size_t slice ) {
+        const int width = OMAPX / num_slices;
+        task( static_cast<int>( slice ) * width, static_cast<int>( slice + 1 ) * width );
+    } );
+}
+
 void overmap::generate( const overmap *north, const overmap *east,
                         const overmap *south, const overmap *west,
                         overmap_special_batch &enabled_specials )
 {
-    if( g->gametype() == SGAME_DEFENSE ) {
+    if( context.defense_mode ) {
         dbg( D_INFO ) << "overmap::generate skipped in Defense special game mode!";
         return;
     }
 
     dbg( D_INFO ) << "overmap::generate start…";
 
-    populate_connections_out_from_neighbors( north, east, south, west );
+    const auto timed = []( const std::string & stage, const std::function<void()> &run_stage ) {
+        const auto start = std::chrono::steady_clock::now();
+        run_stage();
+        overmap_generation_timings()[stage] += std::chrono::steady_clock::now() - start;
+    };
 
-    place_rivers( north, east, south, west );
-    place_lakes();
-    place_forests();
-    place_swamps();
-    place_cities();
-    place_forest_trails();
-    place_roads( north, east, south, west );
-    place_specials( enabled_specials );
-    place_forest_trailheads();
+    populate_connections_out_from_neighbors( north, east, south, west );
 
-    polish_river();
+    timed( "rivers", [&]() {
+        place_rivers( north, east, south, west );
+    } );
+    timed( "lakes", [&]() {
+        place_lakes();
+    } );
+    timed( "forests", [&]() {
+        place_forests();
+    } );
+    timed( "swamps", [&]() {
+        place_swamps();
+    } );
+    timed( "cities", [&]() {
+        place_cities();
+    } );
+    timed( "forest trails", [&]() {
+        place_forest_trails();
+    } );
+    timed( "roads", [&]() {
+        place_roads( north, east, south, west );
+    } );
+    timed( "specials", [&]() {
+        place_specials( enabled_specials );
+    } );
+    timed( "forest trailheads", [&]() {
+        place_forest_trailheads();
+    } );
+    timed( "polish rivers", [&]() {
+        polish_river();
+    } );
 
     // TODO: there is no reason we can't generate the sublevels in one pass
     //       for that matter there is no reason we can't as we add the entrance ways either
 
     // Always need at least one sublevel, but how many more
-    int z = -1;
-    bool requires_sub = false;
-    do {
-        requires_sub = generate_sub( z );
-    } while( requires_sub && ( --z >= -OVERMAP_DEPTH ) );
+    timed( "sublevels", [&]() {
+        int z = -1;
+        bool requires_sub = false;
+        do {
+            requires_sub = generate_sub( z );
+        } while( requires_sub && ( --z >= -OVERMAP_DEPTH ) );
+    } );
 
     // Place the monsters, now that the terrain is laid out
-    place_mongroups();
-    place_radios();
+    timed( "monsters and radios", [&]() {
+        place_mongroups();
+        place_radios();
+    } );
     dbg( D_INFO ) << "overmap::generate done";
 }
 
@@ -1601,7 +1767,7 @@ bool overmap::generate_sub( const int z )
                 // but at this point we don't know
                 requires_sub = true;
             } else if( oter_above == "mine_finale" ) {
-                for( auto &q : g->m.points_in_radius( p, 1, 0 ) ) {
+                for( const tripoint &q : points_in_map_radius( p, 1 ) ) {
                     ter_set( q, oter_id( "spiral" ) );
                 }
                 ter_set( p, oter_id( "spiral_hub" ) );
@@ -1849,6 +2015,7 @@ void overmap::clear_mon_groups()
 void overmap::clear_overmap_special_placements()
 {
     overmap_special_placements.clear();
+    location_index_valid = false;
 }
 void overmap::clear_cities()
 {
@@ -2125,15 +2292,20 @@ void overmap::place_forest_trails()
 {
     std::unordered_set<point> visited;
 
+    const oter_id forest( "forest" );
+    const oter_id forest_thick( "forest_thick" );
+    const oter_id forest_water( "forest_water" );
     const auto is_forest = [&]( const point & p ) {
         if( !inbounds( p, 1 ) ) {
             return false;
         }
-        const auto current_terrain = ter( tripoint( p, 0 ) );
-        return current_terrain == "forest" || current_terrain == "forest_thick" ||
-               current_terrain == "forest_water";
+        const oter_id &current_terrain = ter( tripoint( p, 0 ) );
+        return current_terrain == forest || current_terrain == forest_thick ||
+               current_terrain == forest_water;
     };
 
+    // Find the forests first, the trails are planned for each of them in parallel.
+    std::vector<std::vector<point>> forests;
     for( int i = 0; i < OMAPX; i++ ) {
         for( int j = 0; j < OMAPY; j++ ) {
             tripoint seed_point( i, j, 0 );
@@ -2159,85 +2331,113 @@ void overmap::place_forest_trails()
                 ( settings.forest_trail.minimum_forest_size ) ) {
                 continue;
             }
+            forests.emplace_back( std::move( forest_points ) );
+        }
+    }
 
-            // If we don't rng a forest based on our settings, move on.
-            if( !one_in( settings.forest_trail.chance ) ) {
-                continue;
-            }
-
-            // Get the north and south most points in the forest.
-            auto north_south_most = std::minmax_element( forest_points.begin(),
-            forest_points.end(), []( const point & lhs, const point & rhs ) {
-                return lhs.y < rhs.y;
-            } );
-
-            // Get the west and east most points in the forest.
-            auto west_east_most = std::minmax_element( forest_points.begin(),
-            forest_points.end(), []( const point & lhs, const point & rhs ) {
-                return lhs.x < rhs.x;
-            } );
-
-            // We'll use these points later as points that are guaranteed to be
-            // at a boundary and will form a good foundation for the trail system.
-            point northmost = *north_south_most.first;
-            point southmost = *north_south_most.second;
-            point westmost = *west_east_most.first;
-            point eastmost = *west_east_most.second;
-
-            // Do a simplistic calculation of the center of the forest (rather than
-            // calculating the actual centroid--it's not that important) to have another
-            // good point to form the foundation of the trail system.
-            int center_x = westmost.x + ( eastmost.x - westmost.x ) / 2;
-            int center_y = northmost.y + ( southmost.y - northmost.y ) / 2;
-
-            point center_point = point( center_x, center_y );
-
-            // Because we didn't do the centroid of a concave polygon, there's no
-            // guarantee that our center point is actually within the bounds of the
-            // forest. Just find the point within our set that is closest to our
-            // center point and use that.
-            point actual_center_point = *std::min_element( forest_points.begin(),
-            forest_points.end(), [&center_point]( const point & lhs, const point & rhs ) {
-                return square_dist( lhs, center_point ) < square_dist( rhs,
-                        center_point );
-            } );
-
-            // Figure out how many random points we'll add to our trail system, based on the forest
-            // size and our configuration.
-            int max_random_points = settings.forest_trail.random_point_min + forest_points.size() /
-                                    settings.forest_trail.random_point_size_scalar;
-            max_random_points = std::min( max_random_points, settings.forest_trail.random_point_max );
+    // Each forest has its own random numbers, seeded by where it is, so the plans don't
+    // depend on the order in which the forests are planned.
+    const unsigned int trails_seed = rng_bits();
+    std::vector<std::vector<point>> trails( forests.size() );
+    const auto plan_trail = [&]( const size_t index ) {
+        std::vector<point> &forest_points = forests[index];
+        const point &first = forest_points.front();
+        cata_default_random_engine forest_rng( trails_seed ^ ( first.x * 73856093U ) ^
+                                               ( first.y * 19349663U ) );
+        const auto forest_one_in = [&forest_rng]( const int chance ) {
+            return chance <= 1 || std::uniform_int_distribution<int>( 0, chance - 1 )( forest_rng ) == 0;
+        };
 
-            // Start with the center...
-            std::vector<point> chosen_points = { actual_center_point };
+        // If we don't rng a forest based on our settings, move on.
+        if( !forest_one_in( settings.forest_trail.chance ) ) {
+            return;
+        }
 
-            // ...and then add our random points.
-            int random_point_count = 0;
-            std::shuffle( forest_points.begin(), forest_points.end(), rng_get_engine() );
-            for( auto &random_point : forest_points ) {
-                if( random_point_count >= max_random_points ) {
-                    break;
-                }
-                random_point_count++;
-                chosen_points.emplace_back( random_point );
+        // Get the north and south most points in the forest.
+        auto north_south_most = std::minmax_element( forest_points.begin(),
+        forest_points.end(), []( const point & lhs, const point & rhs ) {
+            return lhs.y < rhs.y;
+        } );
+
+        // Get the west and east most points in the forest.
+        auto west_east_most = std::minmax_element( forest_points.begin(),
+        forest_points.end(), []( const point & lhs, const point & rhs ) {
+            return lhs.x < rhs.x;
+        } );
+
+        // We'll use these points later as points that are guaranteed to be
+        // at a boundary and will form a good foundation for the trail system.
+        point northmost = *north_south_most.first;
+        point southmost = *north_south_most.second;
+        point westmost = *west_east_most.first;
+        point eastmost = *west_east_most.second;
+
+        // Do a simplistic calculation of the center of the forest (rather than
+        // calculating the actual centroid--it's not that important) to have another
+        // good point to form the foundation of the trail system.
+        int center_x = westmost.x + ( eastmost.x - westmost.x ) / 2;
+        int center_y = northmost.y + ( southmost.y - northmost.y ) / 2;
+
+        point center_point = point( center_x, center_y );
+
+        // Because we didn't do the centroid of a concave polygon, there's no
+        // guarantee that our center point is actually within the bounds of the
+        // forest. Just find the point within our set that is closest to our
+        // center point and use that.
+        point actual_center_point = *std::min_element( forest_points.begin(),
+        forest_points.end(), [&center_point]( const point & lhs, const point & rhs ) {
+            return square_dist( lhs, center_point ) < square_dist( rhs,
+                    center_point );
+        } );
+
+        // Figure out how many random points we'll add to our trail system, based on the forest
+        // size and our configuration.
+        int max_random_points = settings.forest_trail.random_point_min + forest_points.size() /
+                                settings.forest_trail.random_point_size_scalar;
+        max_random_points = std::min( max_random_points, settings.forest_trail.random_point_max );
+
+        // Start with the center...
+        std::vector<point> &chosen_points = trails[index];
+        chosen_points.push_back( actual_center_point );
+
+        // ...and then add our random points.
+        int random_point_count = 0;
+        std::shuffle( forest_points.begin(), forest_points.end(), forest_rng );
+        for( auto &random_point : forest_points ) {
+            if( random_point_count >= max_random_points ) {
+                break;
             }
+            random_point_count++;
+            chosen_points.emplace_back( random_point );
+        }
 
-            // Add our north/south/west/east-most points based on our configuration.
-            if( one_in( settings.forest_trail.border_point_chance ) ) {
-                chosen_points.emplace_back( northmost );
-            }
-            if( one_in( settings.forest_trail.border_point_chance ) ) {
-                chosen_points.emplace_back( southmost );
-            }
-            if( one_in( settings.forest_trail.border_point_chance ) ) {
-                chosen_points.emplace_back( westmost );
-            }
-            if( one_in( settings.forest_trail.border_point_chance ) ) {
-                chosen_points.emplace_back( eastmost );
-            }
+        // Add our north/south/west/east-most points based on our configuration.
+        if( forest_one_in( settings.forest_trail.border_point_chance ) ) {
+            chosen_points.emplace_back( northmost );
+        }
+        if( forest_one_in( settings.forest_trail.border_point_chance ) ) {
+            chosen_points.emplace_back( southmost );
+        }
+        if( forest_one_in( settings.forest_trail.border_point_chance ) ) {
+            chosen_points.emplace_back( westmost );
+        }
+        if( forest_one_in( settings.forest_trail.border_point_chance ) ) {
+            chosen_points.emplace_back( eastmost );
+        }
+    };
+    if( context.parallel_generation ) {
+        get_thread_pool().run( forests.size(), plan_trail );
+    } else {
+        for( size_t i = 0; i < forests.size(); i++ ) {
+            plan_trail( i );
+        }
+    }
 
-            // Finally, connect all the points and make a forest trail out of them.
-            const string_id<overmap_connection> forest_trail( "forest_trail" );
+    // Finally, connect all the points and make a forest trail out of them. The trails of
+    // different forests can cross, so this stays in order.
+    const string_id<overmap_connection> forest_trail( "forest_trail" );
+    for( const std::vector<point> &chosen_points : trails ) {
+        if( !chosen_points.empty() ) {
             connect_closest_points( chosen_points, 0, *forest_trail );
         }
     }
@@ -2246,7 +2446,7 @@ void overmap::place_forest_trails()
 void overmap::place_forest_trailheads()
 {
     // No trailheads if there are no cities.
-    const int city_size = get_option<int>( "CITY_SIZE" );
+    const int city_size = context.city_size;
     if( city_size <= 0 ) {
         return;
     }
@@ -2299,36 +2499,62 @@ void overmap::place_forests()
     const oter_id forest( "forest" );
     const oter_id forest_thick( "forest_thick" );
 
-    const om_noise::om_noise_layer_forest f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_layer_forest f( global_base_point(), context.world_seed );
 
-    for( int x = 0; x < OMAPX; x++ ) {
-        for( int y = 0; y < OMAPY; y++ ) {
-            const tripoint p( x, y, 0 );
-            const oter_id &oter = ter( p );
+    // The noise is the expensive part, each slice decides its own columns.
+    std::vector<oter_id> forested( OMAPX * OMAPY );
+    for_each_column_slice( context.parallel_generation, [&]( const int first_x, const int last_x ) {
+        for( int x = first_x; x < last_x; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                const tripoint p( x, y, 0 );
+                oter_id &result = forested[x * OMAPY + y];
+                result = ter( p );
 
-            // At this point in the process, we only want to consider converting the terrain into
-            // a forest if it's currently the default terrain type (e.g. a field).
-            if( oter != default_oter_id ) {
-                continue;
-            }
+                // At this point in the process, we only want to consider converting the terrain into
+                // a forest if it's currently the default terrain type (e.g. a field).
+                if( result != default_oter_id ) {
+                    continue;
+                }
 
-            const float n = f.noise_at( p.xy() );
+                const float n = f.noise_at( p.xy() );
 
-            // If the noise here meets our threshold, turn it into a forest.
-            if( n > settings.overmap_forest.noise_threshold_forest_thick ) {
-                ter_set( p, forest_thick );
-            } else if( n > settings.overmap_forest.noise_threshold_forest ) {
-                ter_set( p, forest );
+                // If the noise here meets our threshold, turn it into a forest.
+                if( n > settings.overmap_forest.noise_threshold_forest_thick ) {
+                    result = forest_thick;
+                } else if( n > settings.overmap_forest.noise_threshold_forest ) {
+                    result = forest;
+                }
             }
         }
+    } );
+
+    for( int x = 0; x < OMAPX; x++ ) {
+        for( int y = 0; y < OMAPY; y++ ) {
+            ter_set( tripoint( x, y, 0 ), forested[x * OMAPY + y] );
+        }
     }
 }
 
 void overmap::place_lakes()
 {
-    const om_noise::om_noise_layer_lake f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_layer_lake f( global_base_point(), context.world_seed );
+
+    // The noise inside this overmap is evaluated up front, in parallel. Lakes that run
+    // off the edge still evaluate it for the points outside.
+    std::vector<char> lake_noise( OMAPX * OMAPY );
+    for_each_column_slice( context.parallel_generation, [&]( const int first_x, const int last_x ) {
+        for( int x = first_x; x < last_x; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                lake_noise[x * OMAPY + y] = f.noise_at( point( x, y ) ) >
+                                            settings.overmap_lake.noise_threshold_lake;
+            }
+        }
+    } );
 
     const auto is_lake = [&]( const point & p ) {
+        if( inbounds( p ) ) {
+            return lake_noise[p.x * OMAPY + p.y] != 0;
+        }
         return f.noise_at( p ) > settings.overmap_lake.noise_threshold_lake;
     };
 
@@ -2641,7 +2867,7 @@ void overmap::place_swamps()
     const oter_id forest_water( "forest_water" );
 
     // Get a layer of noise to use in conjunction with our river buffered floodplain.
-    const om_noise::om_noise_layer_floodplain f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_layer_floodplain f( global_base_point(), context.world_seed );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
@@ -2826,11 +3052,11 @@ spawns happen at... <cue Clue music>
 20:56 <kevingranade>: game:pawn_mon() in game.cpp:7380*/
 void overmap::place_cities()
 {
-    int op_city_size = get_option<int>( "CITY_SIZE" );
+    int op_city_size = context.city_size;
     if( op_city_size <= 0 ) {
         return;
     }
-    int op_city_spacing = get_option<int>( "CITY_SPACING" );
+    int op_city_spacing = context.city_spacing;
 
     // spacing dictates how much of the map is covered in cities
     //   city  |  cities  |   size N cities per overmap
@@ -3291,7 +3517,7 @@ bool overmap::build_slimepit( const tripoint &origin, int s )
     const oter_id slimepit( "slimepit" );
 
     bool requires_sub = false;
-    for( auto p : g->m.points_in_radius( origin, s + origin.z + 1, 0 ) ) {
+    for( const tripoint &p : points_in_map_radius( origin, s + origin.z + 1 ) ) {
         int dist = square_dist( origin.xy(), p.xy() );
         if( one_in( 2 * dist ) ) {
             chip_rock( p );
@@ -3569,9 +3795,37 @@ void overmap::connect_closest_points( const std::vector<point> &points, int z,
 
 void overmap::polish_river()
 {
+    // Each location is polished based on its neighbours, which are all still unpolished
+    // when computed in parallel. Polishing normally keeps a river a river, so that gives
+    // the same result as polishing them one after another, except after a location turned
+    // into something else. The locations after such a neighbour are polished again, in
+    // order.
+    std::vector<oter_id> polished( OMAPX * OMAPY );
+    for_each_column_slice( context.parallel_generation, [&]( const int first_x, const int last_x ) {
+        for( int x = first_x; x < last_x; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                polished[x * OMAPY + y] = polished_river( { x, y, 0 } );
+            }
+        }
+    } );
+
+    std::vector<char> changed_kind( OMAPX * OMAPY );
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
-            good_river( { x, y, 0 } );
+            const tripoint p( x, y, 0 );
+            bool redo = false;
+            for( const tripoint &offset : eight_horizontal_neighbors ) {
+                const tripoint n = p + offset;
+                // Only the neighbours before this one are polished at this point.
+                if( inbounds( n ) && ( n.x < x || ( n.x == x && n.y < y ) ) &&
+                    changed_kind[n.x * OMAPY + n.y] ) {
+                    redo = true;
+                    break;
+                }
+            }
+            const oter_id before = ter( p );
+            ter_set( p, redo ? polished_river( p ) : polished[x * OMAPY + y] );
+            changed_kind[x * OMAPY + y] = is_river_or_lake( before ) != is_river_or_lake( ter( p ) );
         }
     }
 }
@@ -3615,30 +3869,92 @@ bool overmap::check_overmap_special_type( const overmap_special_id &id,
     return found_id->second == id;
 }
 
-void overmap::good_river( const tripoint &p )
+void overmap::build_location_index() const
+{
+    terrain_locations.clear();
+    terrain_location_slots.clear();
+    special_locations.clear();
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        const oter_id default_terrain = get_default_terrain( z );
+        const map_layer &l = layer[z + OVERMAP_DEPTH];
+        for( int x = 0; x < OMAPX; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                if( l.terrain[x][y] != default_terrain ) {
+                    std::vector<tripoint> &locations = terrain_locations[l.terrain[x][y]];
+                    terrain_location_slots[tripoint( x, y, z )] = locations.size();
+                    locations.emplace_back( x, y, z );
+                }
+            }
+        }
+    }
+    for( const auto &placement : overmap_special_placements ) {
+        special_locations[placement.second].push_back( placement.first );
+    }
+    location_index_valid = true;
+}
+
+bool overmap::find_indexed_terrain( const std::vector<std::pair<std::string, ot_match_type>>
+                                    &types, const cata::optional<overmap_special_id> &special,
+                                    std::vector<tripoint> &result ) const
+{
+    const auto matches = [&types]( const oter_id & oter ) {
+        return std::any_of( types.begin(), types.end(),
+        [&oter]( const std::pair<std::string, ot_match_type> &type ) {
+            return is_ot_match( type.first, oter, type.second );
+        } );
+    };
+    if( !special ) {
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            if( matches( get_default_terrain( z ) ) ) {
+                return false;
+            }
+        }
+    }
+    if( !location_index_valid ) {
+        build_location_index();
+    }
+
+    if( special ) {
+        // Specials are small, checking their terrain directly is cheap.
+        const auto iter = special_locations.find( *special );
+        if( iter != special_locations.end() ) {
+            std::copy_if( iter->second.begin(), iter->second.end(), std::back_inserter( result ),
+            [&]( const tripoint & p ) {
+                return matches( ter( p ) );
+            } );
+        }
+        return true;
+    }
+    for( const auto &entry : terrain_locations ) {
+        if( matches( entry.first ) ) {
+            result.insert( result.end(), entry.second.begin(), entry.second.end() );
+        }
+    }
+    return true;
+}
+
+oter_id overmap::polished_river( const tripoint &p ) const
 {
     if( !is_ot_match( "river", ter( p ), ot_match_type::prefix ) ) {
-        return;
+        return ter( p );
     }
     if( ( p.x == 0 ) || ( p.x == OMAPX - 1 ) ) {
         if( !is_river_or_lake( ter( p + point_north ) ) ) {
-            ter_set( p, oter_id( "river_north" ) );
+            return oter_id( "river_north" );
         } else if( !is_river_or_lake( ter( p + point_south ) ) ) {
-            ter_set( p, oter_id( "river_south" ) );
+            return oter_id( "river_south" );
         } else {
-            ter_set( p, oter_id( "river_center" ) );
+            return oter_id( "river_center" );
         }
-        return;
     }
     if( ( p.y == 0 ) || ( p.y == OMAPY - 1 ) ) {
         if( !is_river_or_lake( ter( p + point_west ) ) ) {
-            ter_set( p, oter_id( "river_west" ) );
+            return oter_id( "river_west" );
         } else if( !is_river_or_lake( ter( p + point_east ) ) ) {
-            ter_set( p, oter_id( "river_east" ) );
+            return oter_id( "river_east" );
         } else {
-            ter_set( p, oter_id( "river_center" ) );
+            return oter_id( "river_center" );
         }
-        return;
     }
     if( is_river_or_lake( ter( p + point_west ) ) ) {
         if( is_river_or_lake( ter( p + point_north ) ) ) {
@@ -3647,36 +3963,36 @@ void overmap::good_river( const tripoint &p )
                     // River on N, S, E, W;
                     // but we might need to take a "bite" out of the corner
                     if( !is_river_or_lake( ter( p + point_north_west ) ) ) {
-                        ter_set( p, oter_id( "river_c_not_nw" ) );
+                        return oter_id( "river_c_not_nw" );
                     } else if( !is_river_or_lake( ter( p + point_north_east ) ) ) {
-                        ter_set( p, oter_id( "river_c_not_ne" ) );
+                        return oter_id( "river_c_not_ne" );
                     } else if( !is_river_or_lake( ter( p + point_south_west ) ) ) {
-                        ter_set( p, oter_id( "river_c_not_sw" ) );
+                        return oter_id( "river_c_not_sw" );
                     } else if( !is_river_or_lake( ter( p + point_south_east ) ) ) {
-                        ter_set( p, oter_id( "river_c_not_se" ) );
+                        return oter_id( "river_c_not_se" );
                     } else {
-                        ter_set( p, oter_id( "river_center" ) );
+                        return oter_id( "river_center" );
                     }
                 } else {
-                    ter_set( p, oter_id( "river_east" ) );
+                    return oter_id( "river_east" );
                 }
             } else {
                 if( is_river_or_lake( ter( p + point_east ) ) ) {
-                    ter_set( p, oter_id( "river_south" ) );
+                    return oter_id( "river_south" );
                 } else {
-                    ter_set( p, oter_id( "river_se" ) );
+                    return oter_id( "river_se" );
                 }
             }
         } else {
             if( is_river_or_lake( ter( p + point_south ) ) ) {
                 if( is_river_or_lake( ter( p + point_east ) ) ) {
-                    ter_set( p, oter_id( "river_north" ) );
+                    return oter_id( "river_north" );
                 } else {
-                    ter_set( p, oter_id( "river_ne" ) );
+                    return oter_id( "river_ne" );
                 }
             } else {
                 if( is_river_or_lake( ter( p + point_east ) ) ) { // Means it's swampy
-                    ter_set( p, oter_id( "forest_water" ) );
+                    return oter_id( "forest_water" );
                 }
             }
         }
@@ -3684,29 +4000,30 @@ void overmap::good_river( const tripoint &p )
         if( is_river_or_lake( ter( p + point_north ) ) ) {
             if( is_river_or_lake( ter( p + point_south ) ) ) {
                 if( is_river_or_lake( ter( p + point_east ) ) ) {
-                    ter_set( p, oter_id( "river_west" ) );
+                    return oter_id( "river_west" );
                 } else { // Should never happen
-                    ter_set( p, oter_id( "forest_water" ) );
+                    return oter_id( "forest_water" );
                 }
             } else {
                 if( is_river_or_lake( ter( p + point_east ) ) ) {
-                    ter_set( p, oter_id( "river_sw" ) );
+                    return oter_id( "river_sw" );
                 } else { // Should never happen
-                    ter_set( p, oter_id( "forest_water" ) );
+                    return oter_id( "forest_water" );
                 }
             }
         } else {
             if( is_river_or_lake( ter( p + point_south ) ) ) {
                 if( is_river_or_lake( ter( p + point_east ) ) ) {
-                    ter_set( p, oter_id( "river_nw" ) );
+                    return oter_id( "river_nw" );
                 } else { // Should never happen
-                    ter_set( p, oter_id( "forest_water" ) );
+                    return oter_id( "forest_water" );
                 }
             } else { // Should never happen
-                ter_set( p, oter_id( "forest_water" ) );
+                return oter_id( "forest_water" );
             }
         }
     }
+    return ter( p );
 }
 
 const std::string &om_direction::id( type dir )
@@ -3929,6 +4246,7 @@ void overmap::place_special( const overmap_special &special, const tripoint &p,
         const oter_id tid = elem.terrain->get_rotated( dir );
 
         overmap_special_placements[location] = special.id;
+        location_index_valid = false;
         ter_set( location, tid );
 
         if( blob ) {
@@ -4113,11 +4431,14 @@ void overmap::place_specials( overmap_special_batch &enabled_specials )
 
     // Check for any unplaced mandatory specials, and if there are any, attempt to
     // place them on adajacent uncreated overmaps.
-    if( std::any_of( custom_overmap_specials.begin(), custom_overmap_specials.end(),
-    []( overmap_special_placement placement ) {
-    return placement.instances_placed <
-           placement.special_details->occurrences.min;
-} ) ) {
+    const bool mandatory_missing = std::any_of( custom_overmap_specials.begin(),
+    custom_overmap_specials.end(), []( overmap_special_placement placement ) {
+        return placement.instances_placed < placement.special_details->occurrences.min;
+    } );
+    if( mandatory_missing && detached ) {
+        // Creating the adjacent overmap needs the overmap buffer.
+        detached_failed = true;
+    } else if( mandatory_missing ) {
         // Randomly select from among the nearest uninitialized overmap positions.
         int previous_distance = 0;
         std::vector<point> nearest_candidates;
@@ -4190,7 +4511,7 @@ void overmap::place_mongroups()
 {
     // Cities are full of zombies
     for( auto &elem : cities ) {
-        if( get_option<bool>( "WANDER_SPAWNS" ) ) {
+        if( context.wander_spawns ) {
             if( !one_in( 16 ) || elem.size > 5 ) {
                 mongroup m( GROUP_ZOMBIE,
                             tripoint( elem.pos.x * 2, elem.pos.y * 2, 0 ),
@@ -4204,7 +4525,7 @@ void overmap::place_mongroups()
         }
     }
 
-    if( get_option<bool>( "DISABLE_ANIMAL_CLASH" ) ) {
+    if( context.disable_animal_clash ) {
         // Figure out where swamps are, and place swamp monsters
         for( int x = 3; x < OMAPX - 3; x += 7 ) {
             for( int y = 3; y < OMAPY - 3; y += 7 ) {
@@ -4317,6 +4638,7 @@ void overmap::open( overmap_special_batch &enabled_specials )
         }
 
         // pointers looks like (north, south, west, east)
+        context = game_context();
         generate( pointers[0], pointers[3], pointers[1], pointers[2], enabled_specials );
     }
 }
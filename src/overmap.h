@@ -4,12 +4,14 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <climits>
 #include <cstdlib>
 #include <functional>
 #include <iosfwd>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -207,6 +209,38 @@ class overmap
          **/
         void populate( overmap_special_batch &enabled_specials );
         void populate();
+        /**
+         * What generation reads from the game and the options, copied on the main thread so
+         * that @ref generate_detached doesn't touch them while they change.
+         */
+        struct generation_context {
+            bool defense_mode = false;
+            unsigned int world_seed = 0;
+            int city_size = 0;
+            int city_spacing = 0;
+            bool wander_spawns = false;
+            bool disable_animal_clash = false;
+            bool parallel_generation = false;
+        };
+        /**
+         * Generates the content without using the overmap buffer or the game, so it can run on
+         * a background thread. The neighbours are usually @ref edge_snapshot copies.
+         * On a background thread the caller seeds its random engine, captures its debug
+         * output (@ref capture_debug_output) and has called @ref prepare_detached_generation.
+         * @returns false if the result is unusable: the mandatory specials didn't fit and
+         * would have to be placed on a new adjacent overmap.
+         */
+        bool generate_detached( const overmap *north, const overmap *east,
+                                const overmap *south, const overmap *west,
+                                const generation_context &context );
+        /**
+         * Reads what generation needs from the game and the options, call it on the main
+         * thread before any @ref generate_detached runs.
+         * @returns The context to generate with.
+         */
+        static generation_context prepare_detached_generation();
+        /** Copy of the parts of this overmap that generating an adjacent overmap reads. */
+        std::unique_ptr<overmap> edge_snapshot() const;
 
         const point &pos() const {
             return loc;
@@ -356,9 +390,29 @@ class overmap
         // as part of a special.
         std::unordered_map<tripoint, overmap_special_id> overmap_special_placements;
 
+        // Where each terrain (except the default terrain of its z-level) and each special
+        // is, used by find_indexed_terrain. Built on demand, ter_set keeps the terrain part
+        // up to date while it's valid, placing specials invalidates it.
+        mutable std::unordered_map<oter_id, std::vector<tripoint>> terrain_locations;
+        // The index of each location in its vector in terrain_locations.
+        mutable std::unordered_map<tripoint, size_t> terrain_location_slots;
+        mutable std::unordered_map<overmap_special_id, std::vector<tripoint>> special_locations;
+        mutable bool location_index_valid = false;
+        void build_location_index() const;
+
         regional_settings settings;
 
+        overmap( const point &p, const regional_settings &rsettings );
+
+        // Set while generate_detached runs, and whether it had to skip something.
+        bool detached = false;
+        bool detached_failed = false;
+        // What the current generation reads from the game.
+        generation_context context;
+        static generation_context game_context();
+
         oter_id get_default_terrain( int z ) const;
+        overmap_special_batch enabled_specials_batch( int city_size ) const;
 
         // Initialize
         void init_layers();
@@ -444,10 +498,21 @@ class overmap
         // Polishing
         bool check_ot( const std::string &otype, ot_match_type match_type, const tripoint &p ) const;
         bool check_overmap_special_type( const overmap_special_id &id, const tripoint &location ) const;
+        /**
+         * Adds the locations (local coordinates) of terrain matching any of @p types to
+         * @p result, using the location index instead of checking every location.
+         * If @p special is set, only locations that are part of that special are added.
+         * @returns false, without adding anything, if the index can't answer the query:
+         * it doesn't cover the default terrain of each z-level.
+         */
+        bool find_indexed_terrain( const std::vector<std::pair<std::string, ot_match_type>> &types,
+                                   const cata::optional<overmap_special_id> &special,
+                                   std::vector<tripoint> &result ) const;
         void chip_rock( const tripoint &p );
 
         void polish_river();
-        void good_river( const tripoint &p );
+        // The polished river terrain at p, based on the rivers and lakes around it.
+        oter_id polished_river( const tripoint &p ) const;
 
         om_direction::type random_special_rotation( const overmap_special &special,
                 const tripoint &p, bool must_be_unexplored ) const;
@@ -497,6 +562,12 @@ class overmap
 bool is_river( const oter_id &ter );
 bool is_river_or_lake( const oter_id &ter );
 
+/**
+* Time spent in each stage of overmap generation on the calling thread, summed up over
+* all overmaps generated since the map was last cleared.
+*/
+std::map<std::string, std::chrono::duration<double>> &overmap_generation_timings();
+
 /**
 * Determine if the provided name is a match with the provided overmap terrain
 * based on the specified match type.
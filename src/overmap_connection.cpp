@@ -72,23 +72,8 @@ const overmap_connection::subtype *overmap_connection::pick_subtype_for(
     }
 
     const size_t cache_index = ground.to_i();
-    assert( cache_index < cached_subtypes.size() );
-
-    if( cached_subtypes[cache_index] ) {
-        return cached_subtypes[cache_index].value;
-    }
-
-    const auto iter = std::find_if( subtypes.cbegin(),
-    subtypes.cend(), [&ground]( const subtype & elem ) {
-        return elem.allows_terrain( ground );
-    } );
-
-    const overmap_connection::subtype *result = iter != subtypes.cend() ? &*iter : nullptr;
-
-    cached_subtypes[cache_index].value = result;
-    cached_subtypes[cache_index].assigned = true;
-
-    return result;
+    assert( cache_index < subtype_for_terrain.size() );
+    return subtype_for_terrain[cache_index];
 }
 
 bool overmap_connection::has( const int_id<oter_t> &oter ) const
@@ -124,7 +109,17 @@ void overmap_connection::check() const
 
 void overmap_connection::finalize()
 {
-    cached_subtypes.resize( overmap_terrains::get_all().size() );
+    // Resolved up front, overmaps are also generated on a background thread
+    subtype_for_terrain.clear();
+    const size_t num_terrains = overmap_terrains::get_all().size();
+    for( size_t i = 0; i < num_terrains; i++ ) {
+        const int_id<oter_t> ground( static_cast<int>( i ) );
+        const auto iter = std::find_if( subtypes.cbegin(),
+        subtypes.cend(), [&ground]( const subtype & elem ) {
+            return elem.allows_terrain( ground );
+        } );
+        subtype_for_terrain.push_back( iter != subtypes.cend() ? &*iter : nullptr );
+    }
 }
 
 void overmap_connections::load( const JsonObject &jo, const std::string &src )
@@ -60,16 +60,9 @@ class overmap_connection
         bool was_loaded = false;
 
     private:
-        struct cache {
-            const subtype *value = nullptr;
-            bool assigned = false;
-            operator bool() const {
-                return assigned;
-            }
-        };
-
         std::list<subtype> subtypes;
-        mutable std::vector<cache> cached_subtypes;
+        // Indexed by the int id of the ground terrain, see @ref pick_subtype_for.
+        std::vector<const subtype *> subtype_for_terrain;
 };
 
 namespace overmap_connections
@@ -3,9 +3,20 @@
 #include <algorithm>
 #include <cassert>
 #include <climits>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
 #include <iterator>
 #include <list>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
 
 #include "avatar.h"
 #include "basecamp.h"
@@ -33,16 +44,237 @@
 #include "simple_pathfinding.h"
 #include "string_formatter.h"
 #include "string_id.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "vehicle.h"
 
 class map_extra;
 
+/**
+ * Generates overmaps on a worker thread for overmapbuffer::pregenerate_around.
+ *
+ * The jobs run one at a time in the order they were queued. Generation reads the edges
+ * of the adjacent overmaps, a job only reads snapshots of them: of loaded overmaps taken
+ * when it's queued and of the results of jobs queued before it.
+ * Each job has its own seed and keeps its debug output until the main thread takes it over.
+ * The seed only depends on the world and the position of the overmap, so pregeneration
+ * neither depends on nor changes the random numbers of the main thread.
+ */
+class overmap_pregenerator
+{
+    public:
+        struct job {
+            enum class state : int {
+                queued, running, done, failed, canceled
+            };
+            std::unique_ptr<overmap> result;
+            // Snapshot of the result's edges, made once a later job needs it.
+            std::shared_ptr<const overmap> edges;
+            // Indexed like four_adjacent_offsets. An adjacent overmap is either loaded
+            // (then its snapshot is here), pending (then its job is here) or missing.
+            std::array<std::shared_ptr<const overmap>, 4> neighbours;
+            std::array<std::shared_ptr<job>, 4> neighbour_jobs;
+            // Follows from the world seed and the position, see pregeneration_seed.
+            unsigned int seed = 1;
+            // Copied from the game when queued, the worker doesn't read the game.
+            overmap::generation_context context;
+            // Shown on the main thread once the overmap is taken over.
+            captured_debug_output debug_output;
+            state status = state::queued;
+        };
+
+        ~overmap_pregenerator() {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            job_added.notify_all();
+            if( worker.joinable() ) {
+                worker.join();
+            }
+        }
+
+        std::shared_ptr<job> find( const point &p ) {
+            std::lock_guard<std::mutex> lock( mutex );
+            const auto iter = jobs.find( p );
+            return iter == jobs.end() ? nullptr : iter->second;
+        }
+
+        void enqueue( const point &p, const std::shared_ptr<job> &new_job ) {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                jobs[p] = new_job;
+                queue.push_back( new_job );
+                if( !worker.joinable() ) {
+                    worker = std::thread( &overmap_pregenerator::run, this );
+                }
+            }
+            job_added.notify_all();
+        }
+
+        /**
+         * Returns the overmap generated for @p p and forgets the job. Waits if it's being
+         * generated right now, cancels it if it hasn't started yet (returns null then).
+         */
+        std::unique_ptr<overmap> take( const point &p ) {
+            std::unique_lock<std::mutex> lock( mutex );
+            const auto iter = jobs.find( p );
+            if( iter == jobs.end() ) {
+                return nullptr;
+            }
+            const std::shared_ptr<job> taken = iter->second;
+            jobs.erase( iter );
+            if( taken->status == job::state::queued ) {
+                taken->status = job::state::canceled;
+                return nullptr;
+            }
+            job_done.wait( lock, [&]() {
+                return taken->status != job::state::running;
+            } );
+            if( taken->status != job::state::done ) {
+                // Generated again on the main thread, which reports the problems again.
+                return nullptr;
+            }
+            // Later jobs still need the edges, the caller is going to change the overmap.
+            if( taken.use_count() > 1 && !taken->edges ) {
+                taken->edges = taken->result->edge_snapshot();
+            }
+            std::unique_ptr<overmap> result = std::move( taken->result );
+            lock.unlock();
+
+            replay_debug_output( taken->debug_output );
+            return result;
+        }
+
+        /** The overmap generated for @p p, if its job is done (and it hasn't been taken yet). */
+        const overmap *find_generated( const point &p ) {
+            std::lock_guard<std::mutex> lock( mutex );
+            const auto iter = jobs.find( p );
+            if( iter == jobs.end() || iter->second->status != job::state::done ) {
+                return nullptr;
+            }
+            return iter->second->result.get();
+        }
+
+        /** Waits until no job is queued or running. */
+        void wait_all() {
+            std::unique_lock<std::mutex> lock( mutex );
+            job_done.wait( lock, [&]() {
+                return queue.empty() && !busy;
+            } );
+        }
+
+        void cancel_all() {
+            std::unique_lock<std::mutex> lock( mutex );
+            for( const std::shared_ptr<job> &pending : queue ) {
+                pending->status = job::state::canceled;
+            }
+            queue.clear();
+            jobs.clear();
+            job_done.wait( lock, [&]() {
+                return !busy;
+            } );
+        }
+
+    private:
+        void run() {
+            // The generation stages run on this thread, instead of competing with the main
+            // thread for the shared pool.
+            bypass_thread_pool bypass;
+            std::unique_lock<std::mutex> lock( mutex );
+            while( true ) {
+                job_added.wait( lock, [&]() {
+                    return stopping || !queue.empty();
+                } );
+                if( stopping ) {
+                    return;
+                }
+                const std::shared_ptr<job> current = queue.front();
+                queue.pop_front();
+                if( current->status != job::state::queued ) {
+                    job_done.notify_all();
+                    continue;
+                }
+
+                std::array<const overmap *, 4> neighbours;
+                bool usable = true;
+                for( size_t i = 0; i < neighbours.size(); i++ ) {
+                    neighbours[i] = current->neighbours[i].get();
+                    const std::shared_ptr<job> &neighbour_job = current->neighbour_jobs[i];
+                    if( !neighbour_job ) {
+                        continue;
+                    }
+                    if( neighbour_job->status != job::state::done ) {
+                        // Generated from a neighbour that is never going to exist.
+                        usable = false;
+                        break;
+                    }
+                    if( !neighbour_job->edges ) {
+                        neighbour_job->edges = neighbour_job->result->edge_snapshot();
+                    }
+                    neighbours[i] = neighbour_job->edges.get();
+                }
+                if( !usable ) {
+                    current->status = job::state::failed;
+                    job_done.notify_all();
+                    continue;
+                }
+                current->status = job::state::running;
+                busy = true;
+                lock.unlock();
+
+                bool generated = false;
+                try {
+                    capture_debug_output capture( current->debug_output );
+                    rng_set_engine_seed( current->seed );
+                    generated = current->result->generate_detached( neighbours[0], neighbours[1],
+                                neighbours[2], neighbours[3], current->context );
+                } catch( const std::exception & ) {
+                    // The main thread is going to generate it again, and report the error.
+                }
+                current->neighbours = {};
+                current->neighbour_jobs = {};
+
+                lock.lock();
+                busy = false;
+                current->status = generated ? job::state::done : job::state::failed;
+                job_done.notify_all();
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable job_added;
+        std::condition_variable job_done;
+        std::deque<std::shared_ptr<job>> queue;
+        // The jobs whose overmap hasn't been taken yet.
+        std::map<point, std::shared_ptr<job>> jobs;
+        bool busy = false;
+        bool stopping = false;
+        std::thread worker;
+};
+
 overmapbuffer overmap_buffer;
 
+static unsigned int pregeneration_seed( const unsigned int world_seed, const point &p )
+{
+    // Like boost::hash_combine, so that neighbouring overmaps get unrelated seeds.
+    unsigned int seed = world_seed;
+    seed ^= static_cast<unsigned int>( p.x ) + 0x9e3779b9U + ( seed << 6 ) + ( seed >> 2 );
+    seed ^= static_cast<unsigned int>( p.y ) + 0x9e3779b9U + ( seed << 6 ) + ( seed >> 2 );
+    // A zero seed would leave the engine of the worker as it is.
+    return std::max( seed, 1U );
+}
+
 overmapbuffer::overmapbuffer()
-    : last_requested_overmap( nullptr )
+    : last_requested_overmap( nullptr ), pregenerator( std::make_unique<overmap_pregenerator>() )
+{
+}
+
+overmapbuffer::~overmapbuffer()
 {
+    // Stops the worker now, the game may be destroyed after the buffer on exit and
+    // cancel the pregeneration then.
+    pregenerator.reset();
 }
 
 const city_reference city_reference::invalid{ nullptr, tripoint(), -1 };
@@ -80,6 +312,19 @@ overmap &overmapbuffer::get( const point &p )
         return *( last_requested_overmap = it->second.get() );
     }
 
+    if( std::unique_ptr<overmap> pregenerated = pregenerator->take( p ) ) {
+        overmap &new_om = *pregenerated;
+        add_pregenerated( std::move( pregenerated ) );
+        last_requested_overmap = &new_om;
+        return new_om;
+    }
+    claim_pregenerated_neighbours( p );
+    // Taking over the neighbours may have loaded this overmap as well.
+    const auto claimed = overmaps.find( p );
+    if( claimed != overmaps.end() ) {
+        return *( last_requested_overmap = claimed->second.get() );
+    }
+
     // That constructor loads an existing overmap or creates a new one.
     overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
     new_om.populate();
@@ -94,6 +339,9 @@ overmap &overmapbuffer::get( const point &p )
 
 void overmapbuffer::create_custom_overmap( const point &p, overmap_special_batch &specials )
 {
+    // Replaced by the custom one.
+    pregenerator->take( p );
+    claim_pregenerated_neighbours( p );
     if( last_requested_overmap != nullptr ) {
         auto om_iter = overmaps.find( p );
         if( om_iter != overmaps.end() && om_iter->second.get() == last_requested_overmap ) {
@@ -104,6 +352,90 @@ void overmapbuffer::create_custom_overmap( const point &p, overmap_special_batch
     new_om.populate( specials );
 }
 
+void overmapbuffer::pregenerate_around( const point &center )
+{
+    if( last_pregenerated_center && *last_pregenerated_center == center ) {
+        return;
+    }
+    last_pregenerated_center = center;
+
+    const auto missing = [this]( const point & p ) {
+        if( known_non_existing.count( p ) > 0 ) {
+            return true;
+        }
+        if( file_exist( terrain_filename( p ) ) ) {
+            return false;
+        }
+        known_non_existing.insert( p );
+        return true;
+    };
+    const overmap::generation_context context = overmap::prepare_detached_generation();
+    // Snapshots of the loaded overmaps, shared by the jobs next to them.
+    std::map<point, std::shared_ptr<const overmap>> snapshots;
+    for( const point &p : closest_points_first( center, 1 ) ) {
+        if( overmaps.count( p ) > 0 || pregenerator->find( p ) || !missing( p ) ) {
+            continue;
+        }
+        const auto new_job = std::make_shared<overmap_pregenerator::job>();
+        bool usable = true;
+        for( size_t i = 0; i < four_adjacent_offsets.size() && usable; i++ ) {
+            const point neighbour = p + four_adjacent_offsets[i];
+            const auto iter = overmaps.find( neighbour );
+            if( iter != overmaps.end() ) {
+                std::shared_ptr<const overmap> &snapshot = snapshots[neighbour];
+                if( !snapshot ) {
+                    snapshot = iter->second->edge_snapshot();
+                }
+                new_job->neighbours[i] = snapshot;
+            } else if( !( new_job->neighbour_jobs[i] = pregenerator->find( neighbour ) ) ) {
+                // A neighbour on disk would have to be loaded first, leave it to get.
+                usable = missing( neighbour );
+            }
+        }
+        if( usable ) {
+            new_job->seed = pregeneration_seed( context.world_seed, p );
+            new_job->context = context;
+            new_job->result = std::make_unique<overmap>( p );
+            pregenerator->enqueue( p, new_job );
+        }
+    }
+}
+
+void overmapbuffer::wait_for_pregeneration()
+{
+    pregenerator->wait_all();
+}
+
+const overmap *overmapbuffer::find_pregenerated( const point &p )
+{
+    return pregenerator->find_generated( p );
+}
+
+void overmapbuffer::cancel_pregeneration()
+{
+    if( !pregenerator ) {
+        return;
+    }
+    pregenerator->cancel_all();
+    last_pregenerated_center = cata::nullopt;
+}
+
+void overmapbuffer::claim_pregenerated_neighbours( const point &p )
+{
+    for( const point &offset : four_adjacent_offsets ) {
+        if( std::unique_ptr<overmap> pregenerated = pregenerator->take( p + offset ) ) {
+            add_pregenerated( std::move( pregenerated ) );
+        }
+    }
+}
+
+void overmapbuffer::add_pregenerated( std::unique_ptr<overmap> new_overmap )
+{
+    overmap &new_om = *( overmaps[new_overmap->pos()] = std::move( new_overmap ) );
+    fix_mongroups( new_om );
+    fix_npcs( new_om );
+}
+
 void overmapbuffer::fix_mongroups( overmap &new_overmap )
 {
     for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
@@ -195,6 +527,7 @@ void overmapbuffer::save()
 
 void overmapbuffer::clear()
 {
+    cancel_pregeneration();
     overmaps.clear();
     known_non_existing.clear();
     last_requested_overmap = nullptr;
@@ -923,6 +1256,82 @@ bool overmapbuffer::is_findable_location( const tripoint &location, const omt_fi
     return true;
 }
 
+// Position of @p offset (relative to the center) in the order of closest_points_first,
+// as (ring, index within the ring).
+static std::pair<int, int> spiral_order( const point &offset )
+{
+    const int r = std::max( std::abs( offset.x ), std::abs( offset.y ) );
+    if( r == 0 ) {
+        return { 0, 0 };
+    }
+    // Each ring starts at ( r, 1 - r ) and runs counterclockwise to ( r, -r ).
+    if( offset.x == r && offset.y > -r ) {
+        return { r, offset.y - ( 1 - r ) };
+    } else if( offset.y == r ) {
+        return { r, 2 * r - 1 + ( r - offset.x ) };
+    } else if( offset.x == -r ) {
+        return { r, 4 * r - 1 + ( r - offset.y ) };
+    }
+    return { r, 6 * r - 1 + ( offset.x + r ) };
+}
+
+bool overmapbuffer::find_indexed( const tripoint &origin, int min_dist, int max_dist,
+                                  const omt_find_params &params, bool closest_only,
+                                  std::vector<tripoint> &result )
+{
+    min_dist = std::max( min_dist, 0 );
+    if( min_dist > max_dist ) {
+        return true;
+    }
+    // The overmaps overlapping the search area, nearest first.
+    const point om_min = omt_to_om_copy( origin.xy() - point( max_dist, max_dist ) );
+    const point om_max = omt_to_om_copy( origin.xy() + point( max_dist, max_dist ) );
+    std::vector<std::pair<int, point>> oms;
+    for( int x = om_min.x; x <= om_max.x; x++ ) {
+        for( int y = om_min.y; y <= om_max.y; y++ ) {
+            const point corner = om_to_omt_copy( point( x, y ) );
+            const int dx = std::max( { corner.x - origin.x, origin.x - ( corner.x + OMAPX - 1 ), 0 } );
+            const int dy = std::max( { corner.y - origin.y, origin.y - ( corner.y + OMAPY - 1 ), 0 } );
+            oms.emplace_back( std::max( dx, dy ), point( x, y ) );
+        }
+    }
+    std::sort( oms.begin(), oms.end(), []( const std::pair<int, point> &a,
+    const std::pair<int, point> &b ) {
+        return a.first < b.first;
+    } );
+
+    cata::optional<int> closest;
+    std::vector<tripoint> locations;
+    for( const std::pair<int, point> &om_entry : oms ) {
+        if( closest && *closest < om_entry.first ) {
+            break;
+        }
+        const overmap *om = params.existing_only ? get_existing( om_entry.second ) :
+                            &get( om_entry.second );
+        if( om == nullptr ) {
+            continue;
+        }
+        locations.clear();
+        if( !om->find_indexed_terrain( params.types, params.om_special, locations ) ) {
+            return false;
+        }
+        const point offset = om_to_omt_copy( om_entry.second );
+        for( const tripoint &local : locations ) {
+            const tripoint loc = local + offset;
+            const int dist_xy = square_dist( origin.xy(), loc.xy() );
+            if( dist_xy < min_dist || dist_xy > max_dist || !is_findable_location( loc, params ) ) {
+                continue;
+            }
+            if( closest_only ) {
+                const int dist = square_dist( origin, loc );
+                closest = closest ? std::min( *closest, dist ) : dist;
+            }
+            result.push_back( loc );
+        }
+    }
+    return true;
+}
+
 tripoint overmapbuffer::find_closest( const tripoint &origin, const std::string &type,
                                       int const radius, bool must_be_seen,
                                       ot_match_type match_type,
@@ -962,6 +1371,29 @@ tripoint overmapbuffer::find_closest( const tripoint &origin, const omt_find_par
     std::vector<tripoint> result;
     cata::optional<int> found_dist;
 
+    std::vector<tripoint> candidates;
+    if( find_indexed( origin, min_dist, max_dist, params, true, candidates ) ) {
+        // Same selection as the scan below, in the same order.
+        const auto scan_order = [&origin]( const tripoint & p ) {
+            return std::make_tuple( spiral_order( p.xy() - origin.xy() ), p.z );
+        };
+        std::sort( candidates.begin(), candidates.end(), [&]( const tripoint & a,
+        const tripoint & b ) {
+            return scan_order( a ) < scan_order( b );
+        } );
+        for( const tripoint &loc : candidates ) {
+            if( found_dist && *found_dist < square_dist( origin.xy(), loc.xy() ) ) {
+                break;
+            }
+            const int dist = square_dist( origin, loc );
+            if( !found_dist || dist <= *found_dist ) {
+                found_dist = dist;
+                result.push_back( loc );
+            }
+        }
+        return random_entry( result, overmap::invalid_tripoint );
+    }
+
     for( const point &loc_xy : closest_points_first( origin.xy(), min_dist, max_dist ) ) {
         const int dist_xy = square_dist( origin.xy(), loc_xy );
 
@@ -995,6 +1427,16 @@ std::vector<tripoint> overmapbuffer::find_all( const tripoint &origin,
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX;
 
+    if( find_indexed( origin, min_dist, max_dist, params, false, result ) ) {
+        result.erase( std::remove_if( result.begin(), result.end(), [&origin]( const tripoint & p ) {
+            return p.z != origin.z;
+        } ), result.end() );
+        std::sort( result.begin(), result.end(), [&origin]( const tripoint & a, const tripoint & b ) {
+            return spiral_order( a.xy() - origin.xy() ) < spiral_order( b.xy() - origin.xy() );
+        } );
+        return result;
+    }
+
     for( const tripoint &loc : closest_tripoints_first( origin, min_dist, max_dist ) ) {
         if( is_findable_location( loc, params ) ) {
             result.push_back( loc );
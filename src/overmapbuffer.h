@@ -26,6 +26,7 @@ class character_id;
 class map_extra;
 class monster;
 class npc;
+class overmap_pregenerator;
 class vehicle;
 struct mongroup;
 struct regional_settings;
@@ -122,6 +123,7 @@ class overmapbuffer
 {
     public:
         overmapbuffer();
+        ~overmapbuffer();
 
         static std::string terrain_filename( const point & );
         static std::string player_filename( const point & );
@@ -129,10 +131,25 @@ class overmapbuffer
         /**
          * Uses overmap coordinates, that means x and y are directly
          * compared with the position of the overmap.
+         * If the overmap has been generated in the background, this takes it over
+         * (and waits for it if it's still being generated).
          */
         overmap &get( const point & );
         void save();
         void clear();
+
+        /**
+         * Starts generating the overmaps around @p p (overmap coordinates) that don't
+         * exist yet on a background thread, so @ref get doesn't have to generate them when
+         * they are needed. Until then they are not part of the buffer.
+         */
+        void pregenerate_around( const point &p );
+        /** Discards the overmaps generated in the background, waits for the one in progress. */
+        void cancel_pregeneration();
+        /** Waits until the background generation has nothing left to do. */
+        void wait_for_pregeneration();
+        /** The overmap generated in the background that @ref get would take over for @p p. */
+        const overmap *find_pregenerated( const point &p );
         void create_custom_overmap( const point &, overmap_special_batch &specials );
 
         /**
@@ -470,6 +487,17 @@ class overmapbuffer
          * see omt_find_params for definitions of the terms
          */
         bool is_findable_location( const tripoint &location, const omt_find_params &params );
+        /**
+         * Adds the locations within [min_dist, max_dist] (square distance in the xy-plane)
+         * of @p origin that match @p params to @p result, using the location index of the
+         * overmaps. With @p closest_only, overmaps that can't contain a match as close as
+         * the ones already found are skipped (and not generated).
+         * @returns false if the index can't answer the query, the locations must be
+         * scanned then.
+         */
+        bool find_indexed( const tripoint &origin, int min_dist, int max_dist,
+                           const omt_find_params &params, bool closest_only,
+                           std::vector<tripoint> &result );
 
         std::unordered_map< point, std::unique_ptr< overmap > > overmaps;
         /**
@@ -479,6 +507,9 @@ class overmapbuffer
         mutable std::set<point> known_non_existing;
         // Cached result of previous call to overmapbuffer::get_existing
         overmap mutable *last_requested_overmap;
+        std::unique_ptr<overmap_pregenerator> pregenerator;
+        // Center of the last pregenerate_around call, it has nothing new to do for the same one.
+        cata::optional<point> last_pregenerated_center;
 
         /**
          * Get a list of notes in the (loaded) overmaps.
@@ -519,6 +550,12 @@ class overmapbuffer
          * Moves out-of-bounds NPCs to the overmaps they should be in.
          */
         void fix_npcs( overmap &new_overmap );
+        /**
+         * Takes over the overmaps that were generated in the background next to @p p, so
+         * generating @p p sees them as its neighbours.
+         */
+        void claim_pregenerated_neighbours( const point &p );
+        void add_pregenerated( std::unique_ptr<overmap> new_overmap );
         /**
          * Retrieve overmaps that overlap the bounding box defined by the location and radius.
          * The location is in absolute submap coordinates, the radius is in the same system.
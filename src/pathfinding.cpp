@@ -1,7 +1,9 @@
 #include "pathfinding.h"
 
+#include <climits>
 #include <cstdlib>
 #include <algorithm>
+#include <iterator>
 #include <queue>
 #include <set>
 #include <array>
@@ -9,6 +11,7 @@
 #include <utility>
 #include <vector>
 
+#include "calendar.h"
 #include "cata_utility.h"
 #include "coordinates.h"
 #include "debug.h"
@@ -37,42 +40,68 @@ constexpr int flat_index( const int x, const int y )
 }
 
 // Flattened 2D array representing a single z-level worth of pathfinding data
+// A tile's state is only meaningful if its stamp matches the current generation of the layer,
+// so a new search only has to bump the generation instead of clearing everything.
 struct path_data_layer {
+    std::array< unsigned int, MAPSIZE_X *MAPSIZE_Y > stamp;
     // State is accessed way more often than all other values here
     std::array< astar_state, MAPSIZE_X *MAPSIZE_Y > state;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > score;
     std::array< int, MAPSIZE_X *MAPSIZE_Y > gscore;
     std::array< tripoint, MAPSIZE_X *MAPSIZE_Y > parent;
 
-    void init( const point &min, const point &max ) {
-        for( int x = min.x; x <= max.x; x++ ) {
-            for( int y = min.y; y <= max.y; y++ ) {
-                const int ind = flat_index( x, y );
-                state[ind] = ASL_NONE; // Mark as unvisited
-            }
+    unsigned int generation = 0;
+
+    path_data_layer() {
+        stamp.fill( 0 );
+    }
+
+    void reset() {
+        generation++;
+        if( generation == 0 ) {
+            // Wrapped around, old stamps could alias the new generation
+            stamp.fill( 0 );
+            generation = 1;
         }
     }
+
+    astar_state get_state( const int index ) const {
+        return stamp[index] == generation ? state[index] : ASL_NONE;
+    }
+
+    void set_state( const int index, const astar_state new_state ) {
+        stamp[index] = generation;
+        state[index] = new_state;
+    }
 };
 
+// Search buffers are big, so there is only one set of them, reused by every search
 struct pathfinder {
     point min;
     point max;
-    pathfinder( int _minx, int _miny, int _maxx, int _maxy ) :
-        min( _minx, _miny ), max( _maxx, _maxy ) {
-    }
 
-    std::priority_queue< std::pair<int, tripoint>, std::vector< std::pair<int, tripoint> >, pair_greater_cmp_first >
-    open;
+    std::vector< std::pair<int, tripoint> > open;
     std::array< std::unique_ptr< path_data_layer >, OVERMAP_LAYERS > path_data;
+    // Whether the layer was already reset for the current search
+    std::array< bool, OVERMAP_LAYERS > layer_in_use;
+
+    void reset( const point &_min, const point &_max ) {
+        min = _min;
+        max = _max;
+        open.clear();
+        layer_in_use.fill( false );
+    }
 
     path_data_layer &get_layer( const int z ) {
-        std::unique_ptr< path_data_layer > &ptr = path_data[z + OVERMAP_DEPTH];
-        if( ptr != nullptr ) {
-            return *ptr;
+        const int index = z + OVERMAP_DEPTH;
+        std::unique_ptr< path_data_layer > &ptr = path_data[index];
+        if( ptr == nullptr ) {
+            ptr = std::make_unique<path_data_layer>();
+        }
+        if( !layer_in_use[index] ) {
+            ptr->reset();
+            layer_in_use[index] = true;
         }
-
-        ptr = std::make_unique<path_data_layer>();
-        ptr->init( min, max );
         return *ptr;
     }
 
@@ -81,39 +110,47 @@ struct pathfinder {
     }
 
     tripoint get_next() {
-        const auto pt = open.top();
-        open.pop();
-        return pt.second;
+        std::pop_heap( open.begin(), open.end(), pair_greater_cmp_first() );
+        const tripoint pt = open.back().second;
+        open.pop_back();
+        return pt;
     }
 
     void add_point( const int gscore, const int score, const tripoint &from, const tripoint &to ) {
         auto &layer = get_layer( to.z );
         const int index = flat_index( to.x, to.y );
-        if( ( layer.state[index] == ASL_OPEN && gscore >= layer.gscore[index] ) ||
-            layer.state[index] == ASL_CLOSED ) {
+        const astar_state state = layer.get_state( index );
+        if( ( state == ASL_OPEN && gscore >= layer.gscore[index] ) || state == ASL_CLOSED ) {
             return;
         }
 
-        layer.state [index] = ASL_OPEN;
+        layer.set_state( index, ASL_OPEN );
         layer.gscore[index] = gscore;
         layer.parent[index] = from;
         layer.score [index] = score;
-        open.push( std::make_pair( score, to ) );
+        open.emplace_back( score, to );
+        std::push_heap( open.begin(), open.end(), pair_greater_cmp_first() );
     }
 
     void close_point( const tripoint &p ) {
         auto &layer = get_layer( p.z );
         const int index = flat_index( p.x, p.y );
-        layer.state[index] = ASL_CLOSED;
+        layer.set_state( index, ASL_CLOSED );
     }
 
     void unclose_point( const tripoint &p ) {
         auto &layer = get_layer( p.z );
         const int index = flat_index( p.x, p.y );
-        layer.state[index] = ASL_NONE;
+        layer.set_state( index, ASL_NONE );
     }
 };
 
+static pathfinder &get_pathfinder()
+{
+    static pathfinder pf;
+    return pf;
+}
+
 // Modifies `t` to be a tile with `flag` in the overmap tile that `t` was originally on
 // return false if it could not find a suitable point
 template<ter_bitflags flag>
@@ -177,6 +214,122 @@ bool is_disjoint( const Set1 &set1, const Set2 &set2 )
     return true;
 }
 
+bool pathfinding_settings::operator==( const pathfinding_settings &rhs ) const
+{
+    return same_costs( rhs ) && max_dist == rhs.max_dist && max_length == rhs.max_length &&
+           allow_climb_stairs == rhs.allow_climb_stairs;
+}
+
+bool pathfinding_settings::same_costs( const pathfinding_settings &rhs ) const
+{
+    return bash_strength == rhs.bash_strength && climb_cost == rhs.climb_cost &&
+           allow_open_doors == rhs.allow_open_doors && avoid_traps == rhs.avoid_traps &&
+           avoid_rough_terrain == rhs.avoid_rough_terrain && avoid_sharp == rhs.avoid_sharp;
+}
+
+static const pf_special non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
+
+// 7 3 5
+// 1 . 2
+// 6 4 8
+static constexpr std::array<int, 8> x_offset{{ -1,  1,  0,  0,  1, -1, -1, 1 }};
+static constexpr std::array<int, 8> y_offset{{  0,  0, -1,  1, -1,  1, -1, 1 }};
+
+// Whether none of the tiles of the remembered route starting at `first` changed since it was found
+static bool remembered_route_valid( const map &m, const route_memo::entry &e, size_t first )
+{
+    for( size_t i = first; i < e.path.size(); i++ ) {
+        const tripoint &p = e.path[i];
+        const pathfinding_cache &pf_cache = m.get_pathfinding_cache_ref( p.z );
+        if( pf_cache.changed_at[p.x][p.y] > e.generation[p.z + OVERMAP_DEPTH] ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void remember_route( route_memo &memo, route_memo::entry &&e )
+{
+    e.last_used = memo.clock;
+    if( memo.entries.size() < route_memo::max_entries ) {
+        memo.entries.emplace_back( std::move( e ) );
+        return;
+    }
+
+    auto oldest = std::min_element( memo.entries.begin(), memo.entries.end(),
+    []( const route_memo::entry & lhs, const route_memo::entry & rhs ) {
+        return lhs.last_used < rhs.last_used;
+    } );
+    *oldest = std::move( e );
+}
+
+// Tries to answer the query with the remainder of a remembered route that passes through `f`.
+// Routes to a tile next to `t` are extended by one step, as long as that doesn't happen too often.
+static bool find_remembered_route( const map &m, route_memo &memo, const tripoint &f,
+                                   const tripoint &t, const pathfinding_settings &settings,
+                                   std::vector<tripoint> &ret )
+{
+    const tripoint abs_sub = m.get_abs_sub();
+    for( route_memo::entry &e : memo.entries ) {
+        if( e.abs_sub != abs_sub || e.settings != settings || e.last_used == INT_MIN ) {
+            continue;
+        }
+
+        const bool exact = e.to == t;
+        if( !exact && ( e.to.z != t.z || square_dist( e.to, t ) != 1 ||
+                        e.repairs >= route_memo::max_repairs ) ) {
+            continue;
+        }
+
+        const auto start = std::find( e.path.begin(), e.path.end(), f );
+        if( start == e.path.end() ) {
+            continue;
+        }
+
+        const size_t first = std::distance( e.path.begin(), start ) + 1;
+        if( !remembered_route_valid( m, e, first ) ) {
+            // Don't bother checking it again, it will be the first to be replaced
+            e.last_used = INT_MIN;
+            continue;
+        }
+
+        if( exact ) {
+            e.last_used = memo.clock;
+            ret.assign( e.path.begin() + first, e.path.end() );
+            return true;
+        }
+
+        // The target moved by a single tile, either back onto the route or right next to its end
+        route_memo::entry repaired;
+        const auto on_route = std::find( start, e.path.end(), t );
+        if( on_route != e.path.end() ) {
+            repaired.path.assign( start, on_route + 1 );
+        } else {
+            if( m.get_pathfinding_cache_ref( t.z ).special[t.x][t.y] & non_normal ) {
+                continue;
+            }
+            if( static_cast<int>( e.path.size() - first ) + 1 > settings.max_length ) {
+                continue;
+            }
+            repaired.path.assign( start, e.path.end() );
+            repaired.path.push_back( t );
+        }
+
+        repaired.abs_sub = abs_sub;
+        repaired.to = t;
+        repaired.settings = settings;
+        repaired.generation = e.generation;
+        repaired.generation[t.z + OVERMAP_DEPTH] = m.get_pathfinding_cache_ref( t.z ).generation;
+        repaired.repairs = e.repairs + 1;
+        ret.assign( repaired.path.begin() + 1, repaired.path.end() );
+        remember_route( memo, std::move( repaired ) );
+        return true;
+    }
+
+    return false;
+}
+
 std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                   const pathfinding_settings &settings,
                                   const std::set<tripoint> &pre_closed ) const
@@ -197,7 +350,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     }
     // First, check for a simple straight line on flat ground
     // Except when the line contains a pre-closed tile - we need to do regular pathing then
-    static const auto non_normal = PF_SLOW | PF_WALL | PF_VEHICLE | PF_TRAP | PF_SHARP;
     if( f.z == t.z ) {
         const auto line_path = line_to( f, t );
         const auto &pf_cache = get_pathfinding_cache_ref( f.z );
@@ -218,6 +370,19 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return ret;
     }
 
+    // Routes avoiding specific tiles are too situational to be worth remembering
+    const bool use_memo = pre_closed.empty();
+    route_memo &memo = *route_memory;
+    if( use_memo ) {
+        if( ++memo.clock == INT_MAX ) {
+            memo.clear();
+            memo.clock = 0;
+        }
+        if( find_remembered_route( *this, memo, f, t, settings, ret ) ) {
+            return ret;
+        }
+    }
+
     int max_length = settings.max_length;
     int bash = settings.bash_strength;
     int climb_cost = settings.climb_cost;
@@ -238,7 +403,8 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     clip_to_bounds( minx, miny, minz );
     clip_to_bounds( maxx, maxy, maxz );
 
-    pathfinder pf( minx, miny, maxx, maxy );
+    pathfinder &pf = get_pathfinder();
+    pf.reset( point( minx, miny ), point( maxx, maxy ) );
     // Make NPCs not want to path through player
     // But don't make player pathing stop working
     for( const auto &p : pre_closed ) {
@@ -259,8 +425,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         const int parent_index = flat_index( cur.x, cur.y );
         auto &layer = pf.get_layer( cur.z );
-        auto &cur_state = layer.state[parent_index];
-        if( cur_state == ASL_CLOSED ) {
+        if( layer.get_state( parent_index ) == ASL_CLOSED ) {
             continue;
         }
 
@@ -274,16 +439,11 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             break;
         }
 
-        cur_state = ASL_CLOSED;
+        layer.set_state( parent_index, ASL_CLOSED );
 
         const auto &pf_cache = get_pathfinding_cache_ref( cur.z );
         const auto cur_special = pf_cache.special[cur.x][cur.y];
 
-        // 7 3 5
-        // 1 . 2
-        // 6 4 8
-        constexpr std::array<int, 8> x_offset{{ -1,  1,  0,  0,  1, -1, -1, 1 }};
-        constexpr std::array<int, 8> y_offset{{  0,  0, -1,  1, -1,  1, -1, 1 }};
         for( size_t i = 0; i < 8; i++ ) {
             const tripoint p( cur.x + x_offset[i], cur.y + y_offset[i], cur.z );
             const int index = flat_index( p.x, p.y );
@@ -293,7 +453,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 continue;
             }
 
-            if( layer.state[index] == ASL_CLOSED ) {
+            if( layer.get_state( index ) == ASL_CLOSED ) {
                 continue;
             }
 
@@ -307,7 +467,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 newg += 2;
             } else {
                 if( roughavoid ) {
-                    layer.state[index] = ASL_CLOSED; // Close all rough terrain tiles
+                    layer.set_state( index, ASL_CLOSED ); // Close all rough terrain tiles
                     continue;
                 }
 
@@ -324,7 +484,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
                 if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
                     climb_cost <= 0 ) {
-                    layer.state[index] = ASL_CLOSED; // Close it so that next time we won't try to calculate costs
+                    layer.set_state( index, ASL_CLOSED ); // Close it so that next time we won't try to calculate costs
                     continue;
                 }
 
@@ -354,7 +514,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                             int hp = veh->parts[part].hp();
                             if( hp / 20 > bash ) {
                                 // Threshold damage thing means we just can't bash this down
-                                layer.state[index] = ASL_CLOSED;
+                                layer.set_state( index, ASL_CLOSED );
                                 continue;
                             } else if( hp / 10 > bash ) {
                                 // Threshold damage thing means we will fail to deal damage pretty often
@@ -365,7 +525,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                         } else if( part >= 0 ) {
                             if( !doors || !veh->part_flag( part, VPFLAG_OPENABLE ) ) {
                                 // Won't be openable, don't try from other sides
-                                layer.state[index] = ASL_CLOSED;
+                                layer.set_state( index, ASL_CLOSED );
                             }
 
                             continue;
@@ -381,7 +541,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                         // Unbashable and unopenable from here
                         if( !doors || !terrain.open || !furniture.open ) {
                             // Or anywhere else for that matter
-                            layer.state[index] = ASL_CLOSED;
+                            layer.set_state( index, ASL_CLOSED );
                         }
 
                         continue;
@@ -400,7 +560,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                 tripoint below( p.xy(), p.z - 1 );
                                 if( !has_flag( TFLAG_NO_FLOOR, below ) ) {
                                     // Otherwise this would have been a huge fall
-                                    auto &layer = pf.get_layer( p.z - 1 );
                                     // From cur, not p, because we won't be walking on air
                                     pf.add_point( layer.gscore[parent_index] + 10,
                                                   layer.score[parent_index] + 10 + 2 * rl_dist( below, t ),
@@ -408,7 +567,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                                 }
 
                                 // Close p, because we won't be walking on it
-                                layer.state[index] = ASL_CLOSED;
+                                layer.set_state( index, ASL_CLOSED );
                                 continue;
                             }
                         } else if( trapavoid ) {
@@ -419,14 +578,14 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 }
 
                 if( sharpavoid && p_special & PF_SHARP ) {
-                    layer.state[index] = ASL_CLOSED; // Avoid sharp things
+                    layer.set_state( index, ASL_CLOSED ); // Avoid sharp things
                 }
 
             }
 
             // If not visited, add as open
             // If visited, add it only if we can do so with better score
-            if( layer.state[index] == ASL_NONE || newg < layer.gscore[index] ) {
+            if( layer.get_state( index ) == ASL_NONE || newg < layer.gscore[index] ) {
                 pf.add_point( newg, newg + 2 * rl_dist( p, t ), cur, p );
             }
         }
@@ -441,7 +600,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         if( settings.allow_climb_stairs && cur.z > minz && parent_terrain.has_flag( TFLAG_GOES_DOWN ) ) {
             tripoint dest( cur.xy(), cur.z - 1 );
             if( vertical_move_destination<TFLAG_GOES_UP>( *this, dest ) ) {
-                auto &layer = pf.get_layer( dest.z );
                 pf.add_point( layer.gscore[parent_index] + 2,
                               layer.score[parent_index] + 2 * rl_dist( dest, t ),
                               cur, dest );
@@ -450,7 +608,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         if( settings.allow_climb_stairs && cur.z < maxz && parent_terrain.has_flag( TFLAG_GOES_UP ) ) {
             tripoint dest( cur.xy(), cur.z + 1 );
             if( vertical_move_destination<TFLAG_GOES_DOWN>( *this, dest ) ) {
-                auto &layer = pf.get_layer( dest.z );
                 pf.add_point( layer.gscore[parent_index] + 2,
                               layer.score[parent_index] + 2 * rl_dist( dest, t ),
                               cur, dest );
@@ -458,7 +615,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         }
         if( cur.z < maxz && parent_terrain.has_flag( TFLAG_RAMP ) &&
             valid_move( cur, tripoint( cur.xy(), cur.z + 1 ), false, true ) ) {
-            auto &layer = pf.get_layer( cur.z + 1 );
             for( size_t it = 0; it < 8; it++ ) {
                 const tripoint above( cur.x + x_offset[it], cur.y + y_offset[it], cur.z + 1 );
                 pf.add_point( layer.gscore[parent_index] + 4,
@@ -493,7 +649,256 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         }
 
         std::reverse( ret.begin(), ret.end() );
+
+        if( use_memo && !ret.empty() ) {
+            route_memo::entry e;
+            e.abs_sub = get_abs_sub();
+            e.to = t;
+            e.settings = settings;
+            e.path.reserve( ret.size() + 1 );
+            e.path.push_back( f );
+            e.path.insert( e.path.end(), ret.begin(), ret.end() );
+            e.generation.fill( 0 );
+            for( int z = minz; z <= maxz; z++ ) {
+                e.generation[z + OVERMAP_DEPTH] = get_pathfinding_cache_ref( z ).generation;
+            }
+            remember_route( memo, std::move( e ) );
+        }
     }
 
     return ret;
 }
+
+int map::flow_enter_cost( const tripoint &p, const pf_special p_special,
+                          const pathfinding_settings &settings ) const
+{
+    if( !( p_special & non_normal ) ) {
+        return 2;
+    }
+    if( settings.avoid_rough_terrain || ( settings.avoid_sharp && p_special & PF_SHARP ) ) {
+        return -1;
+    }
+
+    const int bash = settings.bash_strength;
+    const bool doors = settings.allow_open_doors;
+
+    int part = -1;
+    const maptile &tile = maptile_at_internal( p );
+    const auto &terrain = tile.get_ter_t();
+    const auto &furniture = tile.get_furn_t();
+    const vehicle *veh = veh_at_internal( p, part );
+
+    int cost = move_cost_internal( furniture, terrain, veh, part );
+    if( cost == 0 ) {
+        const int rating = bash == 0 ? -1 :
+                           bash_rating_internal( bash, furniture, terrain, false, veh, part );
+        if( settings.climb_cost > 0 && p_special & PF_CLIMBABLE ) {
+            cost += settings.climb_cost;
+        } else if( doors && ( terrain.open || furniture.open ) &&
+                   ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ) ) {
+            cost += 4;
+        } else if( veh != nullptr ) {
+            const auto vpobst = vpart_position( const_cast<vehicle &>( *veh ), part ).obstacle_at_part();
+            part = vpobst ? vpobst->part_index() : -1;
+            // Doors that only open from the inside depend on where we come from, so don't count on them
+            if( doors && veh->part_flag( part, VPFLAG_OPENABLE ) &&
+                !veh->part_flag( part, "OPENCLOSE_INSIDE" ) ) {
+                cost += 10;
+            } else if( part >= 0 && bash > 0 ) {
+                int hp = veh->parts[part].hp();
+                if( hp / 20 > bash ) {
+                    return -1;
+                } else if( hp / 10 > bash ) {
+                    hp *= 2;
+                }
+                cost += 2 * hp / bash + 8 + 4;
+            } else if( part >= 0 ) {
+                return -1;
+            }
+        } else if( rating > 1 ) {
+            cost += ( 20 / rating ) + 2 + 10;
+        } else if( rating == 1 ) {
+            cost += 500;
+        } else {
+            return -1;
+        }
+    }
+
+    if( settings.avoid_traps && p_special & PF_TRAP ) {
+        const auto &ter_trp = terrain.trap.obj();
+        const auto &trp = ter_trp.is_benign() ? tile.get_trap_t() : ter_trp;
+        if( !trp.is_benign() ) {
+            if( !has_zlevels() || !terrain.has_flag( TFLAG_NO_FLOOR ) ) {
+                return -1;
+            }
+            // A ledge is only used to drop to the floor below, which route() has to plan
+            if( valid_move( p, tripoint( p.xy(), p.z - 1 ), false, true ) ) {
+                return -1;
+            }
+        }
+    }
+
+    return cost;
+}
+
+void map::build_flow_field( flow_field &field ) const
+{
+    field.distance.fill( flow_field::unreachable );
+
+    const tripoint &t = field.target;
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( t.z );
+    int minx = t.x - field.max_dist;
+    int miny = t.y - field.max_dist;
+    int maxx = t.x + field.max_dist;
+    int maxy = t.y + field.max_dist;
+    clip_to_bounds( minx, miny );
+    clip_to_bounds( maxx, maxy );
+
+    // Searching backwards from the target: the cost of a step is paid by the tile closer to it
+    std::priority_queue< std::pair<int, int>, std::vector< std::pair<int, int> >, pair_greater_cmp_first >
+    open;
+    field.distance[flat_index( t.x, t.y )] = 0;
+    open.emplace( 0, flat_index( t.x, t.y ) );
+    while( !open.empty() ) {
+        const std::pair<int, int> cur = open.top();
+        open.pop();
+        if( cur.first > field.distance[cur.second] ) {
+            continue;
+        }
+
+        const tripoint p( cur.second / MAPSIZE_Y, cur.second % MAPSIZE_Y, t.z );
+        const int enter_cost = flow_enter_cost( p, pf_cache.special[p.x][p.y], field.settings );
+        if( enter_cost < 0 ) {
+            continue;
+        }
+
+        for( size_t i = 0; i < 8; i++ ) {
+            const point n( p.x + x_offset[i], p.y + y_offset[i] );
+            if( n.x < minx || n.x > maxx || n.y < miny || n.y > maxy ) {
+                continue;
+            }
+            // Penalize for diagonals, same as route() does
+            const int dist = cur.first + enter_cost + ( i >= 4 ? 1 : 0 );
+            const int index = flat_index( n.x, n.y );
+            if( dist <= field.max_length && dist < field.distance[index] ) {
+                field.distance[index] = dist;
+                open.emplace( dist, index );
+            }
+        }
+    }
+}
+
+const flow_field &map::get_flow_field( const tripoint &t,
+                                       const pathfinding_settings &settings ) const
+{
+    flow_field_cache &cache = *flow_fields;
+    if( ++cache.clock == INT_MAX ) {
+        cache.fields.clear();
+        cache.clock = 0;
+    }
+
+    const tripoint abs_sub = get_abs_sub();
+    const int turn = to_turn<int>( calendar::turn );
+    const int generation = get_pathfinding_cache_ref( t.z ).generation;
+    std::unique_ptr<flow_field> *slot = nullptr;
+    for( std::unique_ptr<flow_field> &field : cache.fields ) {
+        if( field->target != t || !field->settings.same_costs( settings ) ) {
+            continue;
+        }
+        if( field->abs_sub == abs_sub && field->turn == turn && field->generation == generation &&
+            field->max_dist >= settings.max_dist && field->max_length >= settings.max_length ) {
+            field->last_used = cache.clock;
+            return *field;
+        }
+        // Outdated or too small, rebuild in place
+        slot = &field;
+        break;
+    }
+
+    int max_dist = settings.max_dist;
+    int max_length = settings.max_length;
+    if( slot != nullptr ) {
+        if( ( *slot )->abs_sub == abs_sub && ( *slot )->turn == turn &&
+            ( *slot )->generation == generation ) {
+            max_dist = std::max( max_dist, ( *slot )->max_dist );
+            max_length = std::max( max_length, ( *slot )->max_length );
+        }
+    } else if( cache.fields.size() < flow_field_cache::max_fields ) {
+        cache.fields.emplace_back( std::make_unique<flow_field>() );
+        slot = &cache.fields.back();
+    } else {
+        slot = &*std::min_element( cache.fields.begin(), cache.fields.end(),
+                                   []( const std::unique_ptr<flow_field> &lhs, const std::unique_ptr<flow_field> &rhs ) {
+            return lhs->last_used < rhs->last_used;
+        } );
+    }
+
+    flow_field &field = **slot;
+    field.target = t;
+    field.abs_sub = abs_sub;
+    field.settings = settings;
+    field.max_dist = max_dist;
+    field.max_length = max_length;
+    field.turn = turn;
+    field.generation = generation;
+    field.last_used = cache.clock;
+    build_flow_field( field );
+    return field;
+}
+
+cata::optional<tripoint> map::flow_step( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings ) const
+{
+    if( f == t || f.z != t.z || !inbounds( f ) ) {
+        return cata::nullopt;
+    }
+
+    if( !inbounds( t ) ) {
+        tripoint clipped = t;
+        clip_to_bounds( clipped );
+        return flow_step( f, clipped, settings );
+    }
+
+    // Same shortcut as in route(), straight lines look more natural than following the field
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( f.z );
+    const std::vector<tripoint> line_path = line_to( f, t );
+    if( std::all_of( line_path.begin(), line_path.end(), [&pf_cache]( const tripoint & p ) {
+    return !( pf_cache.special[p.x][p.y] & non_normal );
+    } ) ) {
+        return line_path.front();
+    }
+
+    if( rl_dist( f, t ) > settings.max_dist ) {
+        return cata::nullopt;
+    }
+
+    const flow_field &field = get_flow_field( t, settings );
+    const int dist = field.distance_at( f );
+    if( dist == flow_field::unreachable || dist > settings.max_length ) {
+        return cata::nullopt;
+    }
+
+    cata::optional<tripoint> best;
+    int best_dist = flow_field::unreachable;
+    for( size_t i = 0; i < 8; i++ ) {
+        const tripoint n( f.x + x_offset[i], f.y + y_offset[i], f.z );
+        if( !inbounds( n ) ) {
+            continue;
+        }
+        const int n_dist = field.distance_at( n );
+        if( n_dist == flow_field::unreachable ) {
+            continue;
+        }
+        const int enter_cost = flow_enter_cost( n, pf_cache.special[n.x][n.y], settings );
+        if( enter_cost < 0 ) {
+            continue;
+        }
+        const int total = n_dist + enter_cost + ( i >= 4 ? 1 : 0 );
+        if( total < best_dist || ( total == best_dist && rl_dist( n, t ) < rl_dist( *best, t ) ) ) {
+            best = n;
+            best_dist = total;
+        }
+    }
+
+    return best;
+}
@@ -2,7 +2,13 @@
 #ifndef CATA_SRC_PATHFINDING_H
 #define CATA_SRC_PATHFINDING_H
 
+#include <array>
+#include <climits>
+#include <memory>
+#include <vector>
+
 #include "game_constants.h"
+#include "point.h"
 
 enum pf_special : int {
     PF_NORMAL = 0x00,    // Plain boring tile (grass, dirt, floor etc.)
@@ -43,8 +49,12 @@ struct pathfinding_cache {
     ~pathfinding_cache();
 
     bool dirty;
+    // Incremented every time the cache is rebuilt
+    int generation;
 
     pf_special special[MAPSIZE_X][MAPSIZE_Y];
+    // Generation in which the tile last changed in a way that could affect path costs
+    int changed_at[MAPSIZE_X][MAPSIZE_Y];
 };
 
 struct pathfinding_settings {
@@ -70,6 +80,80 @@ struct pathfinding_settings {
         : bash_strength( bs ), max_dist( md ), max_length( ml ), climb_cost( cc ),
           allow_open_doors( aod ), avoid_traps( at ), allow_climb_stairs( acs ), avoid_rough_terrain( art ),
           avoid_sharp( as ) {}
+
+    bool operator==( const pathfinding_settings &rhs ) const;
+    // Whether both settings allow and price the same moves, regardless of distance limits
+    bool same_costs( const pathfinding_settings &rhs ) const;
+    bool operator!=( const pathfinding_settings &rhs ) const {
+        return !( *this == rhs );
+    }
+};
+
+/**
+ * Recently found routes, kept so that repeated queries toward the same target
+ * (a horde chasing the player, a monster re-planning every turn) can reuse the
+ * remainder of a still valid path instead of running a new search.
+ * A route stays valid until one of its tiles changes in the @ref pathfinding_cache
+ * or the map is shifted.
+ */
+struct route_memo {
+    struct entry {
+        tripoint abs_sub;
+        tripoint to;
+        pathfinding_settings settings;
+        // Includes the starting point
+        std::vector<tripoint> path;
+        // @ref pathfinding_cache::generation of every z-level at the time of search
+        std::array<int, OVERMAP_LAYERS> generation;
+        // How many times the target was extended by a single step instead of searching
+        int repairs = 0;
+        int last_used = 0;
+    };
+
+    static constexpr size_t max_entries = 16;
+    // Number of target extensions before a fresh search is forced
+    static constexpr int max_repairs = 8;
+
+    std::vector<entry> entries;
+    int clock = 0;
+
+    void clear() {
+        entries.clear();
+    }
+};
+
+/**
+ * Distance to a single target from every tile of its z-level within a bounded area.
+ * Built once per target, settings cost class and turn, then shared by every creature
+ * that paths toward that target, which makes a horde converging on the player cost
+ * one search instead of one per monster.
+ */
+struct flow_field {
+    static constexpr int unreachable = INT_MAX;
+
+    tripoint target;
+    tripoint abs_sub;
+    // Only the cost related settings matter, distance limits are below
+    pathfinding_settings settings;
+    int max_dist = 0;
+    int max_length = 0;
+    // Turn and @ref pathfinding_cache::generation the field was built for
+    int turn = 0;
+    int generation = 0;
+    int last_used = 0;
+
+    std::array<int, MAPSIZE_X *MAPSIZE_Y> distance;
+
+    int distance_at( const tripoint &p ) const {
+        return distance[p.x * MAPSIZE_Y + p.y];
+    }
+};
+
+struct flow_field_cache {
+    static constexpr size_t max_fields = 8;
+
+    std::vector<std::unique_ptr<flow_field>> fields;
+    int clock = 0;
 };
 
 #endif // CATA_SRC_PATHFINDING_H
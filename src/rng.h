@@ -14,9 +14,9 @@
 class time_duration;
 
 // All PRNG functions use an engine, see the C++11 <random> header
-// By default, that engine is seeded by time on first call to such a function.
+// Each thread has its own engine, seeded by time on first call to such a function.
 // If this function is called with a non-zero seed then the engine will be
-// seeded (or re-seeded) with the given seed.
+// seeded (or re-seeded) with the given seed. This only affects the calling thread.
 void rng_set_engine_seed( unsigned int seed );
 
 using cata_default_random_engine = std::minstd_rand0;
@@ -919,6 +919,7 @@ void overmap::load_legacy_monstergroups( JsonIn &jsin )
 // throws std::exception
 void overmap::unserialize( std::istream &fin )
 {
+    location_index_valid = false;
     chkversion( fin );
     JsonIn jsin( fin );
     jsin.start_object();
@@ -2334,9 +2334,11 @@ void item::io( Archive &archive )
 
 void item::deserialize( JsonIn &jsin )
 {
-    const JsonObject data = jsin.get_object();
-    io::JsonObjectInputArchive archive( data );
-    io( archive );
+    const JsonObject obj = jsin.get_object();
+    // The archive is a copy of the object, it has to be the one that tracks the visited members
+    io::JsonObjectInputArchive data( obj );
+    obj.allow_omitted_members();
+    io( data );
     // made for fast forwarding time from 0.D to 0.E
     if( savegame_loading_version < 27 ) {
         legacy_fast_forward_time();
@@ -3665,6 +3667,11 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
+    store_extras( jsout );
+}
+
+void submap::store_extras( JsonOut &jsout ) const
+{
     // Write out as array of arrays of single entries
     jsout.member( "cosmetics" );
     jsout.start_array();
@@ -3741,6 +3748,22 @@ void submap::store( JsonOut &jsout ) const
     }
 }
 
+void submap::add_loaded_item( const point &p, item &tmp, int version )
+{
+    if( tmp.is_emissive() ) {
+        update_lum_add( p, tmp );
+    }
+
+    if( savegame_loading_version >= 27 && version < 27 ) {
+        tmp.legacy_fast_forward_time();
+    }
+
+    const cata::colony<item>::iterator it = itm[p.x][p.y].insert( tmp );
+    if( tmp.needs_processing() ) {
+        active_items.add( *it, p );
+    }
+}
+
 void submap::load( JsonIn &jsin, const std::string &member_name, int version )
 {
     bool rubpow_update = version < 22;
@@ -3844,19 +3867,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
             while( !jsin.end_array() ) {
                 item tmp;
                 jsin.read( tmp );
-
-                if( tmp.is_emissive() ) {
-                    update_lum_add( p, tmp );
-                }
-
-                if( savegame_loading_version >= 27 && version < 27 ) {
-                    tmp.legacy_fast_forward_time();
-                }
-
-                const cata::colony<item>::iterator it = itm[p.x][p.y].insert( tmp );
-                if( tmp.needs_processing() ) {
-                    active_items.add( *it, p );
-                }
+                add_loaded_item( p, tmp, version );
             }
         }
     } else if( member_name == "traps" ) {
@@ -3900,10 +3911,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version )
                 } else {
                     ft = field_types::get_field_type_by_legacy_enum( type_int ).id;
                 }
-                if( fld[i][j].find_field( ft ) == nullptr ) {
-                    field_count++;
-                }
-                fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) );
+                add_field( { i, j }, ft, intensity, time_duration::from_turns( age ) );
             }
         }
     } else if( member_name == "graffiti" ) {
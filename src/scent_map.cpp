@@ -159,91 +159,88 @@ void scent_map::update( const tripoint &center, map &m )
         return;
     }
 
-    // note: the next four intermediate matrices need to be at least
-    // [2*SCENT_RADIUS+3][2*SCENT_RADIUS+1] in size to hold enough data
-    // The code I'm modifying used [MAPSIZE_X]. I'm staying with that to avoid new bugs.
-
-    // These two matrices are transposed so that x addresses are contiguous in memory
-    scent_array<int> sum_3_scent_y;
-    scent_array<int> squares_used_y;
-
     // these are for caching flag lookups
     scent_array<bool> blocks_scent; // currently only TFLAG_NO_SCENT blocks scent
     scent_array<bool> reduces_scent;
 
     // for loop constants
-    const int scentmap_minx = center.x - SCENT_RADIUS;
-    const int scentmap_maxx = center.x + SCENT_RADIUS;
-    const int scentmap_miny = center.y - SCENT_RADIUS;
-    const int scentmap_maxy = center.y + SCENT_RADIUS;
+    const point scentmap_min( center.x - SCENT_RADIUS, center.y - SCENT_RADIUS );
+    const point scentmap_max( center.x + SCENT_RADIUS, center.y + SCENT_RADIUS );
 
+    // The new scent flag searching function. Should be wayyy faster than the old one.
+    m.scent_blockers( blocks_scent, reduces_scent, scentmap_min + point_north_west,
+                      scentmap_max + point_south_east );
+    diffuse( grscent, blocks_scent, reduces_scent, scentmap_min, scentmap_max );
+}
+
+void scent_map::diffuse( scent_array<int> &grscent, const scent_array<bool> &blocks_scent,
+                         const scent_array<bool> &reduces_scent, const point &min, const point &max )
+{
     // decrease this to reduce gas spread. Keep it under 125 for
     // stability. This is essentially a decimal number * 1000.
-    const int diffusivity = 100;
+    constexpr int diffusivity = 100;
+
+    // All loops below go over y in the inner loop, which is contiguous in memory, and don't
+    // branch on the blockers, so the compiler can vectorize them.
+    // Blocking squares don't take part in diffusion and only 20% of scent can diffuse
+    // on REDUCE_SCENT squares, precompute that as a weight per square.
+    // note: these need to be one square larger on each side than the final scent matrix.
+    scent_array<int> weight;
+    for( int x = min.x - 1; x <= max.x + 1; ++x ) {
+        const bool *blocks = blocks_scent[x].data();
+        const bool *reduces = reduces_scent[x].data();
+        int *w = weight[x].data();
+        for( int y = min.y - 1; y <= max.y + 1; ++y ) {
+            w[y] = ( 1 - blocks[y] ) * ( 10 - 8 * reduces[y] );
+        }
+    }
 
-    // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( blocks_scent, reduces_scent, point( scentmap_minx - 1, scentmap_miny - 1 ),
-                      point( scentmap_maxx + 1, scentmap_maxy + 1 ) );
     // Sum neighbors in the y direction.  This way, each square gets called 3 times instead of 9
-    // times. This cost us an extra loop here, but it also eliminated a loop at the end, so there
-    // is a net performance improvement over the old code. Could probably still be better.
-    // note: this method needs an array that is one square larger on each side in the x direction
-    // than the final scent matrix. I think this is fine since SCENT_RADIUS is less than
-    // MAPSIZE_X, but if that changes, this may need tweaking.
-    for( int x = scentmap_minx - 1; x <= scentmap_maxx + 1; ++x ) {
-        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
+    // times.
+    scent_array<int> sum_3_scent_y;
+    scent_array<int> squares_used_y;
+    for( int x = min.x - 1; x <= max.x + 1; ++x ) {
+        const int *w = weight[x].data();
+        const int *scent = grscent[x].data();
+        int *sum_3 = sum_3_scent_y[x].data();
+        int *squares_used = squares_used_y[x].data();
+        for( int y = min.y; y <= max.y; ++y ) {
             // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-            sum_3_scent_y[y][x] = 0;
-            squares_used_y[y][x] = 0;
-            for( int i = y - 1; i <= y + 1; ++i ) {
-                if( !blocks_scent[x][i] ) {
-                    if( reduces_scent[x][i] ) {
-                        // only 20% of scent can diffuse on REDUCE_SCENT squares
-                        sum_3_scent_y[y][x] += 2 * grscent[x][i];
-                        squares_used_y[y][x] += 2;
-                    } else {
-                        sum_3_scent_y[y][x] += 10 * grscent[x][i];
-                        squares_used_y[y][x] += 10;
-                    }
-                }
-            }
+            sum_3[y] = w[y - 1] * scent[y - 1] + w[y] * scent[y] + w[y + 1] * scent[y + 1];
+            squares_used[y] = w[y - 1] + w[y] + w[y + 1];
         }
     }
 
     // Rest of the scent map
-    for( int x = scentmap_minx; x <= scentmap_maxx; ++x ) {
-        for( int y = scentmap_miny; y <= scentmap_maxy; ++y ) {
-            int &scent_here = grscent[x][y];
-            if( !blocks_scent[x][y] ) {
-                // to how many neighboring squares do we diffuse out? (include our own square
-                // since we also include our own square when diffusing in)
-                const int squares_used = squares_used_y[y][x - 1]
-                                         + squares_used_y[y][x]
-                                         + squares_used_y[y][x + 1];
-
-                int this_diffusivity;
-                if( !reduces_scent[x][y] ) {
-                    this_diffusivity = diffusivity;
-                } else {
-                    this_diffusivity = diffusivity / 5; //less air movement for REDUCE_SCENT square
-                }
-                // take the old scent and subtract what diffuses out
-                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
-                // neighboring REDUCE_SCENT squares absorb some scent
-                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
-                // we've already summed neighboring scent values in the y direction in the previous
-                // loop. Now we do it for the x direction, multiply by diffusion, and this is what
-                // diffuses into our current square.
-                scent_here =
-                    ( temp_scent
-                      + this_diffusivity * ( sum_3_scent_y[y][x - 1]
-                                             + sum_3_scent_y[y][x]
-                                             + sum_3_scent_y[y][x + 1] )
-                    ) / ( 1000 * 10 );
-            } else {
-                // this cell blocks scent via NO_SCENT (in json)
-                scent_here = 0;
-            }
+    for( int x = min.x; x <= max.x; ++x ) {
+        const bool *blocks = blocks_scent[x].data();
+        const bool *reduces = reduces_scent[x].data();
+        const int *sum_3_left = sum_3_scent_y[x - 1].data();
+        const int *sum_3_here = sum_3_scent_y[x].data();
+        const int *sum_3_right = sum_3_scent_y[x + 1].data();
+        const int *used_left = squares_used_y[x - 1].data();
+        const int *used_here = squares_used_y[x].data();
+        const int *used_right = squares_used_y[x + 1].data();
+        int *scent = grscent[x].data();
+        for( int y = min.y; y <= max.y; ++y ) {
+            // squares blocking scent via NO_SCENT (in json) end up with no scent at all
+            const int open = 1 - blocks[y];
+            // to how many neighboring squares do we diffuse out? (include our own square
+            // since we also include our own square when diffusing in)
+            const int squares_used = used_left[y] + used_here[y] + used_right[y];
+            // less air movement for REDUCE_SCENT square
+            const int this_diffusivity = open * ( diffusivity - ( diffusivity - diffusivity / 5 ) *
+                                                  reduces[y] );
+            const int scent_here = scent[y];
+            // take the old scent and subtract what diffuses out
+            int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+            // neighboring REDUCE_SCENT squares absorb some scent
+            temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+            // we've already summed neighboring scent values in the y direction in the previous
+            // loop. Now we do it for the x direction, multiply by diffusion, and this is what
+            // diffuses into our current square.
+            scent[y] = open * ( ( temp_scent + this_diffusivity *
+                                  ( sum_3_left[y] + sum_3_here[y] + sum_3_right[y] ) ) / ( 1000 * 10 ) );
         }
     }
 }
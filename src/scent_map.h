@@ -41,10 +41,11 @@ class scent_type
 
 class scent_map
 {
-    protected:
+    public:
         template<typename T>
         using scent_array = std::array<std::array<T, MAPSIZE_Y>, MAPSIZE_X>;
 
+    protected:
         scent_array<int> grscent;
         scenttype_id typescent;
         cata::optional<tripoint> player_last_position;
@@ -61,6 +62,12 @@ class scent_map
         void draw( const catacurses::window &win, int div, const tripoint &center ) const;
 
         void update( const tripoint &center, map &m );
+        /**
+         * Diffuses scent for one turn inside the inclusive rectangle between min and max.
+         * Tiles up to one tile outside of it are read, but never written.
+         */
+        static void diffuse( scent_array<int> &grscent, const scent_array<bool> &blocks_scent,
+                             const scent_array<bool> &reduces_scent, const point &min, const point &max );
         void reset();
         void decay();
         void shift( const point &sm_shift );
@@ -26,6 +26,7 @@
 #include "line.h"
 #include "map.h"
 #include "map_iterator.h"
+#include "memory_fast.h"
 #include "messages.h"
 #include "monster.h"
 #include "npc.h"
@@ -292,13 +293,11 @@ void sounds::process_sounds()
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
+        // Exclude monsters that certainly won't hear the sound ( dist >= vol * 2 ).
+        for( const shared_ptr_fast<monster> &critter : g->monsters_within( source, vol * 2 - 1 ) ) {
             // TODO: Generalize this to Creature::hear_sound
-            const int dist = rl_dist( source, critter.pos() );
-            if( vol * 2 > dist ) {
-                // Exclude monsters that certainly won't hear the sound
-                critter.hear_sound( source, vol, dist );
-            }
+            const int dist = rl_dist( source, critter->pos() );
+            critter->hear_sound( source, vol, dist );
         }
     }
     recent_sounds.clear();
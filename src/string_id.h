@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_STRING_ID_H
 #define CATA_SRC_STRING_ID_H
 
+#include <atomic>
 #include <string>
 #include <type_traits>
 
@@ -63,6 +64,20 @@ class string_id
          * to be special. Every string (including the empty one) may be a valid id.
          */
         string_id() : _cid( -1 ) {}
+        string_id( const This &other ) : _id( other._id ), _cid( other._cid.load(
+                        std::memory_order_relaxed ) ) {}
+        string_id( This &&other ) noexcept : _id( std::move( other._id ) ),
+            _cid( other._cid.load( std::memory_order_relaxed ) ) {}
+        This &operator=( const This &other ) {
+            _id = other._id;
+            _cid.store( other._cid.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+            return *this;
+        }
+        This &operator=( This &&other ) noexcept {
+            _id = std::move( other._id );
+            _cid.store( other._cid.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+            return *this;
+        }
         /**
          * Comparison, only useful when the id is used in std::map or std::set as key. Compares
          * the string id as with the strings comparison.
@@ -183,18 +198,20 @@ class string_id
          * Assigns a new value for the cached int id.
          */
         void set_cid( const int_id<T> &cid ) const {
-            _cid = cid.to_i();
+            _cid.store( cid.to_i(), std::memory_order_relaxed );
         }
         /**
          * Returns the current value of cached id
          */
         int_id<T> get_cid() const {
-            return int_id<T>( _cid );
+            return int_id<T>( _cid.load( std::memory_order_relaxed ) );
         }
 
     private:
         std::string _id;
-        mutable int _cid;
+        // Shared ids (e.g. static ones) are resolved from background threads as well, the
+        // cached value is the same for every thread, it only must not be a data race.
+        mutable std::atomic<int> _cid;
 };
 
 // Support hashing of string based ids by forwarding the hash of the string.
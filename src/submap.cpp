@@ -4,10 +4,14 @@
 #include <array>
 #include <iterator>
 #include <memory>
+#include <sstream>
 #include <utility>
+#include <vector>
 
 #include "basecamp.h"
+#include "binary_io.h"
 #include "int_id.h"
+#include "json.h"
 #include "mapdata.h"
 #include "tileray.h"
 #include "trap.h"
@@ -23,6 +27,9 @@ void maptile_soa<sx, sy>::swap_soa_tile( const point &p1, const point &p2 )
     std::swap( fld[p1.x][p1.y], fld[p2.x][p2.y] );
     std::swap( trp[p1.x][p1.y], trp[p2.x][p2.y] );
     std::swap( rad[p1.x][p1.y], rad[p2.x][p2.y] );
+    const bool fld_tile1 = fld_tiles.test( fld_index( p1 ) );
+    fld_tiles.set( fld_index( p1 ), fld_tiles.test( fld_index( p2 ) ) );
+    fld_tiles.set( fld_index( p2 ), fld_tile1 );
 }
 
 template<int sx, int sy>
@@ -35,6 +42,9 @@ void maptile_soa<sx, sy>::swap_soa_tile( const point &p, maptile_soa<1, 1> &othe
     std::swap( fld[p.x][p.y], **other.fld );
     std::swap( trp[p.x][p.y], **other.trp );
     std::swap( rad[p.x][p.y], **other.rad );
+    const bool fld_tile = fld_tiles.test( fld_index( p ) );
+    fld_tiles.set( fld_index( p ), other.fld_tiles.test( 0 ) );
+    other.fld_tiles.set( 0, fld_tile );
 }
 
 submap::submap()
@@ -298,3 +308,147 @@ void submap::rotate( int turns )
     }
     computers = rot_comp;
 }
+
+template<typename IdType>
+static void store_palette_grid( binary_out &out, const IdType( &grid )[SEEX][SEEY] )
+{
+    // Palettes are tiny (usually a handful of entries), a linear search is fine.
+    std::vector<IdType> palette;
+    std::vector<size_t> indices;
+    indices.reserve( SEEX * SEEY );
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            const auto iter = std::find( palette.begin(), palette.end(), grid[i][j] );
+            indices.push_back( iter - palette.begin() );
+            if( iter == palette.end() ) {
+                palette.push_back( grid[i][j] );
+            }
+        }
+    }
+    out.write_uint( palette.size() );
+    for( const IdType &id : palette ) {
+        out.write_string( id.id().str() );
+    }
+    for( const size_t index : indices ) {
+        out.write_uint( index );
+    }
+}
+
+template<typename StrIdType, typename IdType>
+static void load_palette_grid( binary_in &in, IdType( &grid )[SEEX][SEEY] )
+{
+    std::vector<IdType> palette( in.read_index( SEEX * SEEY + 1 ) );
+    for( IdType &id : palette ) {
+        id = StrIdType( in.read_string() ).id();
+    }
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            grid[i][j] = palette[in.read_index( palette.size() )];
+        }
+    }
+}
+
+void submap::store( binary_out &out ) const
+{
+    out.write_int( to_turn<int>( last_touched ) );
+    out.write_int( temperature );
+
+    store_palette_grid( out, ter );
+    store_palette_grid( out, frn );
+    store_palette_grid( out, trp );
+
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            out.write_int( rad[i][j] );
+        }
+    }
+
+    std::ostringstream item_json;
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            if( itm[i][j].empty() ) {
+                continue;
+            }
+            out.write_uint( i + j * SEEX );
+            out.write_uint( itm[i][j].size() );
+            for( const item &it : itm[i][j] ) {
+                item_json.str( std::string() );
+                JsonOut jsout( item_json );
+                jsout.write( it );
+                out.write_string( item_json.str() );
+            }
+        }
+    }
+    out.write_uint( SEEX * SEEY );
+
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            if( fld[i][j].field_count() == 0 ) {
+                continue;
+            }
+            out.write_uint( i + j * SEEX );
+            out.write_uint( fld[i][j].field_count() );
+            for( const auto &elem : fld[i][j] ) {
+                const field_entry &cur = elem.second;
+                out.write_string( cur.get_field_type().id().str() );
+                out.write_int( cur.get_field_intensity() );
+                out.write_int( to_turns<int>( cur.get_field_age() ) );
+            }
+        }
+    }
+    out.write_uint( SEEX * SEEY );
+
+    std::ostringstream extras;
+    JsonOut jsout( extras );
+    jsout.start_object();
+    store_extras( jsout );
+    jsout.end_object();
+    out.write_string( extras.str() );
+}
+
+void submap::load( binary_in &in, const int version )
+{
+    last_touched = time_point::from_turn( static_cast<int>( in.read_int() ) );
+    temperature = static_cast<int>( in.read_int() );
+
+    load_palette_grid<ter_str_id>( in, ter );
+    load_palette_grid<furn_str_id>( in, frn );
+    load_palette_grid<trap_str_id>( in, trp );
+
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            rad[i][j] = static_cast<int>( in.read_int() );
+        }
+    }
+
+    // Tile lists are terminated by an out of range tile index.
+    for( size_t tile = in.read_index( SEEX * SEEY + 1 ); tile < SEEX * SEEY;
+         tile = in.read_index( SEEX * SEEY + 1 ) ) {
+        const point p( tile % SEEX, tile / SEEX );
+        for( size_t count = in.read_uint(); count > 0; count-- ) {
+            std::istringstream item_json( in.read_string() );
+            JsonIn jsin( item_json );
+            item tmp;
+            jsin.read( tmp );
+            add_loaded_item( p, tmp, version );
+        }
+    }
+
+    for( size_t tile = in.read_index( SEEX * SEEY + 1 ); tile < SEEX * SEEY;
+         tile = in.read_index( SEEX * SEEY + 1 ) ) {
+        const point p( tile % SEEX, tile / SEEX );
+        for( size_t count = in.read_uint(); count > 0; count-- ) {
+            const field_type_id ft = field_type_str_id( in.read_string() ).id();
+            const int intensity = static_cast<int>( in.read_int() );
+            const int age = static_cast<int>( in.read_int() );
+            add_field( p, ft, intensity, time_duration::from_turns( age ) );
+        }
+    }
+
+    std::istringstream extras( in.read_string() );
+    JsonIn jsin( extras );
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        load( jsin, jsin.get_member_name(), version );
+    }
+}
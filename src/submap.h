@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_SUBMAP_H
 #define CATA_SRC_SUBMAP_H
 
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -24,6 +25,8 @@
 class JsonIn;
 class JsonOut;
 class basecamp;
+class binary_in;
+class binary_out;
 class map;
 struct trap;
 struct ter_t;
@@ -54,6 +57,11 @@ struct maptile_soa {
     field              fld[sx][sy];  // Field on each square
     trap_id            trp[sx][sy];  // Trap on each square
     int                rad[sx][sy];  // Irradiation of each square
+    std::bitset<sx *sy> fld_tiles;   // Squares that may have fields, see @ref fld_index
+
+    static constexpr size_t fld_index( const point &p ) {
+        return static_cast<size_t>( p.x * sy + p.y );
+    }
 
     void swap_soa_tile( const point &p1, const point &p2 );
     void swap_soa_tile( const point &p, maptile_soa<1, 1> &other );
@@ -173,6 +181,53 @@ class submap : maptile_soa<SEEX, SEEY>
             return fld[p.x][p.y];
         }
 
+        /**
+         * Adds a field entry to the square, see field::add_field.
+         * Use this (or maptile::add_field) instead of adding to @ref get_field directly,
+         * it keeps @ref field_count up to date and makes @ref for_each_field visit the square.
+         */
+        bool add_field( const point &p, const field_type_id &type, int intensity,
+                        const time_duration &age ) {
+            if( !fld[p.x][p.y].add_field( type, intensity, age ) ) {
+                return false;
+            }
+            field_count++;
+            fld_tiles.set( fld_index( p ) );
+            return true;
+        }
+
+        /**
+         * The first square at ( @p x, y ) with y >= @p y that has fields, or SEEY if there
+         * is none. Squares that lost all their fields since they got them are forgotten here.
+         * Looping with this also visits squares that get fields during the loop.
+         */
+        int next_field_tile( const int x, int y ) {
+            for( ; y < SEEY; y++ ) {
+                const size_t index = fld_index( point( x, y ) );
+                if( !fld_tiles.test( index ) ) {
+                    continue;
+                }
+                if( fld[x][y].field_count() > 0 ) {
+                    return y;
+                }
+                fld_tiles.reset( index );
+            }
+            return SEEY;
+        }
+
+        /**
+         * Calls @p func( const point &, field & ) for each square that has fields, ordered by
+         * x and then y, see @ref next_field_tile.
+         */
+        template<typename Func>
+        void for_each_field( Func func ) {
+            for( int x = 0; x < SEEX && fld_tiles.any(); x++ ) {
+                for( int y = next_field_tile( x, 0 ); y < SEEY; y = next_field_tile( x, y + 1 ) ) {
+                    func( point( x, y ), fld[x][y] );
+                }
+            }
+        }
+
         struct cosmetic_t {
             point pos;
             std::string type;
@@ -225,6 +280,14 @@ class submap : maptile_soa<SEEX, SEEY>
 
         void store( JsonOut &jsout ) const;
         void load( JsonIn &jsin, const std::string &member_name, int version );
+        /**
+         * Compact binary variant of @ref store / @ref load, used by the binary map quad format.
+         * Terrain, furniture and traps are written as palette indices, items and fields as
+         * length prefixed records. The remaining (rare) members are embedded as JSON.
+         * @throws binary_error (or JsonError) if the data is corrupted.
+         */
+        void store( binary_out &out ) const;
+        void load( binary_in &in, int version );
 
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
@@ -252,6 +315,10 @@ class submap : maptile_soa<SEEX, SEEY>
         int temperature = 0;
 
         void update_legacy_computer();
+        /** Members that have no compact binary representation, shared by both formats. */
+        void store_extras( JsonOut &jsout ) const;
+        /** Adds an item read from a save file, handling legacy versions and item caches. */
+        void add_loaded_item( const point &p, item &tmp, int version );
 
         static constexpr size_t elements = SEEX * SEEY;
 };
@@ -310,12 +377,7 @@ struct maptile {
 
         bool add_field( const field_type_id &field_to_add, const int new_intensity,
                         const time_duration &new_age ) {
-            const bool ret = sm->get_field( pos() ).add_field( field_to_add, new_intensity, new_age );
-            if( ret ) {
-                sm->field_count++;
-            }
-
-            return ret;
+            return sm->add_field( pos(), field_to_add, new_intensity, new_age );
         }
 
         int get_radiation() const {
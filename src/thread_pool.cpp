@@ -0,0 +1,130 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+
+// Set while the current thread is running a task, nested batches run serially.
+static thread_local bool running_pool_task = false;
+// Set by bypass_thread_pool, batches of the current thread run serially.
+static thread_local bool bypassing_pool = false;
+// Set by override_thread_pool, the background overmap generation reads it as well.
+static std::atomic<thread_pool *> overridden_pool( nullptr );
+
+thread_pool::thread_pool( const size_t num_workers )
+{
+    for( size_t i = 0; i < num_workers; i++ ) {
+        workers.emplace_back( &thread_pool::worker_loop, this );
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    work_added.notify_all();
+    for( std::thread &worker : workers ) {
+        worker.join();
+    }
+}
+
+void thread_pool::run( const size_t count, const std::function<void( size_t )> &task )
+{
+    if( count <= 1 || workers.empty() || running_pool_task || bypassing_pool ) {
+        for( size_t i = 0; i < count; i++ ) {
+            task( i );
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock( run_mutex );
+    std::unique_lock<std::mutex> lock( mutex );
+    current_task = &task;
+    num_tasks = count;
+    next_task = 0;
+    unfinished_tasks = count;
+    work_added.notify_all();
+
+    run_tasks( lock );
+    work_done.wait( lock, [this]() {
+        return unfinished_tasks == 0;
+    } );
+    current_task = nullptr;
+    std::exception_ptr error;
+    std::swap( error, first_error );
+    lock.unlock();
+
+    if( error ) {
+        std::rethrow_exception( error );
+    }
+}
+
+void thread_pool::run_tasks( std::unique_lock<std::mutex> &lock )
+{
+    while( current_task != nullptr && next_task < num_tasks ) {
+        const std::function<void( size_t )> &task = *current_task;
+        const size_t index = next_task++;
+        lock.unlock();
+
+        std::exception_ptr error;
+        running_pool_task = true;
+        try {
+            task( index );
+        } catch( ... ) {
+            error = std::current_exception();
+        }
+        running_pool_task = false;
+
+        lock.lock();
+        if( error && !first_error ) {
+            first_error = error;
+        }
+        if( --unfinished_tasks == 0 ) {
+            work_done.notify_all();
+        }
+    }
+}
+
+void thread_pool::worker_loop()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        work_added.wait( lock, [this]() {
+            return stopping || ( current_task != nullptr && next_task < num_tasks );
+        } );
+        if( stopping ) {
+            return;
+        }
+        run_tasks( lock );
+    }
+}
+
+thread_pool &get_thread_pool()
+{
+    if( thread_pool *const pool = overridden_pool.load() ) {
+        return *pool;
+    }
+    static thread_pool pool( std::max( std::thread::hardware_concurrency(), 1U ) - 1 );
+    return pool;
+}
+
+override_thread_pool::override_thread_pool( thread_pool &pool ) : previous( overridden_pool )
+{
+    overridden_pool = &pool;
+}
+
+override_thread_pool::~override_thread_pool()
+{
+    overridden_pool = previous;
+}
+
+bypass_thread_pool::bypass_thread_pool() : previous( bypassing_pool )
+{
+    bypassing_pool = true;
+}
+
+bypass_thread_pool::~bypass_thread_pool()
+{
+    bypassing_pool = previous;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#ifndef CATA_SRC_THREAD_POOL_H
+#define CATA_SRC_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32) && !defined(_MSC_VER)
+#   include "mingw.thread.h"
+#endif
+
+/**
+ * A small pool of persistent worker threads for splitting a computation into independent
+ * tasks, e.g. the octants of shadowcasting.
+ *
+ * The tasks must not touch shared game state that isn't safe to access concurrently
+ * (that's almost everything, including debugmsg and lazily initialized caches), each task
+ * should only write its own output.
+ */
+class thread_pool
+{
+    public:
+        /** Starts @p num_workers threads, the calling thread of @ref run works as well. */
+        explicit thread_pool( size_t num_workers );
+        ~thread_pool();
+
+        thread_pool( const thread_pool & ) = delete;
+        thread_pool &operator=( const thread_pool & ) = delete;
+
+        /** Number of tasks that can run at the same time (the workers plus the caller). */
+        size_t concurrency() const {
+            return workers.size() + 1;
+        }
+
+        /**
+         * Calls @p task for each index in [0, @p num_tasks) and returns once all calls
+         * have returned. The order and the thread of the calls is unspecified.
+         * If a task throws, the first exception is rethrown here after all tasks are done.
+         * Nested calls (from inside a task) run the tasks on the calling thread, as do calls
+         * while a @ref bypass_thread_pool exists on the calling thread.
+         */
+        void run( size_t num_tasks, const std::function<void( size_t )> &task );
+
+    private:
+        void worker_loop();
+        /** Runs tasks of the current batch until none are left. */
+        void run_tasks( std::unique_lock<std::mutex> &lock );
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable work_added;
+        std::condition_variable work_done;
+        // Serializes concurrent callers of run.
+        std::mutex run_mutex;
+
+        // The current batch, guarded by mutex.
+        const std::function<void( size_t )> *current_task = nullptr;
+        size_t num_tasks = 0;
+        size_t next_task = 0;
+        size_t unfinished_tasks = 0;
+        std::exception_ptr first_error;
+        bool stopping = false;
+};
+
+/**
+ * The pool shared by the game, with one worker less than the hardware has threads,
+ * unless an @ref override_thread_pool is active.
+ */
+thread_pool &get_thread_pool();
+
+/**
+ * Makes @ref get_thread_pool return another pool while this object exists, so tests can
+ * run the parallel code paths with several workers even on a single core machine.
+ * Only to be used from the main thread.
+ */
+class override_thread_pool
+{
+    public:
+        explicit override_thread_pool( thread_pool &pool );
+        ~override_thread_pool();
+
+        override_thread_pool( const override_thread_pool & ) = delete;
+        override_thread_pool &operator=( const override_thread_pool & ) = delete;
+
+    private:
+        thread_pool *previous;
+};
+
+/**
+ * While it exists, @ref thread_pool::run calls on the current thread run their tasks right
+ * there instead of using the pool. For background threads: a pool runs one batch at a time,
+ * so their batches would hold up the ones of the main thread.
+ */
+class bypass_thread_pool
+{
+    public:
+        bypass_thread_pool();
+        ~bypass_thread_pool();
+
+        bypass_thread_pool( const bypass_thread_pool & ) = delete;
+        bypass_thread_pool &operator=( const bypass_thread_pool & ) = delete;
+
+    private:
+        bool previous;
+};
+
+#endif // CATA_SRC_THREAD_POOL_H
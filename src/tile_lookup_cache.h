@@ -0,0 +1,92 @@
+#pragma once
+#ifndef CATA_SRC_TILE_LOOKUP_CACHE_H
+#define CATA_SRC_TILE_LOOKUP_CACHE_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "calendar.h"
+#include "int_id.h"
+#include "string_id.h"
+
+/**
+ * Remembers what looking up the tile of an id in a tileset found, per tile category,
+ * until the tileset (see @ref clear) or the season (see @ref set_season) changes.
+ *
+ * @p Lookup is the result of a lookup, @p Category the enum of the tile categories.
+ * Ids that have an int_id are found by that instead of hashing their string.
+ * References to cached lookups stay valid until the cache is cleared.
+ */
+template<typename Lookup, typename Category>
+class tile_lookup_cache
+{
+    public:
+        /** Forgets all lookups, e.g. after the tileset has been reloaded. */
+        void clear() {
+            by_name.clear();
+            by_int_id.clear();
+        }
+
+        /** Forgets all lookups if they were done in another season (seasonal tiles). */
+        void set_season( const season_type new_season ) {
+            if( new_season != season ) {
+                clear();
+                season = new_season;
+            }
+        }
+
+        /**
+         * Returns the cached lookup of @p id, the first time it is filled with
+         * @p create( id ), which must return a Lookup.
+         */
+        template<typename Create>
+        const Lookup &find( const std::string &id, const Category category, Create &&create ) {
+            std::unordered_map<std::string, Lookup> &lookups = by_name[category];
+            const auto iter = lookups.find( id );
+            if( iter != lookups.end() ) {
+                return iter->second;
+            }
+            return lookups.emplace( id, create( id ) ).first->second;
+        }
+
+        /** Same as above, for an id that has an int_id. */
+        template<typename T, typename Create>
+        const Lookup &find( const int_id<T> &id, const Category category, Create &&create ) {
+            const size_t category_index = static_cast<size_t>( category );
+            if( category_index >= by_int_id.size() ) {
+                by_int_id.resize( category_index + 1 );
+            }
+            std::vector<const Lookup *> &lookups = by_int_id[category_index];
+            const size_t index = id.to_i();
+            if( index >= lookups.size() ) {
+                lookups.resize( index + 1, nullptr );
+            }
+            const Lookup *&found = lookups[index];
+            if( !found ) {
+                // The entries of by_name don't move, so the pointer stays valid.
+                found = &find( id.id().str(), category, std::forward<Create>( create ) );
+            }
+            return *found;
+        }
+
+        /** Number of ids that have been looked up, for testing. */
+        size_t size() const {
+            size_t result = 0;
+            for( const auto &lookups : by_name ) {
+                result += lookups.second.size();
+            }
+            return result;
+        }
+
+    private:
+        std::map<Category, std::unordered_map<std::string, Lookup>> by_name;
+        // Pointers into by_name, indexed by category and the int_id.
+        std::vector<std::vector<const Lookup *>> by_int_id;
+        season_type season = NUM_SEASONS;
+};
+
+#endif // CATA_SRC_TILE_LOOKUP_CACHE_H
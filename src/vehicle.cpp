@@ -4817,68 +4817,76 @@ vehicle *vehicle::find_vehicle( const tripoint &where )
 void vehicle::enumerate_vehicles( std::map<vehicle *, bool> &connected_vehicles,
                                   std::set<vehicle *> &vehicle_list )
 {
-    auto enumerate_visitor = [&connected_vehicles]( vehicle * veh, int amount, int ) {
-        // Only emplaces if element is not present already.
-        connected_vehicles.emplace( veh, false );
-        return amount;
-    };
     for( vehicle *veh : vehicle_list ) {
         // This autovivifies, and also overwrites the value if already present.
         connected_vehicles[veh] = true;
-        traverse_vehicle_graph( veh, 1, enumerate_visitor );
+        for( const std::pair<vehicle *, int> &visit : veh->get_power_grid() ) {
+            // Only emplaces if element is not present already.
+            connected_vehicles.emplace( visit.first, false );
+        }
     }
 }
 
-template <typename Func, typename Vehicle>
-int vehicle::traverse_vehicle_graph( Vehicle *start_veh, int amount, Func action )
-{
-    // Breadth-first search! Initialize the queue with a pointer to ourselves and go!
-    std::queue< std::pair<Vehicle *, int> > connected_vehs;
-    std::set<Vehicle *> visited_vehs;
-    connected_vehs.push( std::make_pair( start_veh, 0 ) );
+uint64_t vehicle_power_grid::current_generation = 1;
 
-    while( amount > 0 && !connected_vehs.empty() ) {
-        auto current_node = connected_vehs.front();
-        Vehicle *current_veh = current_node.first;
-        int current_loss = current_node.second;
+const std::vector<std::pair<vehicle *, int>> &vehicle::get_power_grid() const
+{
+    if( power_grid.generation == vehicle_power_grid::current_generation ) {
+        return power_grid.visits;
+    }
+    power_grid.visits.clear();
+    power_grid.generation = vehicle_power_grid::current_generation;
+    if( power_cables.empty() ) {
+        return power_grid.visits;
+    }
 
+    // Breadth-first search! Initialize the queue with a pointer to ourselves and go!
+    // A vehicle counts as visited once its cables have been followed, so one that is
+    // reached on several paths before that is visited on each of them.
+    std::queue< std::pair<const vehicle *, int> > connected_vehs;
+    std::set<const vehicle *> visited_vehs;
+    connected_vehs.push( std::make_pair( this, 0 ) );
+
+    while( !connected_vehs.empty() ) {
+        const vehicle *current_veh = connected_vehs.front().first;
+        const int current_loss = connected_vehs.front().second;
         visited_vehs.insert( current_veh );
         connected_vehs.pop();
 
-        g->u.add_msg_if_player( m_debug, "Traversing graph with %d power", amount );
-
-        for( auto &p : current_veh->loose_parts ) {
-            if( !current_veh->part_info( p ).has_flag( "POWER_TRANSFER" ) ) {
-                continue; // ignore loose parts that aren't power transfer cables
-            }
-
-            auto target_veh = vehicle::find_vehicle( current_veh->parts[p].target.second );
+        for( const int p : current_veh->power_cables ) {
+            vehicle *target_veh = vehicle::find_vehicle( current_veh->parts[p].target.second );
             if( target_veh == nullptr || visited_vehs.count( target_veh ) > 0 ) {
                 // Either no destination here (that vehicle's rolled away or off-map) or
                 // we've already looked at that vehicle.
                 continue;
             }
+            const int target_loss = current_loss + current_veh->part_info( p ).epower;
+            connected_vehs.push( std::make_pair( target_veh, target_loss ) );
+            power_grid.visits.emplace_back( target_veh, target_loss );
+        }
+    }
+    return power_grid.visits;
+}
 
-            // Add this connected vehicle to the queue of vehicles to search next,
-            // but only if we haven't seen this one before.
-            if( visited_vehs.count( target_veh ) < 1 ) {
-                int target_loss = current_loss + current_veh->part_info( p ).epower;
-                connected_vehs.push( std::make_pair( target_veh, target_loss ) );
-
-                float loss_amount = ( static_cast<float>( amount ) * static_cast<float>( target_loss ) ) / 100;
-                g->u.add_msg_if_player( m_debug, "Visiting remote %p with %d power (loss %f, which is %d percent)",
-                                        static_cast<void *>( target_veh ), amount, loss_amount, target_loss );
+template <typename Func, typename Vehicle>
+int vehicle::traverse_vehicle_graph( Vehicle *start_veh, int amount, Func action )
+{
+    for( const std::pair<vehicle *, int> &visit : start_veh->get_power_grid() ) {
+        if( amount < 1 ) {
+            break; // No more charge to donate away.
+        }
+        vehicle *target_veh = visit.first;
+        const int target_loss = visit.second;
 
-                amount = action( target_veh, amount, static_cast<int>( loss_amount ) );
-                g->u.add_msg_if_player( m_debug, "After remote %p, %d power", static_cast<void *>( target_veh ),
-                                        amount );
+        float loss_amount = ( static_cast<float>( amount ) * static_cast<float>( target_loss ) ) / 100;
+        g->u.add_msg_if_player( m_debug, "Visiting remote %p with %d power (loss %f, which is %d percent)",
+                                static_cast<void *>( target_veh ), amount, loss_amount, target_loss );
 
-                if( amount < 1 ) {
-                    break; // No more charge to donate away.
-                }
-            }
-        }
+        amount = action( target_veh, amount, static_cast<int>( loss_amount ) );
+        g->u.add_msg_if_player( m_debug, "After remote %p, %d power", static_cast<void *>( target_veh ),
+                                amount );
     }
+
     return amount;
 }
 
@@ -5324,13 +5332,9 @@ void vehicle::gain_moves()
         thrust( ( cruise_velocity ) > velocity ? 1 : -1 );
     }
 
-    // Force off-map vehicles to load by visiting them every time we gain moves.
-    // Shouldn't be too expensive if there aren't fifty trillion vehicles in the graph...
-    // ...and if there are, it's the player's fault for putting them there.
-    auto nil_visitor = []( vehicle *, int amount, int ) {
-        return amount;
-    };
-    traverse_vehicle_graph( this, 1, nil_visitor );
+    // Force off-map vehicles to load by looking them up whenever the connections might
+    // have changed, otherwise this just returns the cached grid.
+    get_power_grid();
 
     if( check_environmental_effects ) {
         check_environmental_effects = do_environmental_effects();
@@ -5415,6 +5419,7 @@ void vehicle::refresh()
     if( no_refresh ) {
         return;
     }
+    vehicle_power_grid::invalidate_all();
 
     alternators.clear();
     engines.clear();
@@ -5427,6 +5432,7 @@ void vehicle::refresh()
     emitters.clear();
     relative_parts.clear();
     loose_parts.clear();
+    power_cables.clear();
     wheelcache.clear();
     rail_wheelcache.clear();
     rotors.clear();
@@ -5516,6 +5522,9 @@ void vehicle::refresh()
         }
         if( vpi.has_flag( "UNMOUNT_ON_MOVE" ) ) {
             loose_parts.push_back( p );
+            if( vpi.has_flag( "POWER_TRANSFER" ) ) {
+                power_cables.push_back( p );
+            }
         }
         if( vpi.has_flag( "EMITTER" ) ) {
             emitters.push_back( p );
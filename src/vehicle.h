@@ -5,6 +5,7 @@
 #include <array>
 #include <climits>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <set>
@@ -574,6 +575,41 @@ struct label : public point {
 
 class RemovePartHandler;
 
+/**
+ * The vehicles a vehicle is connected to by power cables, as found by
+ * vehicle::get_power_grid. All of these are invalidated together whenever a vehicle is
+ * created, destroyed, moved or refreshed, as that may change any connection. Copies of
+ * a vehicle start with an invalid grid.
+ */
+struct vehicle_power_grid {
+    /**
+     * The connected vehicles in the order the breadth-first search visits them, with the
+     * power loss (in percent) on the way there. A vehicle may appear more than once.
+     */
+    std::vector<std::pair<vehicle *, int>> visits;
+    /** Value of @ref current_generation when @ref visits was found, 0 if never. */
+    uint64_t generation = 0;
+
+    static uint64_t current_generation;
+    static void invalidate_all() {
+        ++current_generation;
+    }
+
+    vehicle_power_grid() {
+        invalidate_all();
+    }
+    vehicle_power_grid( const vehicle_power_grid & ) : vehicle_power_grid() {}
+    vehicle_power_grid &operator=( const vehicle_power_grid & ) {
+        visits.clear();
+        generation = 0;
+        invalidate_all();
+        return *this;
+    }
+    ~vehicle_power_grid() {
+        invalidate_all();
+    }
+};
+
 /**
  * A vehicle as a whole with all its components.
  *
@@ -732,6 +768,11 @@ class vehicle
          */
         template <typename Func, typename Vehicle>
         static int traverse_vehicle_graph( Vehicle *start_veh, int amount, Func action );
+        /**
+         * The vehicles traverse_vehicle_graph visits when starting from this one, found
+         * again only when the connections might have changed.
+         */
+        const std::vector<std::pair<vehicle *, int>> &get_power_grid() const;
     public:
         vehicle( const vproto_id &type_id, int init_veh_fuel = -1, int init_veh_status = -1 );
         vehicle();
@@ -1736,6 +1777,7 @@ class vehicle
         std::vector<int> funnels;          // List of funnel indices
         std::vector<int> emitters;         // List of emitter parts
         std::vector<int> loose_parts;      // List of UNMOUNT_ON_MOVE parts
+        std::vector<int> power_cables;     // List of UNMOUNT_ON_MOVE parts that are POWER_TRANSFER
         std::vector<int> wheelcache;       // List of wheels
         std::vector<int> rotors;           // List of rotors
         std::vector<int> rail_wheelcache;  // List of rail wheels
@@ -1767,6 +1809,7 @@ class vehicle
         cata::optional<time_duration> summon_time_limit = cata::nullopt;
 
     private:
+        mutable vehicle_power_grid power_grid;
         mutable units::mass mass_cache;
         // cached pivot point
         mutable point pivot_cache;
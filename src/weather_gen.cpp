@@ -8,6 +8,7 @@
 #include <string>
 
 #include "cata_utility.h"
+#include "coordinate_conversions.h"
 #include "game_constants.h"
 #include "json.h"
 #include "math_defines.h"
@@ -101,6 +102,35 @@ double weather_generator::get_weather_temperature( const tripoint &location, con
 {
     return weather_temperature_from_common_data( *this, get_common_data( location, t, seed ), t );
 }
+
+double weather_generator::get_hourly_weather_temperature( const tripoint &location,
+        const time_point &t, unsigned seed ) const
+{
+    // Plenty for the areas of a few reality bubbles over a couple of months.
+    static constexpr size_t max_samples = 1 << 16;
+    if( seed != hourly_temperatures_seed || hourly_temperatures.size() > max_samples ) {
+        hourly_temperatures.clear();
+        hourly_temperatures_seed = seed;
+    }
+    const point area = ms_to_sm_copy( location.xy() );
+    const time_duration since_zero = t - calendar::turn_zero;
+    const int hour = to_hours<int>( since_zero );
+    const auto sample = [&]( const int h ) {
+        const tripoint key( area, h );
+        const auto iter = hourly_temperatures.find( key );
+        if( iter != hourly_temperatures.end() ) {
+            return iter->second;
+        }
+        const tripoint sample_location( area.x * SEEX, area.y * SEEY, 0 );
+        const double temperature = get_weather_temperature( sample_location,
+                                   calendar::turn_zero + time_duration::from_hours( h ), seed );
+        hourly_temperatures.emplace( key, temperature );
+        return temperature;
+    };
+    const double fraction = ( since_zero - time_duration::from_hours( hour ) ) / 1_hours;
+    return sample( hour ) * ( 1.0 - fraction ) + sample( hour + 1 ) * fraction;
+}
+
 w_point weather_generator::get_weather( const tripoint &location, const time_point &t,
                                         unsigned seed ) const
 {
@@ -3,10 +3,11 @@
 #define CATA_SRC_WEATHER_GEN_H
 
 #include <string>
+#include <unordered_map>
 
 #include "calendar.h"
+#include "point.h"
 
-struct tripoint;
 class JsonObject;
 
 enum weather_type : int;
@@ -63,8 +64,20 @@ class weather_generator
         void test_weather( unsigned ) const;
 
         double get_weather_temperature( const tripoint &, const time_point &, unsigned ) const;
+        /**
+         * Like @ref get_weather_temperature, but interpolated between hourly samples that are
+         * taken once per submap sized area and cached. Meant for catching up on long stretches
+         * of time (e.g. items that were out of the reality bubble), where the exact value
+         * doesn't matter but the same samples are needed over and over.
+         */
+        double get_hourly_weather_temperature( const tripoint &, const time_point &, unsigned ) const;
 
         static weather_generator load( const JsonObject &jo );
+
+    private:
+        // Samples of get_weather_temperature, indexed by area (x, y) and hour (z).
+        mutable std::unordered_map<tripoint, double> hourly_temperatures;
+        mutable unsigned hourly_temperatures_seed = 0;
 };
 
 #endif // CATA_SRC_WEATHER_GEN_H
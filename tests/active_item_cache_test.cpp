@@ -1,6 +1,9 @@
+#include <list>
 #include <memory>
 #include <set>
+#include <vector>
 
+#include "active_item_cache.h"
 #include "calendar.h"
 #include "catch/catch.hpp"
 #include "game.h"
@@ -46,3 +49,70 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+static int count_processed( const std::vector<item_reference> &refs, const item &it )
+{
+    int count = 0;
+    for( const item_reference &ref : refs ) {
+        if( ref.item_ref.get() == &it ) {
+            count++;
+        }
+    }
+    return count;
+}
+
+TEST_CASE( "active_items_are_processed_at_their_speed", "[item]" )
+{
+    const time_point start_turn = calendar::turn;
+    std::list<item> items;
+    item &fast = *items.emplace( items.end(), "firecracker_act", 0, item::default_charges_tag() );
+    fast.activate();
+    item &slow = *items.emplace( items.end(), "meat_cooked" );
+    item &removed = *items.emplace( items.end(), "meat_cooked" );
+    REQUIRE( fast.processing_speed() == 1 );
+    REQUIRE( slow.processing_speed() == to_turns<int>( 10_minutes ) );
+
+    active_item_cache cache;
+    CHECK( cache.empty() );
+    cache.add( fast, point_zero );
+    cache.add( slow, point_east );
+    cache.add( removed, point_south );
+    // Adding again doesn't add a second reference.
+    cache.add( fast, point_zero );
+    CHECK( cache.get().size() == 3 );
+    cache.remove( &removed );
+    CHECK( cache.get().size() == 2 );
+
+    int fast_count = 0;
+    std::vector<int> slow_turns;
+    for( int i = 0; i < 3000; i++ ) {
+        const std::vector<item_reference> processed = cache.get_for_processing();
+        fast_count += count_processed( processed, fast );
+        if( count_processed( processed, slow ) != 0 ) {
+            slow_turns.push_back( i );
+        }
+        CHECK( count_processed( processed, removed ) == 0 );
+        calendar::turn += 1_turns;
+    }
+    CHECK( fast_count == 3000 );
+    // Slow items pass through the second level of the wheel and still come up on time.
+    REQUIRE( slow_turns.size() == 5 );
+    for( size_t i = 1; i < slow_turns.size(); i++ ) {
+        CHECK( slow_turns[i] - slow_turns[i - 1] == slow.processing_speed() );
+    }
+
+    // Skipped turns are caught up on, but each item is only returned once.
+    calendar::turn += 250_turns;
+    const std::vector<item_reference> processed = cache.get_for_processing();
+    CHECK( count_processed( processed, fast ) == 1 );
+    CHECK( count_processed( processed, slow ) == 1 );
+
+    // Destroyed items are dropped from the cache.
+    items.clear();
+    calendar::turn += 1_turns;
+    CHECK( cache.get_for_processing().empty() );
+    CHECK( cache.get().empty() );
+    CHECK( cache.empty() );
+
+    calendar::turn = start_turn;
+}
@@ -0,0 +1,74 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "background_save.h"
+#include "cata_utility.h"
+#include "catch/catch.hpp"
+#include "filesystem.h"
+#include "path_info.h"
+
+static std::string read_contents( const std::string &path )
+{
+    std::string result;
+    read_from_file( path, [&]( std::istream & fin ) {
+        std::ostringstream buffer;
+        buffer << fin.rdbuf();
+        result = buffer.str();
+    } );
+    return result;
+}
+
+TEST_CASE( "deferred_writes_are_visible_to_readers", "[background_save]" )
+{
+    const std::string path = PATH_INFO::savedir() + "background_save_test.txt";
+    remove_file( path );
+    background_save::take_errors();
+
+    {
+        background_save::deferred_writes deferred;
+        CHECK( background_save::is_deferring() );
+        write_to_file( path, []( std::ostream & fout ) {
+            fout << "first";
+        } );
+        write_to_file( path, []( std::ostream & fout ) {
+            fout << "second";
+        } );
+    }
+    CHECK_FALSE( background_save::is_deferring() );
+    // Reading waits for the pending writes, the latest one wins.
+    CHECK( read_contents( path ) == "second" );
+
+    // A synchronous write must not be overwritten by an older background write.
+    {
+        background_save::deferred_writes deferred;
+        write_to_file( path, []( std::ostream & fout ) {
+            fout << "background";
+        } );
+    }
+    write_to_file( path, []( std::ostream & fout ) {
+        fout << "synchronous";
+    } );
+    background_save::wait_for_all();
+    CHECK_FALSE( background_save::busy() );
+    CHECK( read_contents( path ) == "synchronous" );
+    CHECK( background_save::take_errors().empty() );
+
+    remove_file( path );
+}
+
+TEST_CASE( "failed_background_writes_are_reported", "[background_save]" )
+{
+    const std::string path = PATH_INFO::savedir() + "no_such_directory/background_save_test.txt";
+    background_save::take_errors();
+    {
+        background_save::deferred_writes deferred;
+        write_to_file( path, []( std::ostream & fout ) {
+            fout << "lost";
+        } );
+    }
+    background_save::wait_for_all();
+    CHECK( background_save::take_errors().size() == 1 );
+    CHECK( background_save::take_errors().empty() );
+    CHECK_FALSE( file_exist( path ) );
+}
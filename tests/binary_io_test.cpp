@@ -0,0 +1,72 @@
+#include <cstdint>
+#include <string>
+
+#include "binary_io.h"
+#include "catch/catch.hpp"
+#include "rng.h"
+
+TEST_CASE( "binary_streams_round_trip", "[binary_io]" )
+{
+    binary_out out;
+    out.write_uint( 0 );
+    out.write_uint( 127 );
+    out.write_uint( 128 );
+    out.write_uint( UINT64_MAX );
+    out.write_int( -1 );
+    out.write_int( INT64_MIN );
+    out.write_int( INT64_MAX );
+    out.write_string( "" );
+    out.write_string( std::string( 300, 'x' ) );
+
+    binary_in in( out.data() );
+    CHECK( in.read_uint() == 0 );
+    CHECK( in.read_uint() == 127 );
+    CHECK( in.read_uint() == 128 );
+    CHECK( in.read_uint() == UINT64_MAX );
+    CHECK( in.read_int() == -1 );
+    CHECK( in.read_int() == INT64_MIN );
+    CHECK( in.read_int() == INT64_MAX );
+    CHECK( in.read_string().empty() );
+    CHECK( in.read_string() == std::string( 300, 'x' ) );
+    CHECK( in.eof() );
+    CHECK_THROWS_AS( in.read_uint(), binary_error );
+}
+
+TEST_CASE( "lz_compression_round_trip", "[binary_io]" )
+{
+    std::string repetitive;
+    for( int i = 0; i < 2000; i++ ) {
+        repetitive += "t_floor t_floor t_wall ";
+        repetitive += std::to_string( i % 7 );
+    }
+    std::string noise;
+    for( int i = 0; i < 5000; i++ ) {
+        noise.push_back( static_cast<char>( rng( 0, 255 ) ) );
+    }
+
+    for( const std::string &input : {
+             std::string(), std::string( "abc" ), std::string( 1000, '\0' ), repetitive, noise,
+             repetitive + noise + repetitive
+         } ) {
+        const std::string compressed = lz_compress( input );
+        CHECK( lz_decompress( compressed, input.size() ) == input );
+    }
+
+    CHECK( lz_compress( repetitive ).size() < repetitive.size() / 10 );
+}
+
+TEST_CASE( "lz_decompression_rejects_corrupt_data", "[binary_io]" )
+{
+    const std::string input( 100, 'a' );
+    const std::string compressed = lz_compress( input );
+    CHECK_THROWS_AS( lz_decompress( compressed, input.size() + 1 ), binary_error );
+    CHECK_THROWS_AS( lz_decompress( compressed.substr( 0, 2 ), input.size() ), binary_error );
+
+    binary_out bad_reference;
+    bad_reference.write_uint( 1 );
+    bad_reference.write_bytes( "a", 1 );
+    bad_reference.write_uint( 0 );
+    // Points before the start of the output
+    bad_reference.write_uint( 2 );
+    CHECK_THROWS_AS( lz_decompress( bad_reference.data(), 10 ), binary_error );
+}
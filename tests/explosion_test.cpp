@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <queue>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "cata_utility.h"
+#include "explosion.h"
+#include "game.h"
+#include "game_constants.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "math_defines.h"
+#include "point.h"
+#include "rng.h"
+
+// How explosion_handler::blast_propagation spread the blast before it used a bounded grid.
+static std::vector<std::pair<tripoint, float>> flood_fill_blast( const tripoint &p,
+        const float power, const float distance_factor, const bool fire )
+{
+    const float tile_dist = 1.0f;
+    const float diag_dist = trigdist ? M_SQRT2 * tile_dist : 1.0f * tile_dist;
+    const float zlev_dist = 2.0f;
+    static const int x_offset[10] = { -1, 1,  0, 0,  1, -1, -1, 1, 0, 0 };
+    static const int y_offset[10] = { 0, 0, -1, 1, -1,  1, -1, 1, 0, 0 };
+    static const int z_offset[10] = { 0, 0,  0, 0,  0,  0,  0, 0, 1, -1 };
+    const size_t max_index = g->m.has_zlevels() ? 10 : 8;
+
+    std::priority_queue< std::pair<float, tripoint>, std::vector< std::pair<float, tripoint> >, pair_greater_cmp_first >
+    open;
+    std::set<tripoint> closed;
+    std::map<tripoint, float> dist_map;
+    open.push( std::make_pair( 0.0f, p ) );
+    dist_map[p] = 0.0f;
+    while( !open.empty() ) {
+        const float distance = open.top().first * rng_float( 1.0f, 1.2f );
+        const tripoint pt = open.top().second;
+        open.pop();
+
+        if( closed.count( pt ) != 0 ) {
+            continue;
+        }
+
+        closed.insert( pt );
+
+        const float force = power * std::pow( distance_factor, distance );
+        if( force <= 1.0f ) {
+            continue;
+        }
+
+        if( g->m.impassable( pt ) && pt != p ) {
+            continue;
+        }
+
+        int empty_neighbors = 0;
+        for( size_t i = 0; i < 8; i++ ) {
+            tripoint dest( pt + tripoint( x_offset[i], y_offset[i], z_offset[i] ) );
+            if( closed.count( dest ) == 0 && g->m.valid_move( pt, dest, false, true ) ) {
+                empty_neighbors++;
+            }
+        }
+
+        empty_neighbors = std::max( 1, empty_neighbors );
+        for( size_t i = 0; i < max_index; i++ ) {
+            tripoint dest( pt + tripoint( x_offset[i], y_offset[i], z_offset[i] ) );
+            if( closed.count( dest ) != 0 || !g->m.inbounds( dest ) ) {
+                continue;
+            }
+
+            const float bash_force = !fire ?
+                                     force + ( 2 * force / empty_neighbors ) :
+                                     force / 2;
+            if( z_offset[i] == 0 ) {
+                g->m.bash( dest, bash_force, true, false, false );
+            } else if( z_offset[i] > 0 ) {
+                g->m.bash( dest, bash_force, true, false, true );
+            } else if( !g->m.valid_move( pt, dest, false, true ) ) {
+                g->m.bash( pt, bash_force, true, false, true );
+            }
+
+            float next_dist = distance;
+            next_dist += ( x_offset[i] == 0 || y_offset[i] == 0 ) ? tile_dist : diag_dist;
+            if( z_offset[i] != 0 ) {
+                if( !g->m.valid_move( pt, dest, false, true ) ) {
+                    continue;
+                }
+
+                next_dist += zlev_dist;
+            }
+
+            if( dist_map.count( dest ) == 0 || dist_map[dest] > next_dist ) {
+                open.push( std::make_pair( next_dist, dest ) );
+                dist_map[dest] = next_dist;
+            }
+        }
+    }
+
+    std::vector<std::pair<tripoint, float>> reached;
+    for( const tripoint &pt : closed ) {
+        reached.emplace_back( pt, dist_map.at( pt ) );
+    }
+    return reached;
+}
+
+// clear_map only restores the surface and above, but a strong blast also breaks into the ground.
+static void reset_blast_area( const tripoint &center, const int reach )
+{
+    for( int z = -OVERMAP_DEPTH; z < 0; z++ ) {
+        for( int x = center.x - reach; x <= center.x + reach; x++ ) {
+            for( int y = center.y - reach; y <= center.y + reach; y++ ) {
+                g->m.set( tripoint( x, y, z ), t_rock, f_null );
+                g->m.i_clear( tripoint( x, y, z ) );
+            }
+        }
+    }
+    clear_map_and_put_player_underground();
+    rng_set_engine_seed( 1234 );
+}
+
+static void check_blast_footprint( const tripoint &center, const int reach, const float power,
+                                   const float distance_factor )
+{
+    INFO( "center " << center << ", power " << power << ", distance factor " << distance_factor <<
+          ", trigdist " << trigdist );
+
+    reset_blast_area( center, reach );
+    const std::vector<std::pair<tripoint, float>> expected =
+        flood_fill_blast( center, power, distance_factor, false );
+
+    reset_blast_area( center, reach );
+    const std::vector<std::pair<tripoint, float>> propagated =
+        explosion_handler::blast_propagation( center, power, distance_factor, false );
+
+    REQUIRE( expected.size() > 1 );
+    CHECK( propagated == expected );
+}
+
+TEST_CASE( "blast_footprint_matches_flood_fill", "[explosion]" )
+{
+    REQUIRE( g->m.has_zlevels() );
+    const bool old_trigdist = trigdist;
+
+    for( const bool use_trigdist : { true, false } ) {
+        trigdist = use_trigdist;
+        for( const float distance_factor : { 0.5f, 0.8f, 0.9f } ) {
+            for( const int reach : { 3, 8, 20 } ) {
+                // Just inside and just outside of the reach, where the force drops to 1.
+                for( const float offset : { -0.01f, 0.01f } ) {
+                    const float power = std::pow( distance_factor, -( reach + offset ) );
+                    // In the open air, so the blast also spreads up and down.
+                    check_blast_footprint( tripoint( 60, 60, 1 ), reach + 1, power, distance_factor );
+                    // Near the top of the map, where the reach is cut off.
+                    check_blast_footprint( tripoint( 60, 60, OVERMAP_HEIGHT - 1 ), reach + 1, power,
+                                           distance_factor );
+                }
+            }
+        }
+    }
+
+    trigdist = old_trigdist;
+}
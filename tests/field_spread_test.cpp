@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#include "calendar.h"
+#include "catch/catch.hpp"
+#include "field.h"
+#include "field_type.h"
+#include "game.h"
+#include "game_constants.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "options_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "thread_pool.h"
+#include "type_id.h"
+
+struct gas_cloud {
+    int total_intensity = 0;
+    int tiles = 0;
+    // Largest distance of the gas from where it started.
+    int extent = 0;
+};
+
+// The gas rises, so it is cleared from the levels above as well.
+static void clear_gas_fields()
+{
+    for( int z = 0; z <= OVERMAP_HEIGHT; z++ ) {
+        clear_fields( z );
+    }
+}
+
+static gas_cloud simulate_gas_cloud( const std::string &double_buffered )
+{
+    const field_type_id fd_nuke_gas = field_type_str_id( "fd_nuke_gas" ).id();
+    override_option opt( "DOUBLE_BUFFERED_GAS_SPREAD", double_buffered );
+    clear_map_and_put_player_underground();
+    clear_gas_fields();
+    // Indoors, so the wind doesn't push the gas around.
+    build_test_map( ter_id( "t_floor" ) );
+    rng_set_engine_seed( 1234 );
+    // The gas spreads differently on each turn, every cloud starts on the same one.
+    const time_point start_turn = calendar::turn;
+
+    const tripoint center( 60, 60, 0 );
+    for( const tripoint &p : g->m.points_in_radius( center, 1 ) ) {
+        g->m.add_field( p, fd_nuke_gas, 3 );
+    }
+    for( int turn = 0; turn < 100; turn++ ) {
+        calendar::turn += 1_turns;
+        g->m.process_fields();
+    }
+
+    gas_cloud result;
+    for( const tripoint &p : g->m.points_in_radius( center, 60, 1 ) ) {
+        const field_entry *gas = g->m.field_at( p ).find_field( fd_nuke_gas );
+        if( gas != nullptr ) {
+            result.total_intensity += gas->get_field_intensity();
+            result.tiles++;
+            result.extent = std::max( result.extent, square_dist( center.xy(), p.xy() ) );
+        }
+    }
+    clear_gas_fields();
+    calendar::turn = start_turn;
+    return result;
+}
+
+TEST_CASE( "double_buffered_gas_spread_matches_serial_spread", "[field]" )
+{
+    const gas_cloud serial = simulate_gas_cloud( "false" );
+    const gas_cloud double_buffered = simulate_gas_cloud( "true" );
+    INFO( "serial: " << serial.total_intensity << " intensity on " << serial.tiles <<
+          " tiles up to " << serial.extent << " away" );
+    INFO( "double buffered: " << double_buffered.total_intensity << " intensity on " <<
+          double_buffered.tiles << " tiles up to " << double_buffered.extent << " away" );
+    REQUIRE( serial.tiles > 9 );
+    CHECK( double_buffered.total_intensity == Approx( serial.total_intensity ).epsilon( 0.25 ) );
+    CHECK( double_buffered.tiles == Approx( serial.tiles ).epsilon( 0.25 ) );
+    CHECK( std::abs( double_buffered.extent - serial.extent ) <= 3 );
+
+    // Each submap has its own random sequence, so the number of workers doesn't matter.
+    thread_pool pool( 3 );
+    override_thread_pool use_pool( pool );
+    const gas_cloud parallel = simulate_gas_cloud( "true" );
+    CHECK( parallel.total_intensity == double_buffered.total_intensity );
+    CHECK( parallel.tiles == double_buffered.tiles );
+    CHECK( parallel.extent == double_buffered.extent );
+}
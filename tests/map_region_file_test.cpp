@@ -0,0 +1,165 @@
+#include <fstream>
+#include <string>
+
+#include "catch/catch.hpp"
+#include "coordinate_conversions.h"
+#include "debug.h"
+#include "filesystem.h"
+#include "game.h"
+#include "item.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_region_file.h"
+#include "mapbuffer.h"
+#include "optional.h"
+#include "options_helpers.h"
+#include "path_info.h"
+#include "point.h"
+#include "string_formatter.h"
+
+TEST_CASE( "map_region_file_stores_quads", "[map_region_file]" )
+{
+    const std::string path = PATH_INFO::savedir() + "map_region_file_test.region";
+    remove_file( path );
+
+    const point first( 0, 0 );
+    const point second( 5, 17 );
+    const point last( SEG_SIZE - 1, SEG_SIZE - 1 );
+    {
+        map_region_file region( path );
+        CHECK( region.stored_quads().empty() );
+        region.write( first, "first quad" );
+        region.write( second, std::string( 1000, 'x' ) );
+        region.write( last, "last quad" );
+        region.write( first, "first quad, second version" );
+        CHECK( region.read( first ) == "first quad, second version" );
+        region.flush();
+    }
+
+    CHECK( map_region_file::read_quad( path, first ).value_or( "" ) == "first quad, second version" );
+    CHECK( map_region_file::read_quad( path, second ).value_or( "" ) == std::string( 1000, 'x' ) );
+    CHECK( map_region_file::read_quad( path, last ).value_or( "" ) == "last quad" );
+    CHECK( !map_region_file::read_quad( path, point( 1, 0 ) ) );
+    CHECK( !map_region_file::read_quad( path + ".missing", first ) );
+
+    SECTION( "erased quads are gone after reopening" ) {
+        {
+            map_region_file region( path );
+            CHECK( region.stored_quads().size() == 3 );
+            region.erase( second );
+            region.flush();
+        }
+        map_region_file region( path );
+        CHECK( region.stored_quads().size() == 2 );
+        CHECK( !region.contains( second ) );
+        CHECK( region.read( last ) == "last quad" );
+    }
+
+    SECTION( "rewriting quads repeatedly compacts the file" ) {
+        const std::string big( 100 * 1024, 'b' );
+        for( int i = 0; i < 10; i++ ) {
+            map_region_file region( path );
+            region.write( second, big + std::to_string( i ) );
+            region.flush();
+        }
+        map_region_file region( path );
+        CHECK( region.read( second ) == big + "9" );
+        CHECK( region.read( first ) == "first quad, second version" );
+        // Without compaction there would be ten copies, with it the dead space never
+        // grows much beyond the live data.
+        std::ifstream fin( path, std::ios::binary | std::ios::ate );
+        CHECK( static_cast<size_t>( fin.tellg() ) < 5 * big.size() );
+    }
+
+    SECTION( "small changes are appended without rewriting the file" ) {
+        const auto file_size = [&]() {
+            std::ifstream fin( path, std::ios::binary | std::ios::ate );
+            return static_cast<size_t>( fin.tellg() );
+        };
+        const size_t old_size = file_size();
+        {
+            map_region_file region( path );
+            region.write( first, "first quad, third version" );
+            region.erase( last );
+            region.flush();
+        }
+        CHECK( file_size() == old_size + std::string( "first quad, third version" ).size() );
+        CHECK( map_region_file::read_quad( path, first ).value_or( "" ) == "first quad, third version" );
+        CHECK( !map_region_file::read_quad( path, last ) );
+
+        map_region_file region( path );
+        region.compact();
+        CHECK( file_size() < old_size );
+        CHECK( region.read( first ) == "first quad, third version" );
+        CHECK( region.read( second ) == std::string( 1000, 'x' ) );
+    }
+
+    SECTION( "the file only changes on flush" ) {
+        {
+            map_region_file region( path );
+            region.write( first, "not flushed" );
+            region.erase( last );
+        }
+        CHECK( map_region_file::read_quad( path, first ).value_or( "" ) == "first quad, second version" );
+        CHECK( map_region_file::read_quad( path, last ).value_or( "" ) == "last quad" );
+        // The flushed file replaces the old one as a whole.
+        CHECK( !file_exist( path + ".tmp" ) );
+    }
+
+    SECTION( "reading a corrupted file throws" ) {
+        {
+            std::ofstream fout( path, std::ios::binary | std::ios::trunc );
+            fout << "not a region file";
+        }
+        CHECK_THROWS( map_region_file::read_quad( path, first ) );
+    }
+
+    remove_file( path );
+}
+
+TEST_CASE( "mapbuffer_saves_around_broken_region_files", "[map_region_file]" )
+{
+    clear_map();
+    const tripoint pos( 30, 30, 0 );
+    g->m.add_item( pos, item( "rock" ) );
+    const tripoint om_addr = ms_to_omt_copy( g->m.getabs( pos ) );
+    const tripoint segment = omt_to_seg_copy( om_addr );
+    const std::string maps_dir = g->get_world_base_save_path() + "/maps";
+    const std::string region_path = string_format( "%s/%d.%d.%d.region", maps_dir, segment.x,
+                                    segment.y, segment.z );
+    const std::string quad_path = string_format( "%s/%d.%d.%d/%d.%d.%d.map", maps_dir, segment.x,
+                                  segment.y, segment.z, om_addr.x, om_addr.y, om_addr.z );
+    assure_dir_exist( maps_dir );
+    {
+        std::ofstream fout( region_path, std::ios::binary | std::ios::trunc );
+        fout << "not a region file";
+    }
+    remove_file( quad_path );
+
+    captured_debug_output output;
+    SECTION( "with region files the quads are saved as separate files" ) {
+        override_option regions( "MAP_REGION_FILES", "true" );
+        bool saved = false;
+        {
+            capture_debug_output capture( output );
+            saved = MAPBUFFER.save();
+        }
+        CHECK( saved );
+        CHECK( file_exist( quad_path ) );
+    }
+    SECTION( "without region files the outdated copies can't be removed" ) {
+        override_option regions( "MAP_REGION_FILES", "false" );
+        bool saved = true;
+        {
+            capture_debug_output capture( output );
+            saved = MAPBUFFER.save();
+        }
+        CHECK_FALSE( saved );
+        CHECK( file_exist( quad_path ) );
+    }
+    // Reported, but not shown or logged.
+    CHECK( !output.messages.empty() );
+
+    remove_file( region_path );
+    remove_file( quad_path );
+}
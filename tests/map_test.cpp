@@ -2,12 +2,14 @@
 #include <vector>
 
 #include "avatar.h"
+#include "calendar.h"
 #include "catch/catch.hpp"
 #include "enums.h"
 #include "game.h"
 #include "game_constants.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "mapdata.h"
 #include "point.h"
 #include "type_id.h"
 
@@ -88,3 +90,47 @@ TEST_CASE( "place_player_can_safely_move_multiple_submaps" )
     g->place_player( tripoint_zero );
     CHECK( g->m.check_submap_active_item_consistency().empty() );
 }
+
+template<typename T>
+static bool same_cache( const T( &lhs )[MAPSIZE_X][MAPSIZE_Y], const T( &rhs )[MAPSIZE_X][MAPSIZE_Y] )
+{
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( lhs[x][y] != rhs[x][y] ) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TEST_CASE( "level_caches_rebuild_only_changed_submaps" )
+{
+    clear_map();
+    const int z = g->u.posz();
+    g->m.build_map_cache( z, true );
+
+    // A tile at the corner of a submap, so its neighbours are in four different submaps
+    const tripoint p( 5 * SEEX - 1, 5 * SEEY - 1, z );
+    calendar::turn += 1_turns;
+    g->m.ter_set( p, t_wall );
+    g->m.ter_set( p + tripoint_south_east, t_floor );
+    g->m.build_map_cache( z, true );
+
+    const level_cache_rebuild_counters &counters = g->m.get_cache_rebuild_counters();
+    CHECK( counters.turn == calendar::turn );
+    CHECK( counters.transparency == 4 );
+    CHECK( counters.outside == 4 );
+
+    const level_cache &cache = g->m.get_cache_ref( z );
+    CHECK( cache.transparency_cache[p.x][p.y] == LIGHT_TRANSPARENCY_SOLID );
+    CHECK( !cache.outside_cache[p.x][p.y] );
+
+    // Incremental rebuild must match rebuilding everything
+    const std::unique_ptr<level_cache> incremental = std::make_unique<level_cache>( cache );
+    g->m.invalidate_map_cache( z );
+    g->m.build_map_cache( z, true );
+    CHECK( same_cache( incremental->transparency_cache, cache.transparency_cache ) );
+    CHECK( same_cache( incremental->outside_cache, cache.outside_cache ) );
+    CHECK( same_cache( incremental->floor_cache, cache.floor_cache ) );
+}
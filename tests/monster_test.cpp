@@ -1,3 +1,4 @@
+#include <chrono>
 #include <cmath>
 #include <fstream>
 #include <sstream>
@@ -6,14 +7,20 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <utility>
 
 #include "avatar.h"
 #include "catch/catch.hpp"
+#include "creature_tracker.h"
+#include "field_type.h"
 #include "game.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "mapdata.h"
+#include "memory_fast.h"
 #include "monster.h"
+#include "mtype.h"
 #include "options_helpers.h"
 #include "options.h"
 #include "player.h"
@@ -22,6 +29,7 @@
 #include "item.h"
 #include "line.h"
 #include "point.h"
+#include "rng.h"
 
 using move_statistics = statistics<int>;
 
@@ -329,3 +337,206 @@ TEST_CASE( "monster_speed_trig", "[speed]" )
     trigdist = true;
     monster_check();
 }
+
+static std::set<const monster *> monsters_within_by_scan( const tripoint &pos, const int radius )
+{
+    std::set<const monster *> result;
+    for( const monster &critter : g->all_monsters() ) {
+        if( rl_dist( pos, critter.pos() ) <= radius ) {
+            result.insert( &critter );
+        }
+    }
+    return result;
+}
+
+static std::set<const monster *> monsters_within_by_index( const tripoint &pos, const int radius )
+{
+    std::set<const monster *> result;
+    for( const shared_ptr_fast<monster> &critter : g->monsters_within( pos, radius ) ) {
+        result.insert( critter.get() );
+    }
+    return result;
+}
+
+static tripoint random_free_square()
+{
+    tripoint p;
+    do {
+        p = tripoint( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+    } while( g->critter_at( p ) );
+    return p;
+}
+
+// Removes a quarter of the monsters, moves another quarter and swaps two of them, which are
+// all the ways the position of a tracked monster changes.
+static void move_and_remove_some_monsters()
+{
+    std::vector<monster *> critters;
+    for( monster &critter : g->all_monsters() ) {
+        critters.push_back( &critter );
+    }
+    for( size_t i = 0; i < critters.size(); i++ ) {
+        if( i % 4 == 0 ) {
+            g->remove_zombie( *critters[i] );
+        } else if( i % 4 == 1 ) {
+            critters[i]->setpos( random_free_square() );
+        }
+    }
+    g->swap_critters( *critters[2], *critters[3] );
+}
+
+TEST_CASE( "monsters_within_matches_full_scan", "[monster]" )
+{
+    clear_map();
+    for( int i = 0; i < 40; i++ ) {
+        spawn_test_monster( "mon_zombie", random_free_square() );
+    }
+
+    const auto check_queries = []() {
+        for( int i = 0; i < 20; i++ ) {
+            const tripoint center( rng( -10, MAPSIZE_X + 10 ), rng( -10, MAPSIZE_Y + 10 ),
+                                   rng( -1, 1 ) );
+            for( const int radius : {
+                     0, 1, 5, 13, 40, 200
+                 } ) {
+                CAPTURE( center.x, center.y, center.z, radius );
+                CHECK( monsters_within_by_index( center, radius ) ==
+                       monsters_within_by_scan( center, radius ) );
+            }
+        }
+    };
+
+    check_queries();
+
+    SECTION( "after monsters moved and were removed" ) {
+        move_and_remove_some_monsters();
+        check_queries();
+    }
+}
+
+static const std::vector<std::string> mixed_faction_monsters = {
+    "mon_zombie", "mon_zombie_dog", "mon_wolf", "mon_deer", "mon_bear", "mon_moose"
+};
+
+static std::set<const monster *> faction_monsters_within_by_scan( const mfaction_id &faction,
+        const tripoint &pos, const int radius )
+{
+    std::set<const monster *> result;
+    const auto iter = g->critter_tracker->factions().find( faction );
+    if( iter == g->critter_tracker->factions().end() ) {
+        return result;
+    }
+    for( const weak_ptr_fast<monster> &weak : iter->second ) {
+        const shared_ptr_fast<monster> critter = weak.lock();
+        if( critter && !critter->is_dead() && rl_dist( pos, critter->pos() ) <= radius ) {
+            result.insert( critter.get() );
+        }
+    }
+    return result;
+}
+
+static std::set<const monster *> faction_monsters_within_by_index( const mfaction_id &faction,
+        const tripoint &pos, const int radius )
+{
+    std::set<const monster *> result;
+    for( const shared_ptr_fast<monster> &critter :
+         g->critter_tracker->monsters_of_faction_within( faction, pos, radius ) ) {
+        result.insert( critter.get() );
+    }
+    return result;
+}
+
+TEST_CASE( "monsters_of_faction_within_matches_full_scan", "[monster]" )
+{
+    clear_map();
+    for( int i = 0; i < 60; i++ ) {
+        spawn_test_monster( random_entry( mixed_faction_monsters ), random_free_square() );
+    }
+    std::vector<mfaction_id> factions;
+    for( const auto &entry : g->critter_tracker->factions() ) {
+        factions.push_back( entry.first );
+    }
+    REQUIRE( factions.size() > 1 );
+
+    const auto check_queries = [&]() {
+        for( int i = 0; i < 10; i++ ) {
+            const tripoint center( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+            for( const mfaction_id &faction : factions ) {
+                for( const int radius : {
+                         1, 8, 40
+                     } ) {
+                    CAPTURE( center.x, center.y, faction.id().str(), radius );
+                    CHECK( faction_monsters_within_by_index( faction, center, radius ) ==
+                           faction_monsters_within_by_scan( faction, center, radius ) );
+                }
+            }
+        }
+    };
+
+    check_queries();
+
+    SECTION( "after monsters moved and were removed" ) {
+        move_and_remove_some_monsters();
+        check_queries();
+    }
+}
+
+// Monsters without pathfinding settings only ever step toward their goal.
+TEST_CASE( "monsters_without_pathfinding_move_greedily", "[monster]" )
+{
+    clear_map_and_put_player_underground();
+    const tripoint start( 60, 60, 0 );
+    const tripoint goal = start + point( 5, 0 );
+
+    SECTION( "a wall across the direct way stops a zombie" ) {
+        for( int dy = -1; dy <= 1; dy++ ) {
+            g->m.ter_set( start + point( 1, dy ), t_wall );
+        }
+        monster &zombie = spawn_test_monster( "mon_zombie", start );
+        REQUIRE( zombie.get_pathfinding_settings().max_dist == 0 );
+        zombie.anger = 100;
+        zombie.set_dest( goal );
+        zombie.set_moves( 0 );
+        zombie.move();
+        // Walking around the wall would need pathfinding
+        CHECK( zombie.pos() == start );
+    }
+
+    SECTION( "a fire avoiding monster steps around a fire on the direct way" ) {
+        const tripoint fire = start + point_east;
+        g->m.add_field( fire, fd_fire, 1 );
+        monster &roach = spawn_test_monster( "mon_giant_cockroach", start );
+        REQUIRE( roach.get_pathfinding_settings().max_dist == 0 );
+        REQUIRE( roach.has_flag( MF_AVOID_FIRE ) );
+        roach.anger = 100;
+        roach.set_dest( goal );
+        roach.set_moves( 0 );
+        roach.move();
+        CHECK( roach.pos() != fire );
+        CHECK( roach.pos() != start );
+        CHECK( roach.pos().x == start.x + 1 );
+    }
+    clear_map();
+}
+
+// Not run by default, reports how long planning takes for a crowd of monsters.
+TEST_CASE( "monster_plan_benchmark", "[.]" )
+{
+    clear_map();
+    for( int i = 0; i < 500; i++ ) {
+        spawn_test_monster( random_entry( mixed_faction_monsters ), random_free_square() );
+    }
+    g->m.build_map_cache( 0 );
+
+    const int iterations = 10;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < iterations; i++ ) {
+        for( monster &critter : g->all_monsters() ) {
+            critter.plan();
+        }
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    const long long diff = std::chrono::duration_cast<std::chrono::microseconds>( end - start ).count();
+    WARN( "Planning for " << g->num_creatures() - 1 << " monsters " << iterations <<
+          " times took " << diff << " microseconds." );
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <sstream>
@@ -13,6 +14,7 @@
 #include "field.h"
 #include "field_type.h"
 #include "game.h"
+#include "game_constants.h"
 #include "line.h"
 #include "map.h"
 #include "map_helpers.h"
@@ -445,3 +447,95 @@ TEST_CASE( "npc_can_target_player" )
     REQUIRE( hostile.current_target() != nullptr );
     CHECK( hostile.current_target() == static_cast<Creature *>( &g->u ) );
 }
+
+// NPCs look for items with the vision caches of the current turn.
+static void build_vision_caches()
+{
+    g->reset_light_level();
+    g->m.invalidate_map_cache( 0 );
+    g->m.build_map_cache( 0 );
+}
+
+TEST_CASE( "npc_wants_the_most_valuable_item_in_sight", "[npc]" )
+{
+    calendar::turn = calendar::turn_zero + 12_hours;
+    g->faction_manager_ptr->create_if_needed();
+    clear_map();
+    clear_npcs();
+    g->place_player( tripoint( 60, 60, 0 ) );
+
+    npc &guy = spawn_npc( g->u.pos().xy() + point( 0, 10 ), "thug" );
+    const std::vector<std::string> loot = {
+        "rock", "scrap", "hammer", "knife_combat", "flashlight", "bottle_plastic"
+    };
+    int best_value = guy.minimum_item_value();
+    for( size_t i = 0; i < loot.size(); i++ ) {
+        const tripoint p = guy.pos() + point( static_cast<int>( i ) - 3, 2 );
+        const item &it = g->m.add_item( p, item( loot[i] ) );
+        best_value = std::max( best_value, guy.value( it ) );
+    }
+    INFO( "best value: " << best_value );
+    REQUIRE( best_value > guy.minimum_item_value() );
+    build_vision_caches();
+
+    guy.find_item();
+    const map_stack wanted = g->m.i_at( guy.wanted_item_pos );
+    REQUIRE( wanted.size() == 1 );
+    CHECK( guy.value( *wanted.begin() ) == best_value );
+}
+
+TEST_CASE( "npc_does_not_steal_while_followers_watch", "[npc]" )
+{
+    calendar::turn = calendar::turn_zero + 12_hours;
+    g->faction_manager_ptr->create_if_needed();
+    clear_map();
+    clear_npcs();
+    g->place_player( tripoint( 60, 60, 0 ) );
+
+    // A wall across the map hides the thief and the loot from the player.
+    const ter_id t_brick_wall( "t_brick_wall" );
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        g->m.ter_set( tripoint( x, 65, 0 ), t_brick_wall );
+    }
+    npc &thief = spawn_npc( point( 60, 70 ), "thug" );
+    npc &follower = spawn_npc( point( 62, 60 ), "thug" );
+    follower.set_attitude( NPCATT_FOLLOW );
+    g->add_npc_follower( follower.getID() );
+    const tripoint loot_pos = thief.pos() + point( 0, 2 );
+    item &loot = g->m.add_item( loot_pos, item( "knife_combat" ) );
+    loot.set_owner( g->u );
+    REQUIRE( thief.value( loot ) > thief.minimum_item_value() );
+    build_vision_caches();
+    const tripoint next_to_thief = thief.pos() + point( 2, 0 );
+
+    SECTION( "nobody sees the thief, so it goes for the loot" ) {
+        thief.find_item();
+        CHECK( thief.fetching_item );
+        CHECK( thief.wanted_item_pos == loot_pos );
+    }
+
+    SECTION( "a follower sees the thief, so it leaves the loot alone" ) {
+        follower.setpos( next_to_thief );
+        thief.find_item();
+        CHECK_FALSE( thief.fetching_item );
+    }
+
+    SECTION( "loot nobody owns is taken in sight of the followers" ) {
+        loot.remove_owner();
+        follower.setpos( next_to_thief );
+        thief.find_item();
+        CHECK( thief.fetching_item );
+        CHECK( thief.wanted_item_pos == loot_pos );
+    }
+
+    SECTION( "the witnesses are checked again when one moves during the turn" ) {
+        // Both searches share the witnesses of this turn.
+        thief.find_item();
+        REQUIRE( thief.fetching_item );
+        follower.setpos( next_to_thief );
+        thief.find_item();
+        CHECK_FALSE( thief.fetching_item );
+    }
+
+    g->remove_npc_follower( follower.getID() );
+}
@@ -0,0 +1,43 @@
+#include <string>
+
+#include "catch/catch.hpp"
+#include "options.h"
+#include "options_helpers.h"
+#include "worldfactory.h"
+
+TEST_CASE( "option_ref_follows_option_changes", "[options]" )
+{
+    static const option_ref<bool> autosave( "AUTOSAVE" );
+    static const option_ref<int> autosave_turns( "AUTOSAVE_TURNS" );
+
+    {
+        override_option opt( "AUTOSAVE", "false" );
+        override_option turns( "AUTOSAVE_TURNS", "20" );
+        CHECK_FALSE( autosave.get() );
+        CHECK( autosave_turns.get() == 20 );
+    }
+    {
+        override_option opt( "AUTOSAVE", "true" );
+        override_option turns( "AUTOSAVE_TURNS", "30" );
+        CHECK( autosave.get() );
+        CHECK( autosave_turns.get() == 30 );
+    }
+    CHECK( autosave.get() == get_option<bool>( "AUTOSAVE" ) );
+}
+
+TEST_CASE( "option_ref_follows_world_options", "[options]" )
+{
+    static const option_ref<int> city_size( "CITY_SIZE" );
+    REQUIRE( world_generator->active_world != nullptr );
+    const int world_city_size = get_option<int>( "CITY_SIZE" );
+    CHECK( city_size.get() == world_city_size );
+
+    const int other_city_size = world_city_size == 0 ? 1 : world_city_size - 1;
+    options_manager::options_container other_world = get_options().get_world_defaults();
+    other_world["CITY_SIZE"].setValue( other_city_size );
+    get_options().set_world_options( &other_world );
+    CHECK( city_size.get() == other_city_size );
+
+    world_generator->set_active_world( world_generator->active_world );
+    CHECK( city_size.get() == world_city_size );
+}
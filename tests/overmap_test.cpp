@@ -1,5 +1,9 @@
 #include <algorithm>
+#include <chrono>
+#include <map>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "calendar.h"
@@ -8,10 +12,13 @@
 #include "enums.h"
 #include "game_constants.h"
 #include "omdata.h"
+#include "options_helpers.h"
 #include "overmap.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
 #include "point.h"
+#include "rng.h"
+#include "thread_pool.h"
 #include "type_id.h"
 
 TEST_CASE( "set_and_get_overmap_scents" )
@@ -175,3 +182,156 @@ TEST_CASE( "is_ot_match", "[overmap][terrain]" )
     }
 }
 
+TEST_CASE( "indexed_terrain_search_matches_full_scan", "[overmap][terrain]" )
+{
+    const tripoint origin( OMAPX / 2, OMAPY / 2, 0 );
+    const int radius = OMAPX / 3;
+    // None of these are the default terrain of a z-level, so none of them fall back to a scan.
+    const std::vector<std::pair<std::string, ot_match_type>> queries = {
+        { "house", ot_match_type::prefix },
+        { "road", ot_match_type::type },
+        { "forest_thick", ot_match_type::exact },
+        { "forest", ot_match_type::contains },
+        { "lab", ot_match_type::contains },
+    };
+    for( const std::pair<std::string, ot_match_type> &query : queries ) {
+        INFO( query.first );
+        std::vector<tripoint> expected;
+        for( const tripoint &p : closest_tripoints_first( origin, radius ) ) {
+            if( overmap_buffer.check_ot( query.first, query.second, p ) ) {
+                expected.push_back( p );
+            }
+        }
+        CHECK( overmap_buffer.find_all( origin, query.first, radius, false, query.second ) == expected );
+    }
+
+    // Changing the terrain keeps the index up to date.
+    overmap &om = overmap_buffer.get( point_zero );
+    const tripoint changed = origin + point( 5, -7 );
+    const oter_id previous = om.ter( changed );
+    om.ter_set( changed, oter_id( "central_lab" ) );
+    CHECK( overmap_buffer.find_closest( origin, "central_lab", radius, false,
+                                        ot_match_type::exact ) == changed );
+    om.ter_set( changed, previous );
+    CHECK( overmap_buffer.find_closest( origin, "central_lab", radius, false,
+                                        ot_match_type::exact ) != changed );
+    std::vector<tripoint> expected;
+    for( const tripoint &p : closest_tripoints_first( origin, radius ) ) {
+        if( overmap_buffer.ter( p ) == previous ) {
+            expected.push_back( p );
+        }
+    }
+    CHECK( overmap_buffer.find_all( origin, previous.id().str(), radius, false,
+                                    ot_match_type::exact ) == expected );
+}
+
+TEST_CASE( "pregenerated_overmaps_are_taken_over", "[overmap][slow]" )
+{
+    // Seeded, and waiting for the worker, so it's the same overmaps that get generated in the
+    // background every time. Generating on the main thread can still create adjacent
+    // overmaps for the mandatory specials, those simply aren't pregenerated.
+    // The pregeneration seeds follow from the world seed, which is the same in every test
+    // run. Around this center none of the jobs fail to place a mandatory special (which
+    // would also fail the jobs next to it).
+    rng_set_engine_seed( 4242 );
+    const point center( 54, 30 );
+    overmap &center_om = overmap_buffer.get( center );
+    // Queuing the jobs doesn't draw from the main thread's random numbers.
+    rng_set_engine_seed( 4243 );
+    const unsigned int next_random = rng_bits();
+    rng_set_engine_seed( 4243 );
+    overmap_buffer.pregenerate_around( center );
+    CHECK( rng_bits() == next_random );
+    overmap_buffer.wait_for_pregeneration();
+
+    std::map<point, const overmap *> pregenerated;
+    for( const point &p : closest_points_first( center, 1 ) ) {
+        if( const overmap *om = overmap_buffer.find_pregenerated( p ) ) {
+            CHECK( overmap_buffer.get_existing( p ) == nullptr );
+            pregenerated[p] = om;
+        }
+    }
+    CHECK_FALSE( pregenerated.empty() );
+
+    // All of them end up in the buffer exactly once, the pregenerated ones are taken over.
+    for( const point &p : closest_points_first( center, 1 ) ) {
+        overmap &om = overmap_buffer.get( p );
+        CHECK( om.pos() == p );
+        CHECK( &overmap_buffer.get( p ) == &om );
+        CHECK( overmap_buffer.get_existing( p ) == &om );
+        const auto iter = pregenerated.find( p );
+        if( iter != pregenerated.end() ) {
+            CHECK( iter->second == &om );
+        }
+        CHECK( overmap_buffer.find_pregenerated( p ) == nullptr );
+    }
+    CHECK( &overmap_buffer.get( center ) == &center_om );
+
+    // Canceled overmaps never become part of the buffer.
+    const point far = center + point( 2, 0 );
+    const overmap *far_before = overmap_buffer.get_existing( far );
+    overmap_buffer.pregenerate_around( center + point_east );
+    overmap_buffer.cancel_pregeneration();
+    CHECK( overmap_buffer.find_pregenerated( far ) == nullptr );
+    CHECK( overmap_buffer.get_existing( far ) == far_before );
+    overmap &generated = overmap_buffer.get( far );
+    CHECK( generated.pos() == far );
+}
+
+static std::unique_ptr<overmap> generate_with_seed( const point &p, const unsigned int seed )
+{
+    std::unique_ptr<overmap> om = std::make_unique<overmap>( p );
+    rng_set_engine_seed( seed );
+    om->generate_detached( nullptr, nullptr, nullptr, nullptr,
+                         overmap::prepare_detached_generation() );
+    return om;
+}
+
+TEST_CASE( "parallel_overmap_generation_is_deterministic", "[overmap][slow]" )
+{
+    const point p( 40, -40 );
+    const unsigned int seed = 12345;
+    std::unique_ptr<overmap> serial;
+    std::unique_ptr<overmap> parallel;
+    {
+        override_option opt( "PARALLEL_OVERMAP_GENERATION", "false" );
+        serial = generate_with_seed( p, seed );
+    }
+    {
+        // The game's pool has no workers on a single core, so the test brings its own.
+        thread_pool pool( 3 );
+        override_thread_pool use_pool( pool );
+        override_option opt( "PARALLEL_OVERMAP_GENERATION", "true" );
+        parallel = generate_with_seed( p, seed );
+    }
+
+    int differences = 0;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        for( int x = 0; x < OMAPX; x++ ) {
+            for( int y = 0; y < OMAPY; y++ ) {
+                if( serial->ter( { x, y, z } ) != parallel->ter( { x, y, z } ) ) {
+                    differences++;
+                }
+            }
+        }
+    }
+    CHECK( differences == 0 );
+}
+
+TEST_CASE( "overmap_generation_benchmark", "[.]" )
+{
+    const int count = 10;
+    overmap_generation_timings().clear();
+    const overmap::generation_context context = overmap::prepare_detached_generation();
+    const auto start = std::chrono::high_resolution_clock::now();
+    for( int i = 0; i < count; i++ ) {
+        overmap om( point( 100 + i, 100 ) );
+        om.generate_detached( nullptr, nullptr, nullptr, nullptr, context );
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    const long long diff = std::chrono::duration_cast<std::chrono::milliseconds>( end - start ).count();
+    WARN( "Generating " << count << " overmaps took " << diff << " milliseconds." );
+    for( const auto &stage : overmap_generation_timings() ) {
+        WARN( "  " << stage.first << " took " << stage.second.count() * 1000 << " milliseconds." );
+    }
+}
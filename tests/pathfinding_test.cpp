@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <vector>
+
+#include "catch/catch.hpp"
+#include "game.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "map_iterator.h"
+#include "mapdata.h"
+#include "optional.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "type_id.h"
+
+static bool route_is_connected( const tripoint &from, const std::vector<tripoint> &route )
+{
+    tripoint prev = from;
+    for( const tripoint &p : route ) {
+        if( square_dist( prev, p ) != 1 ) {
+            return false;
+        }
+        prev = p;
+    }
+    return true;
+}
+
+TEST_CASE( "remembered_routes_follow_map_changes", "[pathfinding]" )
+{
+    clear_map_and_put_player_underground();
+    map &here = g->m;
+    const tripoint center( 60, 60, 0 );
+    for( int dy = -5; dy <= 5; dy++ ) {
+        here.ter_set( center + point( 0, dy ), t_wall );
+    }
+
+    const pathfinding_settings settings( 0, 30, 60, 0, false, false, true, false, false );
+    const tripoint from = center + point( -5, 0 );
+    const tripoint to = center + point( 5, 0 );
+
+    const std::vector<tripoint> first = here.route( from, to, settings );
+    REQUIRE( !first.empty() );
+    REQUIRE( first.back() == to );
+    REQUIRE( route_is_connected( from, first ) );
+
+    SECTION( "repeated query returns the same route" ) {
+        CHECK( here.route( from, to, settings ) == first );
+    }
+
+    SECTION( "query from a tile along the route returns the rest of it" ) {
+        const std::vector<tripoint> rest = here.route( first[2], to, settings );
+        CHECK( rest == std::vector<tripoint>( first.begin() + 3, first.end() ) );
+    }
+
+    SECTION( "blocking the route forces a detour" ) {
+        const tripoint blocked = first[first.size() / 2];
+        here.ter_set( blocked, t_wall );
+        const std::vector<tripoint> detour = here.route( from, to, settings );
+        REQUIRE( !detour.empty() );
+        CHECK( detour.back() == to );
+        CHECK( route_is_connected( from, detour ) );
+        CHECK( std::find( detour.begin(), detour.end(), blocked ) == detour.end() );
+    }
+
+    SECTION( "target moving by one tile still gets a connected route" ) {
+        const tripoint moved = to + point_east;
+        const std::vector<tripoint> extended = here.route( from, moved, settings );
+        REQUIRE( !extended.empty() );
+        CHECK( extended.back() == moved );
+        CHECK( route_is_connected( from, extended ) );
+    }
+}
+
+TEST_CASE( "flow_field_steps_lead_to_target", "[pathfinding]" )
+{
+    clear_map_and_put_player_underground();
+    map &here = g->m;
+    const tripoint center( 60, 60, 0 );
+    for( int dy = -5; dy <= 5; dy++ ) {
+        here.ter_set( center + point( 0, dy ), t_wall );
+    }
+
+    const pathfinding_settings settings( 0, 30, 60, 0, false, false, true, false, false );
+    const tripoint to = center + point( 5, 0 );
+
+    SECTION( "following the steps reaches the target around the wall" ) {
+        for( const tripoint &start : {
+                 center + point( -5, 0 ), center + point( -3, 4 ), center + point( -8, -2 )
+             } ) {
+            tripoint cur = start;
+            for( int i = 0; i < 40 && cur != to; i++ ) {
+                const cata::optional<tripoint> next = here.flow_step( cur, to, settings );
+                REQUIRE( next );
+                REQUIRE( square_dist( cur, *next ) == 1 );
+                REQUIRE( here.ter( *next ) != t_wall );
+                cur = *next;
+            }
+            CHECK( cur == to );
+        }
+    }
+
+    SECTION( "settings with the same costs share a field" ) {
+        pathfinding_settings shorter = settings;
+        shorter.max_dist = 20;
+        shorter.max_length = 40;
+        const flow_field &field = here.get_flow_field( to, settings );
+        CHECK( &here.get_flow_field( to, shorter ) == &field );
+
+        pathfinding_settings basher = settings;
+        basher.bash_strength = 10;
+        CHECK( &here.get_flow_field( to, basher ) != &field );
+    }
+
+    SECTION( "walled in target can't be reached" ) {
+        for( const tripoint &p : here.points_in_radius( to, 1 ) ) {
+            if( p != to ) {
+                here.ter_set( p, t_wall );
+            }
+        }
+        CHECK( !here.flow_step( center + point( -5, 0 ), to, settings ) );
+    }
+}
+
+TEST_CASE( "flow_field_does_not_lead_across_traps", "[pathfinding]" )
+{
+    clear_map_and_put_player_underground();
+    map &here = g->m;
+    const tripoint center( 60, 60, 0 );
+    // A corridor with a trap in the middle, so the only way through is across it.
+    for( int dx = -6; dx <= 6; dx++ ) {
+        here.ter_set( center + point( dx, -1 ), t_wall );
+        here.ter_set( center + point( dx, 1 ), t_wall );
+    }
+    here.ter_set( center + point( -6, 0 ), t_wall );
+    here.ter_set( center + point( 6, 0 ), t_wall );
+    here.trap_set( center, trap_id( "tr_beartrap" ) );
+
+    const tripoint from = center + point( -4, 0 );
+    const tripoint to = center + point( 4, 0 );
+
+    SECTION( "monsters avoiding traps get no step" ) {
+        const pathfinding_settings settings( 0, 30, 60, 0, false, true, true, false, false );
+        CHECK( !here.flow_step( from, to, settings ) );
+        CHECK( !here.flow_step( center + point_west, to, settings ) );
+    }
+
+    SECTION( "monsters ignoring traps walk across" ) {
+        const pathfinding_settings settings( 0, 30, 60, 0, false, false, true, false, false );
+        tripoint cur = from;
+        for( int i = 0; i < 10 && cur != to; i++ ) {
+            const cata::optional<tripoint> next = here.flow_step( cur, to, settings );
+            REQUIRE( next );
+            cur = *next;
+        }
+        CHECK( cur == to );
+    }
+}
@@ -4,7 +4,9 @@
 #include "calendar.h"
 #include "catch/catch.hpp"
 #include "game.h"
+#include "game_constants.h"
 #include "item.h"
+#include "options_helpers.h"
 #include "point.h"
 #include "weather.h"
 
@@ -73,3 +75,47 @@ TEST_CASE( "Rate of rotting" )
         CHECK( !freeze_item.item_tags.count( "FROZEN" ) );
     }
 }
+
+static void check_fast_forwarded_rot( const tripoint &pos )
+{
+    item fast_item( "potato" );
+    item stepped_item( "potato" );
+    fast_item.process( nullptr, pos, false, 1, temperature_flag::TEMP_NORMAL );
+    stepped_item.process( nullptr, pos, false, 1, temperature_flag::TEMP_NORMAL );
+
+    // Long enough for most of the time to be fast-forwarded, short enough not to rot away.
+    calendar::turn += 20_days;
+    {
+        override_option opt( "FAST_FORWARD_ITEM_ROT", "true" );
+        fast_item.process( nullptr, pos, false, 1, temperature_flag::TEMP_NORMAL );
+    }
+    {
+        override_option opt( "FAST_FORWARD_ITEM_ROT", "false" );
+        stepped_item.process( nullptr, pos, false, 1, temperature_flag::TEMP_NORMAL );
+    }
+
+    REQUIRE( stepped_item.get_rot() > 1_days );
+    // The weather samples are interpolated, which only changes the temperatures slightly.
+    CHECK( to_turns<int>( fast_item.get_rot() ) ==
+           Approx( to_turns<int>( stepped_item.get_rot() ) ).epsilon( 0.02 ) );
+    CHECK( fast_item.temperature == Approx( stepped_item.temperature ).margin( 100000 ) );
+}
+
+TEST_CASE( "fast_forwarded_rot_matches_stepped_rot", "[item][rot]" )
+{
+    if( calendar::turn <= calendar::start_of_cataclysm ) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+    const time_point start_turn = calendar::turn;
+    set_map_temperature( 65 );
+
+    SECTION( "at the origin" ) {
+        check_fast_forwarded_rot( tripoint_zero );
+    }
+    SECTION( "far away and not on a submap corner" ) {
+        // The weather is sampled at the corner of each submap, not where the item is.
+        check_fast_forwarded_rot( tripoint( 20 * SEEX * MAPSIZE + 5, -17 * SEEY * MAPSIZE + 7, 0 ) );
+    }
+
+    calendar::turn = start_turn;
+}
@@ -0,0 +1,93 @@
+#include <memory>
+
+#include "catch/catch.hpp"
+#include "game_constants.h"
+#include "point.h"
+#include "rng.h"
+#include "scent_map.h"
+
+template<typename T>
+using scent_array = scent_map::scent_array<T>;
+
+// The diffusion step as it was written before it was vectorized
+static void reference_diffuse( scent_array<int> &grscent, const scent_array<bool> &blocks_scent,
+                               const scent_array<bool> &reduces_scent, const point &min, const point &max )
+{
+    auto sum_3_scent_y = std::make_unique<scent_array<int>>();
+    auto squares_used_y = std::make_unique<scent_array<int>>();
+    const int diffusivity = 100;
+    for( int x = min.x - 1; x <= max.x + 1; ++x ) {
+        for( int y = min.y; y <= max.y; ++y ) {
+            ( *sum_3_scent_y )[y][x] = 0;
+            ( *squares_used_y )[y][x] = 0;
+            for( int i = y - 1; i <= y + 1; ++i ) {
+                if( !blocks_scent[x][i] ) {
+                    if( reduces_scent[x][i] ) {
+                        ( *sum_3_scent_y )[y][x] += 2 * grscent[x][i];
+                        ( *squares_used_y )[y][x] += 2;
+                    } else {
+                        ( *sum_3_scent_y )[y][x] += 10 * grscent[x][i];
+                        ( *squares_used_y )[y][x] += 10;
+                    }
+                }
+            }
+        }
+    }
+
+    for( int x = min.x; x <= max.x; ++x ) {
+        for( int y = min.y; y <= max.y; ++y ) {
+            int &scent_here = grscent[x][y];
+            if( !blocks_scent[x][y] ) {
+                const int squares_used = ( *squares_used_y )[y][x - 1]
+                                         + ( *squares_used_y )[y][x]
+                                         + ( *squares_used_y )[y][x + 1];
+
+                int this_diffusivity;
+                if( !reduces_scent[x][y] ) {
+                    this_diffusivity = diffusivity;
+                } else {
+                    this_diffusivity = diffusivity / 5;
+                }
+                int temp_scent = scent_here * ( 10 * 1000 - squares_used * this_diffusivity );
+                temp_scent -= scent_here * this_diffusivity * ( 90 - squares_used ) / 5;
+                scent_here =
+                    ( temp_scent
+                      + this_diffusivity * ( ( *sum_3_scent_y )[y][x - 1]
+                                             + ( *sum_3_scent_y )[y][x]
+                                             + ( *sum_3_scent_y )[y][x + 1] )
+                    ) / ( 1000 * 10 );
+            } else {
+                scent_here = 0;
+            }
+        }
+    }
+}
+
+TEST_CASE( "scent_diffusion_matches_reference", "[scent]" )
+{
+    auto blocks = std::make_unique<scent_array<bool>>();
+    auto reduces = std::make_unique<scent_array<bool>>();
+    auto scent = std::make_unique<scent_array<int>>();
+    auto expected = std::make_unique<scent_array<int>>();
+
+    const point min( 20, 20 );
+    const point max( MAPSIZE_X - 21, MAPSIZE_Y - 21 );
+    for( int iteration = 0; iteration < 10; iteration++ ) {
+        // Sometimes sparse, sometimes dense blockers
+        const int blocker_chance = rng( 2, 20 );
+        for( int x = 0; x < MAPSIZE_X; x++ ) {
+            for( int y = 0; y < MAPSIZE_Y; y++ ) {
+                ( *blocks )[x][y] = one_in( blocker_chance );
+                ( *reduces )[x][y] = one_in( blocker_chance );
+                ( *scent )[x][y] = one_in( 3 ) ? rng( 0, 10000 ) : 0;
+            }
+        }
+        *expected = *scent;
+
+        for( int turn = 0; turn < 5; turn++ ) {
+            scent_map::diffuse( *scent, *blocks, *reduces, min, max );
+            reference_diffuse( *expected, *blocks, *reduces, min, max );
+        }
+        CHECK( *scent == *expected );
+    }
+}
@@ -1,8 +1,18 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "binary_io.h"
+#include "calendar.h"
 #include "catch/catch.hpp"
+#include "game.h"
 #include "submap.h"
 #include "game_constants.h"
 #include "int_id.h"
+#include "item.h"
+#include "json.h"
 #include "point.h"
+#include "string_id.h"
 #include "type_id.h"
 
 TEST_CASE( "submap rotation", "[submap]" )
@@ -88,3 +98,91 @@ TEST_CASE( "submap rotation", "[submap]" )
         }
     }
 }
+
+static std::string submap_as_json( const submap &sm )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.start_object();
+    sm.store( jsout );
+    jsout.end_object();
+    return os.str();
+}
+
+TEST_CASE( "submap_binary_round_trip", "[submap]" )
+{
+    submap sm;
+    sm.set_all_ter( ter_str_id( "t_dirt" ).id() );
+    sm.set_ter( { 3, 4 }, ter_str_id( "t_floor" ).id() );
+    sm.set_ter( { SEEX - 1, SEEY - 1 }, ter_str_id( "t_wall" ).id() );
+    sm.set_furn( { 2, 2 }, furn_str_id( "f_chair" ).id() );
+    sm.set_trap( { 5, 1 }, trap_str_id( "tr_beartrap" ).id() );
+    sm.set_radiation( { 7, 8 }, 12 );
+    sm.set_radiation( { 0, 0 }, -3 );
+    sm.set_temperature( 42 );
+    sm.last_touched = calendar::turn_zero + 3_days;
+    sm.get_items( { 1, 1 } ).insert( item( "rock" ) );
+    sm.get_items( { 1, 1 } ).insert( item( "2x4" ) );
+    sm.get_items( { 10, 0 } ).insert( item( "water_clean" ) );
+    sm.add_field( { 6, 6 }, field_type_str_id( "fd_blood" ).id(), 2, 5_turns );
+    sm.insert_cosmetic( { 4, 4 }, "SIGNAGE", "Keep out" );
+    sm.spawns.emplace_back( mtype_id( "mon_zombie" ), 2, point( 3, 3 ) );
+
+    binary_out out;
+    sm.store( out );
+
+    submap loaded;
+    binary_in in( out.data() );
+    loaded.load( in, savegame_version );
+    CHECK( in.eof() );
+
+    CHECK( submap_as_json( loaded ) == submap_as_json( sm ) );
+    CHECK( loaded.get_radiation( { 7, 8 } ) == 12 );
+    CHECK( loaded.field_count == 1 );
+}
+
+static std::vector<point> tiles_with_fields( submap &sm )
+{
+    std::vector<point> result;
+    sm.for_each_field( [&result]( const point & p, field & ) {
+        result.push_back( p );
+    } );
+    return result;
+}
+
+TEST_CASE( "submap_visits_only_tiles_with_fields", "[submap]" )
+{
+    const field_type_id fd_blood = field_type_str_id( "fd_blood" ).id();
+    const field_type_id fd_smoke = field_type_str_id( "fd_smoke" ).id();
+    submap sm;
+    CHECK( tiles_with_fields( sm ).empty() );
+
+    CHECK( sm.add_field( { 3, 1 }, fd_blood, 1, 0_turns ) );
+    CHECK( sm.add_field( { 0, 5 }, fd_blood, 1, 0_turns ) );
+    CHECK( sm.add_field( { 0, 5 }, fd_smoke, 1, 0_turns ) );
+    CHECK_FALSE( sm.add_field( { 0, 5 }, fd_smoke, 1, 0_turns ) );
+    CHECK( sm.field_count == 3 );
+    CHECK( tiles_with_fields( sm ) == std::vector<point> { { 0, 5 }, { 3, 1 } } );
+
+    // Fields added to later tiles are visited in the same pass.
+    std::vector<point> visited;
+    sm.for_each_field( [&]( const point & p, field & ) {
+        visited.push_back( p );
+        if( p == point( 0, 5 ) ) {
+            sm.add_field( { 1, 0 }, fd_smoke, 1, 0_turns );
+        }
+    } );
+    CHECK( visited == std::vector<point> { { 0, 5 }, { 1, 0 }, { 3, 1 } } );
+
+    // Emptied tiles are dropped.
+    sm.get_field( { 3, 1 } ).remove_field( fd_blood );
+    CHECK( tiles_with_fields( sm ) == std::vector<point> { { 0, 5 }, { 1, 0 } } );
+
+    // The fields follow their tiles when the submap is rotated.
+    sm.rotate( 1 );
+    std::vector<point> rotated = tiles_with_fields( sm );
+    REQUIRE( rotated.size() == 2 );
+    for( const point &p : rotated ) {
+        CHECK( sm.get_field( p ).field_count() > 0 );
+    }
+}
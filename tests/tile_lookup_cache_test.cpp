@@ -0,0 +1,169 @@
+#include <array>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "calendar.h"
+#include "catch/catch.hpp"
+#include "mapdata.h"
+#include "tile_lookup_cache.h"
+#include "type_id.h"
+
+namespace
+{
+enum class test_category : int {
+    terrain,
+    furniture,
+};
+
+struct test_lookup {
+    std::string id;
+    int tileset = 0;
+};
+
+// Stands in for the tileset, counts how often the cache asks it.
+struct test_tileset {
+    int generation = 1;
+    int lookups = 0;
+
+    test_lookup operator()( const std::string &id ) {
+        lookups++;
+        return { id, generation };
+    }
+};
+} // namespace
+
+using test_cache = tile_lookup_cache<test_lookup, test_category>;
+
+TEST_CASE( "tile_lookup_cache_looks_up_each_id_once", "[tiles]" )
+{
+    test_cache cache;
+    test_tileset tileset;
+    cache.set_season( SUMMER );
+
+    const test_lookup &floor = cache.find( "t_floor", test_category::terrain, tileset );
+    CHECK( floor.id == "t_floor" );
+    CHECK( &cache.find( "t_floor", test_category::terrain, tileset ) == &floor );
+    CHECK( tileset.lookups == 1 );
+
+    SECTION( "categories are separate" ) {
+        CHECK( &cache.find( "t_floor", test_category::furniture, tileset ) != &floor );
+        CHECK( tileset.lookups == 2 );
+    }
+
+    SECTION( "int ids share the lookup of their string id" ) {
+        const ter_id t_floor( "t_floor" );
+        CHECK( &cache.find( t_floor, test_category::terrain, tileset ) == &floor );
+        CHECK( &cache.find( t_floor, test_category::terrain, tileset ) == &floor );
+        const ter_id t_dirt( "t_dirt" );
+        CHECK( cache.find( t_dirt, test_category::terrain, tileset ).id == "t_dirt" );
+        CHECK( tileset.lookups == 2 );
+        CHECK( cache.size() == 2 );
+    }
+}
+
+TEST_CASE( "tile_lookup_cache_forgets_lookups_of_another_tileset_or_season", "[tiles]" )
+{
+    test_cache cache;
+    test_tileset tileset;
+    const ter_id t_floor( "t_floor" );
+    cache.set_season( SUMMER );
+    REQUIRE( cache.find( "t_dirt", test_category::terrain, tileset ).tileset == 1 );
+    REQUIRE( cache.find( t_floor, test_category::terrain, tileset ).tileset == 1 );
+
+    SECTION( "reloading the tileset" ) {
+        tileset.generation = 2;
+        cache.clear();
+        CHECK( cache.size() == 0 );
+        CHECK( cache.find( "t_dirt", test_category::terrain, tileset ).tileset == 2 );
+        CHECK( cache.find( t_floor, test_category::terrain, tileset ).tileset == 2 );
+    }
+
+    SECTION( "the same season keeps the lookups" ) {
+        cache.set_season( SUMMER );
+        CHECK( cache.size() == 2 );
+        CHECK( cache.find( t_floor, test_category::terrain, tileset ).tileset == 1 );
+        CHECK( tileset.lookups == 2 );
+    }
+
+    SECTION( "another season forgets them" ) {
+        tileset.generation = 2;
+        cache.set_season( AUTUMN );
+        CHECK( cache.size() == 0 );
+        CHECK( cache.find( "t_dirt", test_category::terrain, tileset ).tileset == 2 );
+        CHECK( cache.find( t_floor, test_category::terrain, tileset ).tileset == 2 );
+    }
+}
+
+TEST_CASE( "tile_lookup_cache_benchmark", "[.]" )
+{
+    // What cata_tiles does for every drawn tile without the cache: the seasonal and the
+    // plain id, then the subtiles of multitiles.
+    static const std::array<std::string, 8> multitile_keys = {{
+            "center", "corner", "edge", "t_connection", "end_piece", "unconnected", "open", "broken"
+        }
+    };
+    std::unordered_map<std::string, int> tile_ids;
+    std::vector<ter_id> terrains;
+    for( size_t i = 0; i < ter_t::count(); i++ ) {
+        const ter_id ter( static_cast<int>( i ) );
+        const std::string &id = ter.id().str();
+        terrains.push_back( ter );
+        tile_ids.emplace( id, 0 );
+        if( i % 3 == 0 ) {
+            tile_ids.emplace( id + "_season_summer", 0 );
+            for( const std::string &key : multitile_keys ) {
+                tile_ids.emplace( id + "_" + key, 0 );
+            }
+        }
+    }
+    int found_tiles = 0;
+    const auto look_up = [&]( const std::string & id ) {
+        test_lookup result{ id, 0 };
+        const auto seasonal = tile_ids.find( id + "_season_summer" );
+        const auto plain = tile_ids.find( id );
+        if( seasonal != tile_ids.end() || plain != tile_ids.end() ) {
+            found_tiles++;
+        }
+        if( seasonal != tile_ids.end() ) {
+            for( const std::string &key : multitile_keys ) {
+                found_tiles += tile_ids.count( id + "_" + key + "_season_summer" ) +
+                               tile_ids.count( id + "_" + key );
+            }
+        }
+        return result;
+    };
+
+    // The tile lookups of drawing a frame: one per tile of a large map view, the terrain
+    // changes from tile to tile. The drawing itself needs SDL and isn't part of this.
+    const size_t tiles_per_frame = 100 * 50;
+    const size_t frames = 200;
+    const auto time = [&]( const char *what, const std::function<void( size_t )> &lookup ) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for( size_t frame = 0; frame < frames; frame++ ) {
+            for( size_t tile = 0; tile < tiles_per_frame; tile++ ) {
+                lookup( ( frame + tile ) % terrains.size() );
+            }
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        const long long diff = std::chrono::duration_cast<std::chrono::microseconds>
+                               ( end - start ).count();
+        WARN( "The tile lookups of a frame " << what << " took " << diff / frames <<
+              " microseconds." );
+    };
+    test_cache cache;
+    time( "without the cache", [&]( const size_t i ) {
+        look_up( terrains[i].id().str() );
+    } );
+    time( "by string id", [&]( const size_t i ) {
+        cache.set_season( SUMMER );
+        cache.find( terrains[i].id().str(), test_category::terrain, look_up );
+    } );
+    time( "by int id", [&]( const size_t i ) {
+        cache.set_season( SUMMER );
+        cache.find( terrains[i], test_category::terrain, look_up );
+    } );
+    CHECK( found_tiles > 0 );
+}
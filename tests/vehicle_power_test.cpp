@@ -7,6 +7,7 @@
 #include "calendar.h"
 #include "catch/catch.hpp"
 #include "game.h"
+#include "item.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "point.h"
@@ -179,3 +180,43 @@ TEST_CASE( "maximum reverse velocity", "[vehicle][power][reverse]" )
     }
 }
 
+static void connect_by_cable( vehicle &source, vehicle &target )
+{
+    vehicle_part source_part( vpart_id( "jumper_cable" ), point_zero, item( "jumper_cable" ) );
+    source_part.target.first = g->m.getabs( target.global_pos3() );
+    source_part.target.second = g->m.getabs( target.global_pos3() );
+    source.install_part( point_zero, source_part );
+}
+
+TEST_CASE( "power_grid_follows_cable_changes", "[vehicle][power]" )
+{
+    reset_player();
+    build_test_map( ter_id( "t_pavement" ) );
+    clear_vehicles();
+
+    vehicle *first = g->m.add_vehicle( vproto_id( "reactor_test" ), tripoint( 10, 10, 0 ), 0, 0, 0 );
+    vehicle *second = g->m.add_vehicle( vproto_id( "reactor_test" ), tripoint( 20, 10, 0 ), 0, 0, 0 );
+    REQUIRE( first != nullptr );
+    REQUIRE( second != nullptr );
+    first->discharge_battery( first->fuel_left( fuel_type_battery ), false );
+    second->discharge_battery( second->fuel_left( fuel_type_battery ), false );
+    first->charge_battery( 100, false );
+    second->charge_battery( 200, false );
+    REQUIRE( first->fuel_left( fuel_type_battery, true ) == 100 );
+    REQUIRE( second->fuel_left( fuel_type_battery, true ) == 200 );
+
+    connect_by_cable( *first, *second );
+    connect_by_cable( *second, *first );
+    CHECK( first->fuel_left( fuel_type_battery, true ) == 300 );
+    CHECK( second->fuel_left( fuel_type_battery, true ) == 300 );
+
+    // Only the cable of the first vehicle is gone, the second one still reaches it.
+    REQUIRE( !first->power_cables.empty() );
+    first->remove_part( first->power_cables.front() );
+    first->part_removal_cleanup();
+    CHECK( first->fuel_left( fuel_type_battery, true ) == 100 );
+    CHECK( second->fuel_left( fuel_type_battery, true ) == 300 );
+
+    g->m.destroy_vehicle( first );
+    CHECK( second->fuel_left( fuel_type_battery, true ) == 200 );
+}
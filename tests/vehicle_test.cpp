@@ -13,6 +13,8 @@
 #include "point.h"
 #include "type_id.h"
 #include "vehicle.h"
+#include "vpart_position.h"
+#include "vpart_range.h"
 
 TEST_CASE( "detaching_vehicle_unboards_passengers" )
 {
@@ -72,3 +74,45 @@ TEST_CASE( "add_item_to_broken_vehicle_part" )
     const item itm2 = item( "jeans" );
     REQUIRE( !veh_ptr->add_item( *cargo_part, itm2 ) );
 }
+
+static void check_vehicle_part_cache( vehicle &veh )
+{
+    for( const vpart_reference &vp : veh.get_all_parts() ) {
+        const tripoint pos = vp.pos();
+        CAPTURE( pos );
+        const optional_vpart_position cached = g->m.veh_at( pos );
+        REQUIRE( cached );
+        CHECK( &cached->vehicle() == &veh );
+    }
+}
+
+TEST_CASE( "vehicle_part_cache_follows_moved_vehicles" )
+{
+    clear_map();
+    const tripoint first_origin( 60, 60, 0 );
+    const tripoint second_origin( 70, 60, 0 );
+    vehicle *first = g->m.add_vehicle( vproto_id( "bicycle" ), first_origin, 0, 0, 0 );
+    vehicle *second = g->m.add_vehicle( vproto_id( "bicycle" ), second_origin, 0, 0, 0 );
+    REQUIRE( first != nullptr );
+    REQUIRE( second != nullptr );
+    check_vehicle_part_cache( *first );
+    check_vehicle_part_cache( *second );
+
+    std::vector<tripoint> old_positions;
+    for( const vpart_reference &vp : first->get_all_parts() ) {
+        old_positions.push_back( vp.pos() );
+    }
+    const tripoint offset( 0, 4, 0 );
+    REQUIRE( g->m.displace_vehicle( *first, offset ) );
+    check_vehicle_part_cache( *first );
+    check_vehicle_part_cache( *second );
+    for( const tripoint &pos : old_positions ) {
+        CAPTURE( pos );
+        const optional_vpart_position cached = g->m.veh_at( pos );
+        CHECK( ( !cached || &cached->vehicle() == first ) );
+    }
+
+    g->m.reset_vehicle_cache( 0 );
+    check_vehicle_part_cache( *first );
+    check_vehicle_part_cache( *second );
+}
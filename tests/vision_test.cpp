@@ -19,8 +19,10 @@
 #include "lightmap.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "options_helpers.h"
 #include "point.h"
 #include "shadowcasting.h"
+#include "thread_pool.h"
 #include "type_id.h"
 
 enum class vision_test_flags {
@@ -535,3 +537,123 @@ TEST_CASE( "vision_see_wall_in_moonlight", "[shadowcasting][vision]" )
 
     t.test_all();
 }
+
+struct shadowcasting_result {
+    std::vector<float> seen;
+    std::vector<float> lm;
+    std::vector<float> sm;
+};
+
+static shadowcasting_result cast_with( const std::string &option, const bool enabled )
+{
+    override_option opt( option, enabled ? "true" : "false" );
+    const int zlev = g->u.posz();
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        g->m.invalidate_map_cache( z );
+    }
+    g->m.build_map_cache( zlev );
+
+    const level_cache &cache = g->m.access_cache( zlev );
+    shadowcasting_result result;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            result.seen.push_back( cache.seen_cache[x][y] );
+            result.sm.push_back( cache.sm[x][y] );
+            const std::array<float, 4> &quadrants = cache.lm[x][y].values;
+            result.lm.insert( result.lm.end(), quadrants.begin(), quadrants.end() );
+        }
+    }
+    return result;
+}
+
+TEST_CASE( "parallel_shadowcasting_matches_serial", "[shadowcasting][vision]" )
+{
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_utility_light( "t_utility_light" );
+
+    g->place_player( tripoint( 60, 60, 0 ) );
+    g->u.worn.clear();
+    clear_map();
+    g->reset_light_level();
+    calendar::turn = calendar::turn_zero;
+
+    // A fixed scattering of walls and lamps, so there is something to cast shadows.
+    const tripoint center = g->u.pos();
+    for( int dx = -40; dx <= 40; dx++ ) {
+        for( int dy = -40; dy <= 40; dy++ ) {
+            const int hash = ( dx + 40 ) * 7 + ( dy + 40 ) * 13;
+            if( dx == 0 && dy == 0 ) {
+                continue;
+            } else if( hash % 37 == 0 ) {
+                g->m.ter_set( center + point( dx, dy ), t_utility_light );
+            } else if( hash % 11 == 0 ) {
+                g->m.ter_set( center + point( dx, dy ), t_brick_wall );
+            }
+        }
+    }
+
+    // The game's pool has no workers on a single core, so the test brings its own.
+    thread_pool pool( 3 );
+    override_thread_pool use_pool( pool );
+
+    const bool old_fov_3d = fov_3d;
+    for( const bool use_3d : {
+             false, true
+         } ) {
+        INFO( ( use_3d ? "using 3d casting" : "using 2d casting" ) );
+        fov_3d = use_3d;
+        const shadowcasting_result serial = cast_with( "PARALLEL_SHADOWCASTING", false );
+        const shadowcasting_result parallel = cast_with( "PARALLEL_SHADOWCASTING", true );
+        CHECK( serial.seen == parallel.seen );
+        CHECK( serial.lm == parallel.lm );
+        CHECK( serial.sm == parallel.sm );
+    }
+    fov_3d = old_fov_3d;
+}
+
+TEST_CASE( "incremental_lightmap_matches_full_rebuild", "[shadowcasting][vision]" )
+{
+    const ter_id t_brick_wall( "t_brick_wall" );
+    const ter_id t_floor( "t_floor" );
+    const ter_id t_utility_light( "t_utility_light" );
+
+    g->place_player( tripoint( 60, 60, 0 ) );
+    g->u.worn.clear();
+    clear_map();
+    g->reset_light_level();
+    calendar::turn = midnight;
+
+    const tripoint center = g->u.pos();
+    const tripoint lamp_a = center + point( -5, -3 );
+    const tripoint lamp_b = center + point( 8, 2 );
+    g->m.ter_set( lamp_a, t_utility_light );
+    g->m.ter_set( lamp_b, t_utility_light );
+
+    const auto check_same = []() {
+        const shadowcasting_result incremental = cast_with( "INCREMENTAL_LIGHTMAP", true );
+        const shadowcasting_result full = cast_with( "INCREMENTAL_LIGHTMAP", false );
+        CHECK( incremental.lm == full.lm );
+        CHECK( incremental.sm == full.sm );
+    };
+
+    check_same();
+    SECTION( "nothing changed" ) {
+        check_same();
+    }
+    SECTION( "wall built next to a light" ) {
+        g->m.ter_set( lamp_a + point_east, t_brick_wall );
+        g->m.ter_set( lamp_a + point_south_east, t_brick_wall );
+        check_same();
+    }
+    SECTION( "light moved" ) {
+        g->m.ter_set( lamp_b, t_floor );
+        g->m.ter_set( lamp_b + point( 4, 4 ), t_utility_light );
+        check_same();
+    }
+    SECTION( "light placed next to another" ) {
+        g->m.ter_set( lamp_a + point_north, t_utility_light );
+        check_same();
+        g->m.ter_set( lamp_a, t_floor );
+        check_same();
+    }
+}